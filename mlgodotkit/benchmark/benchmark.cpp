@@ -0,0 +1,436 @@
+// Native benchmarks for the engine-independent core (scons benchmark).
+//
+//   mlgodotkit_benchmark [--filter <substring>] [--min-time <seconds>]
+//                        [--threads <n>] [--out <file.json | ->]
+//
+// Every case is timed until it has run for at least --min-time seconds.
+// Results are printed as a table; --out also writes them as JSON ("-" for
+// stdout) so CI can archive and compare runs. Comparisons between paths that
+// are meant to be faster (int8 vs fp32 inference) are checked as well: the
+// exit status is 3 when one falls below its floor. Godot Array <-> Eigen
+// marshalling needs a running engine and is measured in-game through the
+// Profiler instead.
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "linalg/linalg_core.h"
+#include "models/decision_tree/decision_tree.h"
+#include "models/neural_network/layer/half_layer.h"
+#include "models/neural_network/layer/layer.h"
+#include "models/neural_network/layer/quantized_layer.h"
+#include "utility/half_precision.h"
+#include "utility/logger.h"
+#include "utility/npy.h"
+#include "utility/thread_pool.h"
+
+namespace {
+
+struct Options {
+    std::string filter;
+    double min_time = 0.5;
+    int threads = 0;
+    std::string out;
+};
+
+struct Result {
+    std::string name;
+    std::string params;     // JSON object body, e.g. "\"n\": 64"
+    int64_t iterations = 0;
+    double seconds = 0.0;
+    double flops = 0.0;     // per iteration
+    double bytes = 0.0;     // per iteration
+
+    double ns_per_iter() const { return seconds * 1e9 / double(iterations); }
+    double gflops() const { return flops * double(iterations) / seconds * 1e-9; }
+    double gbytes() const { return bytes * double(iterations) / seconds * 1e-9; }
+};
+
+// Speed of a candidate path relative to its baseline on the same case
+struct Comparison {
+    std::string name;
+    std::string params;
+    double baseline_ns = 0.0;
+    double candidate_ns = 0.0;
+    double min_speedup = 1.0;
+
+    double speedup() const { return baseline_ns / candidate_ns; }
+    bool regressed() const { return speedup() < min_speedup; }
+};
+
+class Suite {
+public:
+    // The table goes to stderr when the JSON is written to stdout
+    explicit Suite(const Options &p_options) : options(p_options), table(p_options.out == "-" ? stderr : stdout) {}
+
+    bool wants(const std::string &name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    // Runs fn until min_time has elapsed (doubling the batch of calls each
+    // round so the clock is read rarely) and records the average. Returns
+    // the time per call in ns, or 0 when the case is filtered out.
+    double run(const std::string &name, const std::string &params, double flops, double bytes,
+             const std::function<void()> &fn) {
+        if (!wants(name))
+            return 0.0;
+        using clock = std::chrono::steady_clock;
+        fn();   // warm-up: first-touch allocations, lazy buffers
+
+        int64_t total = 0;
+        int64_t batch = 1;
+        double elapsed = 0.0;
+        while (elapsed < options.min_time) {
+            const auto start = clock::now();
+            for (int64_t i = 0; i < batch; ++i)
+                fn();
+            elapsed += std::chrono::duration<double>(clock::now() - start).count();
+            total += batch;
+            batch = std::min<int64_t>(batch * 2, int64_t(1) << 20);
+        }
+
+        Result r;
+        r.name = name;
+        r.params = params;
+        r.iterations = total;
+        r.seconds = elapsed;
+        r.flops = flops;
+        r.bytes = bytes;
+        std::fprintf(table, "%-28s %-34s %12.0f ns %9.2f GFLOP/s %8.2f GB/s\n", r.name.c_str(), r.params.c_str(),
+                    r.ns_per_iter(), r.gflops(), r.gbytes());
+        std::fflush(table);
+        results.push_back(r);
+        return r.ns_per_iter();
+    }
+
+    // Skipped when either side was filtered out
+    void compare(const std::string &name, const std::string &params, double baseline_ns, double candidate_ns,
+                 double min_speedup) {
+        if (baseline_ns <= 0.0 || candidate_ns <= 0.0)
+            return;
+        Comparison c;
+        c.name = name;
+        c.params = params;
+        c.baseline_ns = baseline_ns;
+        c.candidate_ns = candidate_ns;
+        c.min_speedup = min_speedup;
+        std::fprintf(table, "%-28s %-34s %11.2fx speedup (min %.2fx)%s\n", c.name.c_str(), c.params.c_str(),
+                     c.speedup(), c.min_speedup, c.regressed() ? "  REGRESSION" : "");
+        std::fflush(table);
+        comparisons.push_back(c);
+    }
+
+    bool regressed() const {
+        for (const Comparison &c : comparisons)
+            if (c.regressed())
+                return true;
+        return false;
+    }
+
+    std::string to_json() const {
+        std::ostringstream s;
+        s << "{\n  \"suite\": \"mlgodotkit\",\n";
+        s << "  \"threads\": " << ThreadPool::get_thread_count() << ",\n";
+        s << "  \"min_time\": " << options.min_time << ",\n";
+        s << "  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            s << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"params\": {" << r.params
+              << "}, \"iterations\": " << r.iterations << ", \"ns_per_iter\": " << r.ns_per_iter()
+              << ", \"gflops\": " << r.gflops() << ", \"gbytes_per_s\": " << r.gbytes() << "}";
+        }
+        s << "\n  ],\n  \"comparisons\": [";
+        for (size_t i = 0; i < comparisons.size(); ++i) {
+            const Comparison &c = comparisons[i];
+            s << (i ? ",\n" : "\n") << "    {\"name\": \"" << c.name << "\", \"params\": {" << c.params
+              << "}, \"speedup\": " << c.speedup() << ", \"min_speedup\": " << c.min_speedup
+              << ", \"regressed\": " << (c.regressed() ? "true" : "false") << "}";
+        }
+        s << "\n  ]\n}\n";
+        return s.str();
+    }
+
+private:
+    Options options;
+    FILE *table;
+    std::vector<Result> results;
+    std::vector<Comparison> comparisons;
+};
+
+// Keeps results alive so the optimizer cannot drop the measured work
+volatile float sink = 0.0f;
+
+template <typename Mat>
+void consume(const Mat &m) {
+    if (m.size() > 0)
+        sink = sink + m.data()[0];
+}
+
+std::mt19937 &rng() {
+    static std::mt19937 engine(1234);
+    return engine;
+}
+
+Eigen::MatrixXf random_matrix(int rows, int cols) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    Eigen::MatrixXf m(rows, cols);
+    for (int64_t i = 0; i < m.size(); ++i)
+        m.data()[i] = dist(rng());
+    return m;
+}
+
+std::string dims(const char *a, int x, const char *b, int y, const char *c = nullptr, int z = 0) {
+    std::ostringstream s;
+    s << "\"" << a << "\": " << x << ", \"" << b << "\": " << y;
+    if (c)
+        s << ", \"" << c << "\": " << z;
+    return s.str();
+}
+
+// --- Dense layers ---
+
+void bench_dense(Suite &suite) {
+    struct Shape { int rows, in, out; };
+    for (const Shape &sh : {Shape{32, 64, 64}, Shape{64, 256, 256}, Shape{256, 512, 512}, Shape{64, 1024, 1024}}) {
+        const std::string params = dims("rows", sh.rows, "in", sh.in, "out", sh.out);
+        const double mnk = double(sh.rows) * sh.in * sh.out;
+        const double io = sizeof(float) * (double(sh.rows) * sh.in + double(sh.in) * sh.out + double(sh.rows) * sh.out);
+
+        Layer layer(sh.in, sh.out, 0.001f, "relu");
+        const Eigen::MatrixXf X = random_matrix(sh.rows, sh.in);
+        const Eigen::MatrixXf grad = random_matrix(sh.rows, sh.out) * 0.01f;
+
+        suite.run("dense/forward", params, 2.0 * mnk, io, [&] { consume(layer.forward(X)); });
+        layer.forward(X);
+        suite.run("dense/backward", params, 4.0 * mnk, 2.0 * io, [&] { consume(layer.backward_compute(grad)); });
+        suite.run("dense/update", params, 6.0 * sh.in * sh.out,
+                  4.0 * sizeof(float) * sh.in * sh.out, [&] { layer.apply_update(); });
+    }
+}
+
+// --- Inference stacks: fp32, int8 and 16-bit weights ---
+
+void bench_inference(Suite &suite) {
+    for (int width : {64, 256, 1024}) {
+        const int rows = 64;
+        std::vector<Layer> layers;
+        for (int i = 0; i < 3; ++i)
+            layers.emplace_back(width, width, 0.001f, i < 2 ? "relu" : "linear");
+        const Eigen::MatrixXf X = random_matrix(rows, width);
+        const std::string params = dims("rows", rows, "width", width, "layers", 3);
+        const double flops = 3 * 2.0 * double(rows) * width * width;
+        InferenceScratch scratch;
+
+        const double fp32_ns = suite.run("infer/fp32", params, flops, 3.0 * sizeof(float) * width * width,
+                                         [&] { consume(Layer::infer_stack(layers, X, scratch)); });
+
+        std::vector<QuantizedLayer> quantized;
+        for (const Layer &l : layers)
+            quantized.push_back(QuantizedLayer::from_layer(l, 0.0f));
+        const double int8_ns = suite.run("infer/int8", params, flops, 3.0 * width * width,
+                                         [&] { consume(QuantizedLayer::infer_stack(quantized, X, scratch)); });
+        // int8 exists to be faster than fp32; allow some timing noise
+        suite.compare("compare/int8_vs_fp32", params, fp32_ns, int8_ns, 0.9);
+
+        for (HalfPrecision::Format format : {HalfPrecision::FLOAT16, HalfPrecision::BFLOAT16}) {
+            std::vector<HalfLayer> half;
+            for (const Layer &l : layers)
+                half.push_back(HalfLayer::from_layer(l, format));
+            suite.run(format == HalfPrecision::FLOAT16 ? "infer/fp16" : "infer/bf16", params, flops,
+                      3.0 * 2 * width * width, [&] { consume(HalfLayer::infer_stack(half, X, scratch)); });
+        }
+    }
+}
+
+// --- Decision tree ---
+
+void bench_tree(Suite &suite) {
+    for (int samples : {256, 1024}) {
+        const int features = 8;
+        Eigen::MatrixXf X = random_matrix(samples, features);
+        Eigen::VectorXf y(samples);
+        for (int i = 0; i < samples; ++i)
+            y(i) = (X(i, 0) + 0.5f * X(i, 1) > 0.0f) ? 1.0f : 0.0f;
+        const std::string params = dims("samples", samples, "features", features);
+
+        DecisionTree tree;
+        tree.set_max_depth(8);
+        suite.run("tree/fit", params, 0.0, sizeof(float) * double(samples) * (features + 1),
+                  [&] { tree.fit(X, y); });
+        suite.run("tree/predict", params, 0.0, sizeof(float) * double(samples) * features, [&] {
+            int total = 0;
+            for (int i = 0; i < samples; ++i)
+                total += tree.predict(X.row(i).transpose());
+            sink = sink + float(total);
+        });
+    }
+}
+
+// --- Linalg decompositions and batched solves ---
+
+void bench_linalg(Suite &suite) {
+    using LinalgCore::RowMat;
+    using LinalgCore::RowVec;
+    for (int n : {8, 32, 128, 512}) {
+        const RowMat A = random_matrix(n, n);
+        const RowMat S = A * A.transpose() + RowMat::Identity(n, n) * float(n);
+        const std::string params = dims("rows", n, "cols", n);
+        const double n3 = double(n) * n * n;
+        const double bytes = sizeof(float) * double(n) * n;
+
+        suite.run("linalg/svd", params, 0.0, bytes, [&] {
+            RowMat U, V;
+            RowVec s;
+            LinalgCore::svd(A, true, &U, s, &V);
+            consume(s);
+        });
+        suite.run("linalg/qr", params, 4.0 / 3.0 * n3, bytes, [&] {
+            RowMat Q, R;
+            LinalgCore::qr(A, true, &Q, R);
+            consume(R);
+        });
+        suite.run("linalg/lu", params, 2.0 / 3.0 * n3, bytes, [&] {
+            RowMat L, U, P;
+            LinalgCore::lu(A, L, U, P);
+            consume(U);
+        });
+        suite.run("linalg/eig", params, 0.0, bytes, [&] {
+            RowVec values;
+            RowMat vectors;
+            LinalgCore::eig(S, true, values, &vectors);
+            consume(values);
+        });
+    }
+
+    for (int n : {2, 4, 8, 16}) {
+        const int count = 4096;
+        const Eigen::MatrixXf A = random_matrix(n * n, count);
+        std::vector<float> As(A.data(), A.data() + A.size());
+        // Diagonally dominant so every system is well conditioned
+        for (int s = 0; s < count; ++s)
+            for (int i = 0; i < n; ++i)
+                As[size_t(s) * n * n + i * n + i] += float(n);
+        const Eigen::MatrixXf b = random_matrix(count, n);
+        std::vector<float> x(size_t(count) * n);
+        const std::string params = dims("count", count, "n", n);
+        suite.run("linalg/solve_batched", params, count * (2.0 / 3.0 * n * n * n + 2.0 * n * n),
+                  sizeof(float) * double(count) * (n * n + 2 * n),
+                  [&] { LinalgCore::solve_batched(As.data(), b.data(), x.data(), count, n, 1); sink = sink + x[0]; });
+    }
+}
+
+// --- Conversions: 16-bit weights, layouts, .npy parsing ---
+
+std::vector<uint8_t> make_npy(int rows, int cols) {
+    std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': (" + std::to_string(rows) + ", " +
+                         std::to_string(cols) + "), }";
+    // Magic, version 1.0, header length, then the header padded to 64 bytes
+    const size_t prefix = 10;
+    while ((prefix + header.size() + 1) % 64 != 0)
+        header += ' ';
+    header += '\n';
+
+    std::vector<uint8_t> out(prefix + header.size() + sizeof(float) * size_t(rows) * cols);
+    const uint8_t magic[8] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    std::memcpy(out.data(), magic, 8);
+    out[8] = uint8_t(header.size() & 0xff);
+    out[9] = uint8_t(header.size() >> 8);
+    std::memcpy(out.data() + prefix, header.data(), header.size());
+    const Eigen::MatrixXf values = random_matrix(rows, cols);
+    std::memcpy(out.data() + prefix + header.size(), values.data(), sizeof(float) * size_t(values.size()));
+    return out;
+}
+
+void bench_conversions(Suite &suite) {
+    const int n = 1 << 20;
+    const Eigen::MatrixXf values = random_matrix(n, 1);
+    std::vector<uint8_t> packed(size_t(n) * 2);
+    std::vector<float> unpacked(n);
+    const std::string count = "\"count\": " + std::to_string(n);
+
+    for (HalfPrecision::Format format : {HalfPrecision::FLOAT16, HalfPrecision::BFLOAT16}) {
+        const std::string tag = format == HalfPrecision::FLOAT16 ? "fp16" : "bf16";
+        suite.run("convert/" + tag + "_encode", count, 0.0, 6.0 * n,
+                  [&] { HalfPrecision::encode(values.data(), n, format, packed.data()); sink = sink + packed[0]; });
+        suite.run("convert/" + tag + "_decode", count, 0.0, 6.0 * n,
+                  [&] { HalfPrecision::decode(packed.data(), n, format, unpacked.data()); sink = sink + unpacked[0]; });
+    }
+
+    for (int size : {64, 512, 2048}) {
+        const Eigen::MatrixXf col = random_matrix(size, size);
+        LinalgCore::RowMat row(size, size);
+        const std::string params = dims("rows", size, "cols", size);
+        suite.run("convert/col_to_row_major", params, 0.0, 2.0 * sizeof(float) * size * size,
+                  [&] { row = col; consume(row); });
+
+        const std::vector<uint8_t> npy = make_npy(size, size);
+        std::vector<float> dst(size_t(size) * size);
+        suite.run("convert/npy_parse_copy", params, 0.0, 2.0 * sizeof(float) * size * size, [&] {
+            Npy::ArrayView view;
+            if (!Npy::parse_npy(npy.data(), npy.size(), view).empty())
+                std::abort();
+            Npy::copy_col_major(view, size, size, dst.data());
+            sink = sink + dst[0];
+        });
+    }
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)
+            options.filter = argv[++i];
+        else if (arg == "--min-time" && has_value)
+            options.min_time = std::atof(argv[++i]);
+        else if (arg == "--threads" && has_value)
+            options.threads = std::atoi(argv[++i]);
+        else if (arg == "--out" && has_value)
+            options.out = argv[++i];
+        else
+            return false;
+    }
+    return options.min_time > 0.0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <seconds>] [--threads <n>] "
+                             "[--out <file.json | ->]\n", argv[0]);
+        return 2;
+    }
+    ThreadPool::set_thread_count(options.threads);
+    Logger::set_verbosity(0);
+
+    Suite suite(options);
+    bench_dense(suite);
+    bench_inference(suite);
+    bench_tree(suite);
+    bench_linalg(suite);
+    bench_conversions(suite);
+
+    if (options.out == "-") {
+        std::fputs(suite.to_json().c_str(), stdout);
+    } else if (!options.out.empty()) {
+        std::ofstream file(options.out);
+        file << suite.to_json();
+        if (!file) {
+            std::fprintf(stderr, "could not write %s\n", options.out.c_str());
+            return 1;
+        }
+    }
+    return suite.regressed() ? 3 : 0;
+}
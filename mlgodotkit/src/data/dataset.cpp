@@ -0,0 +1,428 @@
+#include "dataset.h"
+#include "data/experience_log.h"
+#include "utility/logger.h"
+#include <godot_cpp/classes/file_access.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Randomizes a stream of rows with bounded memory. Once the buffer holds
+// `capacity` rows, each incoming row replaces a uniformly chosen buffered row,
+// which is emitted instead; drain() emits the rest in random order.
+class RowShuffler {
+public:
+    RowShuffler(int p_stride, int p_capacity, uint64_t seed)
+        : stride(p_stride), capacity(p_capacity), rng(seed) {
+        if (capacity > 1)
+            rows.resize(size_t(capacity) * stride);
+    }
+
+    template <typename Emit>
+    void add(const float *row, Emit &&emit) {
+        if (capacity <= 1) {
+            emit(row);
+            return;
+        }
+        if (count < capacity) {
+            std::copy(row, row + stride, rows.data() + size_t(count++) * stride);
+            return;
+        }
+        float *slot = rows.data() + size_t(rng() % uint64_t(capacity)) * stride;
+        emit(slot);
+        std::copy(row, row + stride, slot);
+    }
+
+    template <typename Emit>
+    void drain(Emit &&emit) {
+        for (int n = count; n > 0; --n) {
+            float *last = rows.data() + size_t(n - 1) * stride;
+            float *pick = rows.data() + size_t(rng() % uint64_t(n)) * stride;
+            std::swap_ranges(pick, pick + stride, last);
+            emit(last);
+        }
+        count = 0;
+    }
+
+private:
+    int stride;
+    int capacity;
+    int count = 0;
+    std::vector<float> rows;
+    std::mt19937_64 rng;
+};
+
+// Parses one line of numbers; false unless it has exactly `expected` columns
+bool parse_csv_row(const std::string &line, char delimiter, float *out, int expected) {
+    const char *p = line.c_str();
+    int n = 0;
+    while (true) {
+        char *end = nullptr;
+        const float value = std::strtof(p, &end);
+        if (end == p || n == expected)
+            return false;
+        out[n++] = value;
+        while (*end == ' ' || *end == '\t')
+            ++end;
+        if (*end == '\0')
+            return n == expected;
+        if (*end != delimiter)
+            return false;
+        p = end + 1;
+    }
+}
+
+bool is_blank(const std::string &line) {
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+} // namespace
+
+void Dataset::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_method(D_METHOD("open_binary", "path", "n_features", "n_targets"), &Dataset::open_binary, DEFVAL(1));
+    ClassDB::bind_method(D_METHOD("open_csv", "path", "n_targets", "skip_header", "delimiter"), &Dataset::open_csv,
+                         DEFVAL(1), DEFVAL(true), DEFVAL(","));
+    ClassDB::bind_method(D_METHOD("open_log", "path", "n_targets"), &Dataset::open_log, DEFVAL(1));
+    ClassDB::bind_method(D_METHOD("close"), &Dataset::close);
+    ClassDB::bind_method(D_METHOD("next_batch"), &Dataset::next_batch);
+    ClassDB::bind_method(D_METHOD("reset"), &Dataset::reset);
+    ClassDB::bind_method(D_METHOD("get_feature_count"), &Dataset::get_feature_count);
+    ClassDB::bind_method(D_METHOD("get_target_count"), &Dataset::get_target_count);
+    ClassDB::bind_method(D_METHOD("get_epoch"), &Dataset::get_epoch);
+    ClassDB::bind_method(D_METHOD("get_rows_read"), &Dataset::get_rows_read);
+
+    ClassDB::bind_method(D_METHOD("set_batch_size", "size"), &Dataset::set_batch_size);
+    ClassDB::bind_method(D_METHOD("get_batch_size"), &Dataset::get_batch_size);
+    ClassDB::bind_method(D_METHOD("set_shuffle_buffer", "rows"), &Dataset::set_shuffle_buffer);
+    ClassDB::bind_method(D_METHOD("get_shuffle_buffer"), &Dataset::get_shuffle_buffer);
+    ClassDB::bind_method(D_METHOD("set_prefetch_batches", "count"), &Dataset::set_prefetch_batches);
+    ClassDB::bind_method(D_METHOD("get_prefetch_batches"), &Dataset::get_prefetch_batches);
+    ClassDB::bind_method(D_METHOD("set_drop_last", "enabled"), &Dataset::set_drop_last);
+    ClassDB::bind_method(D_METHOD("get_drop_last"), &Dataset::get_drop_last);
+    ClassDB::bind_method(D_METHOD("set_seed", "seed"), &Dataset::set_seed);
+    ClassDB::bind_method(D_METHOD("get_seed"), &Dataset::get_seed);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "batch_size", PROPERTY_HINT_RANGE, "1,65536,1,or_greater"),
+        "set_batch_size", "get_batch_size");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "shuffle_buffer", PROPERTY_HINT_RANGE, "0,1048576,1,or_greater"),
+        "set_shuffle_buffer", "get_shuffle_buffer");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "prefetch_batches", PROPERTY_HINT_RANGE, "1,64,1"),
+        "set_prefetch_batches", "get_prefetch_batches");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "drop_last"), "set_drop_last", "get_drop_last");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+}
+
+Dataset::~Dataset() {
+    stop_reader();
+}
+
+godot::Error Dataset::open_binary(const godot::String &path, int n_features, int n_targets) {
+    ERR_FAIL_COND_V_MSG(n_features < 1 || n_targets < 0, godot::ERR_INVALID_PARAMETER,
+        "Dataset::open_binary - n_features must be positive and n_targets non-negative");
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(path, godot::FileAccess::READ);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "Dataset::open_binary - could not open " + path);
+
+    const uint64_t row_bytes = uint64_t(n_features + n_targets) * sizeof(float);
+    ERR_FAIL_COND_V_MSG(file->get_length() % row_bytes != 0, godot::ERR_FILE_CORRUPT,
+        "Dataset::open_binary - file size is not a whole number of rows");
+
+    close();
+    source.path = path;
+    source.format = FORMAT_BINARY;
+    source.n_features = n_features;
+    source.n_targets = n_targets;
+    return godot::OK;
+}
+
+godot::Error Dataset::open_csv(const godot::String &path, int n_targets, bool skip_header, const godot::String &delimiter) {
+    ERR_FAIL_COND_V_MSG(n_targets < 0, godot::ERR_INVALID_PARAMETER, "Dataset::open_csv - n_targets must be non-negative");
+    ERR_FAIL_COND_V_MSG(delimiter.length() != 1, godot::ERR_INVALID_PARAMETER, "Dataset::open_csv - delimiter must be one character");
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(path, godot::FileAccess::READ);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "Dataset::open_csv - could not open " + path);
+
+    // The first data row fixes the column count
+    const char delim = static_cast<char>(delimiter[0]);
+    bool header_pending = skip_header;
+    int columns = 0;
+    while (!file->eof_reached()) {
+        const std::string line = file->get_line().utf8().get_data();
+        if (is_blank(line))
+            continue;
+        if (header_pending) {
+            header_pending = false;
+            continue;
+        }
+        columns = 1 + static_cast<int>(std::count(line.begin(), line.end(), delim));
+        break;
+    }
+    ERR_FAIL_COND_V_MSG(columns == 0, godot::ERR_FILE_EOF, "Dataset::open_csv - no data rows in " + path);
+    ERR_FAIL_COND_V_MSG(columns <= n_targets, godot::ERR_INVALID_DATA,
+        "Dataset::open_csv - fewer columns than n_targets + 1 in " + path);
+
+    close();
+    source.path = path;
+    source.format = FORMAT_CSV;
+    source.n_features = columns - n_targets;
+    source.n_targets = n_targets;
+    source.skip_header = skip_header;
+    source.delimiter = delim;
+    return godot::OK;
+}
+
+godot::Error Dataset::open_log(const godot::String &path, int n_targets) {
+    ERR_FAIL_COND_V_MSG(n_targets < 0, godot::ERR_INVALID_PARAMETER, "Dataset::open_log - n_targets must be non-negative");
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(path, godot::FileAccess::READ);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "Dataset::open_log - could not open " + path);
+
+    ExperienceLog::Info info;
+    const std::string problem = ExperienceLog::read_header(*file.ptr(), info);
+    ERR_FAIL_COND_V_MSG(!problem.empty(), godot::ERR_FILE_CORRUPT, godot::String("Dataset::open_log - ") + problem.c_str());
+    ERR_FAIL_COND_V_MSG(info.record_size > uint32_t(std::numeric_limits<int>::max()), godot::ERR_FILE_CORRUPT,
+        "Dataset::open_log - record size out of range in " + path);
+    ERR_FAIL_COND_V_MSG(int64_t(info.record_size) <= n_targets, godot::ERR_INVALID_DATA,
+        "Dataset::open_log - records are not wider than n_targets in " + path);
+
+    close();
+    source.path = path;
+    source.format = FORMAT_LOG;
+    source.n_features = static_cast<int>(info.record_size) - n_targets;
+    source.n_targets = n_targets;
+    return godot::OK;
+}
+
+void Dataset::close() {
+    stop_reader();
+    epoch_running = false;
+    epoch = 0;
+    source = Source();
+    std::lock_guard<std::mutex> lock(mutex);
+    rows_read = 0;
+}
+
+void Dataset::start_epoch() {
+    stop_reader();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        epoch_finished = false;
+        stop_requested = false;
+        reader_error.clear();
+    }
+    ++epoch;
+
+    EpochConfig config;
+    config.batch_size = batch_size;
+    config.shuffle_buffer = shuffle_buffer;
+    config.prefetch_batches = prefetch_batches;
+    config.drop_last = drop_last;
+    // A fresh but reproducible order every epoch
+    config.seed = uint64_t(uint32_t(seed)) * 0x9E3779B97F4A7C15ull + uint64_t(epoch);
+
+    reader = std::thread(&Dataset::read_epoch, this, source, config);
+    epoch_running = true;
+}
+
+void Dataset::stop_reader() {
+    if (reader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop_requested = true;
+        }
+        cv.notify_all();
+        reader.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.clear();
+}
+
+void Dataset::reset() {
+    stop_reader();
+    epoch_running = false;
+}
+
+bool Dataset::push_batch(Batch &&batch, int limit) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return stop_requested || (int)queue.size() < limit; });
+    if (stop_requested)
+        return false;
+    rows_read += uint64_t(batch.X.rows());
+    queue.push_back(std::move(batch));
+    lock.unlock();
+    cv.notify_all();
+    return true;
+}
+
+void Dataset::read_epoch(Source src, EpochConfig config) {
+    const int stride = src.n_features + src.n_targets;
+    RowShuffler shuffler(stride, config.shuffle_buffer, config.seed);
+
+    Batch batch;
+    int filled = 0;
+    bool running = true;
+    auto new_batch = [&] {
+        batch.X.resize(config.batch_size, src.n_features);
+        batch.Y.resize(config.batch_size, src.n_targets);
+        filled = 0;
+    };
+    // Batches are row-major, so each row is two contiguous copies
+    auto emit = [&](const float *row) {
+        if (!running)
+            return;
+        std::copy(row, row + src.n_features, batch.X.data() + size_t(filled) * src.n_features);
+        std::copy(row + src.n_features, row + stride, batch.Y.data() + size_t(filled) * src.n_targets);
+        if (++filled == config.batch_size) {
+            running = push_batch(std::move(batch), config.prefetch_batches);
+            new_batch();
+        }
+    };
+    new_batch();
+
+    std::string error;
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(src.path, godot::FileAccess::READ);
+    if (file.is_null()) {
+        error = std::string("could not open ") + src.path.utf8().get_data();
+    } else if (src.format == FORMAT_BINARY) {
+        const size_t row_bytes = size_t(stride) * sizeof(float);
+        std::vector<float> buffer(std::max<size_t>(1, CHUNK_BYTES / row_bytes) * stride);
+        while (running) {
+            const uint64_t got = file->get_buffer(reinterpret_cast<uint8_t *>(buffer.data()), buffer.size() * sizeof(float));
+            const size_t rows = size_t(got / row_bytes);
+            if (rows == 0)
+                break;
+            for (size_t i = 0; i < rows && running; ++i)
+                shuffler.add(buffer.data() + i * stride, emit);
+        }
+    } else if (src.format == FORMAT_LOG) {
+        // Each log chunk is decompressed whole, then fed row by row
+        ExperienceLog::Info info;
+        error = ExperienceLog::read_header(*file.ptr(), info);
+        std::vector<float> records;
+        while (running && error.empty()) {
+            records.clear();
+            if (!ExperienceLog::read_chunk(*file.ptr(), info, records, error))
+                break;
+            const size_t rows = records.size() / stride;
+            for (size_t i = 0; i < rows && running; ++i)
+                shuffler.add(records.data() + i * stride, emit);
+        }
+    } else {
+        std::vector<char> chunk(CHUNK_BYTES);
+        std::vector<float> row(stride);
+        std::string line;
+        bool header_pending = src.skip_header;
+        uint64_t line_number = 0;
+
+        auto process_line = [&] {
+            ++line_number;
+            if (is_blank(line))
+                return;
+            if (header_pending) {
+                header_pending = false;
+                return;
+            }
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (!parse_csv_row(line, src.delimiter, row.data(), stride)) {
+                error = "line " + std::to_string(line_number) + ": expected " + std::to_string(stride) + " numeric columns";
+                running = false;
+                return;
+            }
+            shuffler.add(row.data(), emit);
+        };
+
+        // Lines are cut out of fixed-size chunks; a partial line carries over
+        while (running) {
+            const uint64_t got = file->get_buffer(reinterpret_cast<uint8_t *>(chunk.data()), chunk.size());
+            if (got == 0)
+                break;
+            const char *p = chunk.data();
+            const char *end = p + got;
+            while (running && p < end) {
+                const char *newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+                if (!newline) {
+                    line.append(p, end);
+                    break;
+                }
+                line.append(p, newline);
+                process_line();
+                line.clear();
+                p = newline + 1;
+            }
+        }
+        if (running && !line.empty())
+            process_line();
+    }
+
+    if (running && error.empty()) {
+        shuffler.drain(emit);
+        if (running && filled > 0 && !config.drop_last) {
+            batch.X.conservativeResize(filled, Eigen::NoChange);
+            batch.Y.conservativeResize(filled, Eigen::NoChange);
+            push_batch(std::move(batch), config.prefetch_batches);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        epoch_finished = true;
+        reader_error = error;
+    }
+    cv.notify_all();
+}
+
+godot::Dictionary Dataset::next_batch() {
+    ERR_FAIL_COND_V_MSG(source.format == FORMAT_NONE, godot::Dictionary(), "Dataset::next_batch - no file is open");
+    if (!epoch_running)
+        start_epoch();
+
+    Batch batch;
+    bool got = false;
+    std::string error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !queue.empty() || epoch_finished; });
+        if (!queue.empty()) {
+            batch = std::move(queue.front());
+            queue.pop_front();
+            got = true;
+        } else {
+            error = reader_error;
+        }
+    }
+    if (got) {
+        // Room for the reader to prefetch the next one
+        cv.notify_all();
+        godot::Dictionary out;
+        out["inputs"] = godot::Matrix::from_eigen(std::move(batch.X));
+        out["targets"] = godot::Matrix::from_eigen(std::move(batch.Y));
+        return out;
+    }
+
+    // Epoch exhausted; the next call starts another one
+    stop_reader();
+    epoch_running = false;
+    if (!error.empty())
+        Logger::error_raise("Dataset::next_batch - " + error);
+    return godot::Dictionary();
+}
+
+int64_t Dataset::get_rows_read() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return int64_t(rows_read);
+}
+
+void Dataset::set_batch_size(int size) {
+    batch_size = std::max(1, size);
+}
+
+void Dataset::set_shuffle_buffer(int rows) {
+    shuffle_buffer = std::max(0, rows);
+}
+
+void Dataset::set_prefetch_batches(int count) {
+    prefetch_batches = std::max(1, count);
+}
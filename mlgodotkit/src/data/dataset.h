@@ -0,0 +1,123 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "matrix/matrix.h"
+
+// Streams minibatches from a feature file that does not need to fit in
+// memory. A background thread reads the file in chunks, randomizes rows
+// through a shuffle buffer and assembles row-major batches into a small
+// queue, so reading the next batch overlaps with training on the current one.
+class Dataset : public godot::RefCounted {
+    GDCLASS(Dataset, godot::RefCounted);
+
+public:
+    enum Format {
+        FORMAT_NONE,
+        FORMAT_BINARY,      // float32 rows [x_0 .. x_{d-1}, y_0 .. y_{k-1}], as LinearRegressionNode::fit_file
+        FORMAT_CSV,
+        FORMAT_LOG,         // ExperienceRecorder log, records split as in FORMAT_BINARY
+    };
+
+    // Read size of the background thread
+    static constexpr int CHUNK_BYTES = 1 << 20;
+
+private:
+    struct Source {
+        godot::String path;
+        Format format = FORMAT_NONE;
+        int n_features = 0;
+        int n_targets = 0;
+        bool skip_header = false;
+        char delimiter = ',';
+    };
+
+    struct EpochConfig {
+        int batch_size = 32;
+        int shuffle_buffer = 0;
+        int prefetch_batches = 2;
+        bool drop_last = false;
+        uint64_t seed = 0;
+    };
+
+    struct Batch {
+        godot::Matrix::EigenMat X;
+        godot::Matrix::EigenMat Y;
+    };
+
+    Source source;
+
+    // Settings, read when an epoch starts
+    int batch_size = 32;
+    int shuffle_buffer = 4096;
+    int prefetch_batches = 2;
+    bool drop_last = false;
+    int seed = 0;
+
+    // Main thread only
+    bool epoch_running = false;
+    int epoch = 0;
+
+    // Reader thread and its batch queue (guarded by mutex)
+    std::thread reader;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Batch> queue;
+    bool epoch_finished = false;
+    bool stop_requested = false;
+    std::string reader_error;
+    uint64_t rows_read = 0;
+
+    void start_epoch();
+    void stop_reader();
+    void read_epoch(Source src, EpochConfig config);
+    // Blocks while `limit` batches are queued; false when the reader should stop
+    bool push_batch(Batch &&batch, int limit);
+
+protected:
+    static void _bind_methods();
+
+public:
+    Dataset() = default;
+    ~Dataset();
+
+    godot::Error open_binary(const godot::String &path, int n_features, int n_targets = 1);
+    godot::Error open_csv(const godot::String &path, int n_targets = 1, bool skip_header = true,
+                          const godot::String &delimiter = ",");
+    godot::Error open_log(const godot::String &path, int n_targets = 1);
+    void close();
+
+    // { "inputs": Matrix, "targets": Matrix }, or an empty Dictionary once
+    // the epoch is exhausted. The call after that starts the next epoch.
+    godot::Dictionary next_batch();
+    // Abandons the current epoch; the next next_batch() starts a new one
+    void reset();
+
+    int get_feature_count() const { return source.n_features; }
+    int get_target_count() const { return source.n_targets; }
+    int get_epoch() const { return epoch; }
+    // Rows queued since the file was opened
+    int64_t get_rows_read();
+
+    void set_batch_size(int size);
+    int get_batch_size() const { return batch_size; }
+    void set_shuffle_buffer(int rows);
+    int get_shuffle_buffer() const { return shuffle_buffer; }
+    void set_prefetch_batches(int count);
+    int get_prefetch_batches() const { return prefetch_batches; }
+    void set_drop_last(bool enabled) { drop_last = enabled; }
+    bool get_drop_last() const { return drop_last; }
+    void set_seed(int p_seed) { seed = p_seed; }
+    int get_seed() const { return seed; }
+};
+
+#endif // DATASET_H
@@ -0,0 +1,147 @@
+#include "experience_log.h"
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[8] = { 'M', 'L', 'G', 'K', 'E', 'X', 'P', 'L' };
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint32_t compression;
+    uint32_t layout_size;
+    uint32_t reserved0;
+    uint64_t record_count;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(FileHeader) == ExperienceLog::HEADER_SIZE, "experience log header must stay 64 bytes");
+
+struct ChunkHeader {
+    uint32_t records;
+    uint32_t compression;
+    uint32_t stored_bytes;
+    uint32_t raw_bytes;
+};
+static_assert(sizeof(ChunkHeader) == 16, "experience log chunk header must stay 16 bytes");
+
+godot::FileAccess::CompressionMode godot_mode(uint32_t compression) {
+    return compression == ExperienceLog::COMPRESSION_ZSTD ? godot::FileAccess::COMPRESSION_ZSTD
+                                                          : godot::FileAccess::COMPRESSION_FASTLZ;
+}
+
+} // namespace
+
+void ExperienceLog::write_header(godot::FileAccess &file, const Info &info) {
+    FileHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.header_size = HEADER_SIZE;
+    h.record_size = info.record_size;
+    h.compression = info.compression;
+    h.layout_size = static_cast<uint32_t>(info.layout.size());
+    h.record_count = info.record_count;
+    file.store_buffer(reinterpret_cast<const uint8_t *>(&h), sizeof(h));
+    if (!info.layout.empty())
+        file.store_buffer(reinterpret_cast<const uint8_t *>(info.layout.data()), info.layout.size());
+}
+
+uint32_t ExperienceLog::max_chunk_records(uint32_t record_size) {
+    const uint64_t record_bytes = uint64_t(record_size) * sizeof(float);
+    return record_bytes == 0 ? 0 : static_cast<uint32_t>(UINT32_MAX / record_bytes);
+}
+
+void ExperienceLog::write_chunk(godot::FileAccess &file, const float *records, uint32_t count, const Info &info) {
+    const uint32_t per_chunk = max_chunk_records(info.record_size);
+    if (per_chunk == 0)
+        return;
+    while (count > per_chunk) {
+        write_chunk(file, records, per_chunk, info);
+        records += size_t(per_chunk) * info.record_size;
+        count -= per_chunk;
+    }
+
+    ChunkHeader c{};
+    c.records = count;
+    c.compression = info.compression;
+    c.raw_bytes = static_cast<uint32_t>(uint64_t(count) * info.record_size * sizeof(float));
+
+    if (info.compression == COMPRESSION_NONE) {
+        c.stored_bytes = c.raw_bytes;
+        file.store_buffer(reinterpret_cast<const uint8_t *>(&c), sizeof(c));
+        file.store_buffer(reinterpret_cast<const uint8_t *>(records), c.raw_bytes);
+        return;
+    }
+
+    godot::PackedByteArray raw;
+    raw.resize(c.raw_bytes);
+    std::memcpy(raw.ptrw(), records, c.raw_bytes);
+    const godot::PackedByteArray packed = raw.compress(godot_mode(info.compression));
+    c.stored_bytes = static_cast<uint32_t>(packed.size());
+    file.store_buffer(reinterpret_cast<const uint8_t *>(&c), sizeof(c));
+    file.store_buffer(packed.ptr(), packed.size());
+}
+
+std::string ExperienceLog::read_header(godot::FileAccess &file, Info &info) {
+    FileHeader h{};
+    if (file.get_buffer(reinterpret_cast<uint8_t *>(&h), sizeof(h)) != sizeof(h) ||
+        std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+        return "not an experience log";
+    if (h.version != VERSION)
+        return "unsupported log version " + std::to_string(h.version);
+    // A record must fit in a chunk, which also keeps record_size within int
+    if (h.header_size < HEADER_SIZE || max_chunk_records(h.record_size) == 0 || h.compression > COMPRESSION_ZSTD)
+        return "malformed header";
+
+    file.seek(h.header_size);
+    info.layout.resize(h.layout_size);
+    if (h.layout_size > 0 &&
+        file.get_buffer(reinterpret_cast<uint8_t *>(&info.layout[0]), h.layout_size) != h.layout_size)
+        return "truncated layout";
+    info.record_size = h.record_size;
+    info.compression = h.compression;
+    info.record_count = h.record_count;
+    return "";
+}
+
+bool ExperienceLog::read_chunk(godot::FileAccess &file, const Info &info, std::vector<float> &out, std::string &error) {
+    ChunkHeader c{};
+    if (file.get_buffer(reinterpret_cast<uint8_t *>(&c), sizeof(c)) != sizeof(c))
+        return false;
+    if (uint64_t(c.records) * info.record_size * sizeof(float) != c.raw_bytes || c.compression > COMPRESSION_ZSTD) {
+        error = "corrupt chunk header";
+        return false;
+    }
+
+    // The stored bytes must be in the file before anything is allocated
+    if (uint64_t(c.stored_bytes) > file.get_length() - file.get_position())
+        return false;
+
+    const size_t offset = out.size();
+    out.resize(offset + size_t(c.records) * info.record_size);
+    uint8_t *dst = reinterpret_cast<uint8_t *>(out.data() + offset);
+
+    if (c.compression == COMPRESSION_NONE) {
+        if (c.stored_bytes != c.raw_bytes || file.get_buffer(dst, c.raw_bytes) != c.raw_bytes) {
+            out.resize(offset);
+            return false;
+        }
+        return true;
+    }
+
+    const godot::PackedByteArray packed = file.get_buffer(c.stored_bytes);
+    if (packed.size() != int64_t(c.stored_bytes)) {
+        out.resize(offset);
+        return false;
+    }
+    const godot::PackedByteArray raw = packed.decompress(c.raw_bytes, godot_mode(c.compression));
+    if (raw.size() != int64_t(c.raw_bytes)) {
+        out.resize(offset);
+        error = "chunk failed to decompress";
+        return false;
+    }
+    std::memcpy(dst, raw.ptr(), c.raw_bytes);
+    return true;
+}
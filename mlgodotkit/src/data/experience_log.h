@@ -0,0 +1,58 @@
+#ifndef EXPERIENCE_LOG_H
+#define EXPERIENCE_LOG_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Append-only log of fixed-size float32 records (little-endian):
+//
+//   Header   64 bytes   magic "MLGKEXPL", version, record size, compression,
+//                       layout length, record count (0 until the log is closed)
+//   Layout              free-form UTF-8 description of the record fields
+//   Chunks              16-byte chunk header (records, compression, stored
+//                       and raw byte counts) followed by the records,
+//                       compressed as a whole when compression is set
+//
+// Chunks are only ever appended, so a log cut short by a crash is still
+// readable up to its last complete chunk.
+namespace ExperienceLog {
+
+    constexpr uint32_t VERSION = 1;
+    constexpr uint32_t HEADER_SIZE = 64;
+
+    // Stored in the file; values are not Godot's CompressionMode
+    enum Compression : uint32_t {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_FASTLZ = 1,
+        COMPRESSION_ZSTD = 2,
+    };
+
+    struct Info {
+        uint32_t record_size = 0;
+        uint32_t compression = COMPRESSION_NONE;
+        uint64_t record_count = 0;
+        std::string layout;
+    };
+
+    // Chunk headers store byte counts in 32 bits, which caps the records per
+    // chunk. 0 when a single record is already too large.
+    uint32_t max_chunk_records(uint32_t record_size);
+
+    void write_header(godot::FileAccess &file, const Info &info);
+    // Writes `count` records as one chunk, or as several when their raw size
+    // does not fit in a chunk header. Nothing is written for records larger
+    // than a chunk can hold.
+    void write_chunk(godot::FileAccess &file, const float *records, uint32_t count, const Info &info);
+
+    // Validates the header and leaves the file at the first chunk. Returns an
+    // empty string on success, otherwise why the file was rejected.
+    std::string read_header(godot::FileAccess &file, Info &info);
+    // Appends the next chunk's records to `out`. False at the end of the log
+    // or at a truncated chunk; `error` is set only for corrupt data.
+    bool read_chunk(godot::FileAccess &file, const Info &info, std::vector<float> &out, std::string &error);
+
+} // namespace ExperienceLog
+
+#endif // EXPERIENCE_LOG_H
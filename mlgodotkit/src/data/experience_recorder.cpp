@@ -0,0 +1,254 @@
+#include "experience_recorder.h"
+#include "utility/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+// Upper bound on how long a lost wake-up can delay the writer
+constexpr double MIN_WAIT_SECONDS = 0.01;
+}
+
+void ExperienceRecorder::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_method(D_METHOD("open", "path", "record_size", "layout"), &ExperienceRecorder::open, DEFVAL(""));
+    ClassDB::bind_method(D_METHOD("record", "values"), &ExperienceRecorder::record);
+    ClassDB::bind_method(D_METHOD("flush"), &ExperienceRecorder::flush);
+    ClassDB::bind_method(D_METHOD("close"), &ExperienceRecorder::close);
+    ClassDB::bind_method(D_METHOD("is_open"), &ExperienceRecorder::is_open);
+    ClassDB::bind_method(D_METHOD("get_record_size"), &ExperienceRecorder::get_record_size);
+    ClassDB::bind_method(D_METHOD("get_recorded_count"), &ExperienceRecorder::get_recorded_count);
+    ClassDB::bind_method(D_METHOD("get_written_count"), &ExperienceRecorder::get_written_count);
+    ClassDB::bind_method(D_METHOD("get_dropped_count"), &ExperienceRecorder::get_dropped_count);
+
+    ClassDB::bind_method(D_METHOD("set_compression", "mode"), &ExperienceRecorder::set_compression);
+    ClassDB::bind_method(D_METHOD("get_compression"), &ExperienceRecorder::get_compression);
+    ClassDB::bind_method(D_METHOD("set_capacity", "records"), &ExperienceRecorder::set_capacity);
+    ClassDB::bind_method(D_METHOD("get_capacity"), &ExperienceRecorder::get_capacity);
+    ClassDB::bind_method(D_METHOD("set_chunk_records", "records"), &ExperienceRecorder::set_chunk_records);
+    ClassDB::bind_method(D_METHOD("get_chunk_records"), &ExperienceRecorder::get_chunk_records);
+    ClassDB::bind_method(D_METHOD("set_flush_interval", "seconds"), &ExperienceRecorder::set_flush_interval);
+    ClassDB::bind_method(D_METHOD("get_flush_interval"), &ExperienceRecorder::get_flush_interval);
+
+    ClassDB::bind_static_method("ExperienceRecorder", D_METHOD("load_log", "path"), &ExperienceRecorder::load_log);
+    ClassDB::bind_static_method("ExperienceRecorder", D_METHOD("read_log_info", "path"), &ExperienceRecorder::read_log_info);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "compression", PROPERTY_HINT_ENUM, "None,FastLZ,Zstd"),
+        "set_compression", "get_compression");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "capacity", PROPERTY_HINT_RANGE, "1,1048576,1,or_greater"),
+        "set_capacity", "get_capacity");
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "chunk_records", PROPERTY_HINT_RANGE, "1,65536,1,or_greater"),
+        "set_chunk_records", "get_chunk_records");
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "flush_interval", PROPERTY_HINT_RANGE, "0.0,60.0,0.01,or_greater"),
+        "set_flush_interval", "get_flush_interval");
+
+    BIND_ENUM_CONSTANT(COMPRESSION_NONE);
+    BIND_ENUM_CONSTANT(COMPRESSION_FASTLZ);
+    BIND_ENUM_CONSTANT(COMPRESSION_ZSTD);
+}
+
+ExperienceRecorder::~ExperienceRecorder() {
+    close();
+}
+
+void ExperienceRecorder::set_compression(int mode) {
+    ERR_FAIL_COND_MSG(mode < COMPRESSION_NONE || mode > COMPRESSION_ZSTD, "ExperienceRecorder - unknown compression");
+    compression = static_cast<Compression>(mode);
+}
+
+godot::Error ExperienceRecorder::open(const godot::String &path, int record_size, const godot::String &layout) {
+    ERR_FAIL_COND_V_MSG(record_size < 1, godot::ERR_INVALID_PARAMETER, "ExperienceRecorder::open - record_size must be positive");
+    ERR_FAIL_COND_V_MSG(uint64_t(chunk_records) > ExperienceLog::max_chunk_records(static_cast<uint32_t>(record_size)),
+        godot::ERR_INVALID_PARAMETER, "ExperienceRecorder::open - record_size * chunk_records is over 4 GiB per chunk");
+    close();
+
+    file = godot::FileAccess::open(path, godot::FileAccess::WRITE);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "ExperienceRecorder::open - could not create " + path);
+
+    info = ExperienceLog::Info();
+    info.record_size = static_cast<uint32_t>(record_size);
+    info.compression = static_cast<uint32_t>(compression);
+    info.layout = layout.utf8().get_data();
+    ExperienceLog::write_header(*file.ptr(), info);
+
+    ring_capacity = static_cast<uint64_t>(capacity);
+    ring.assign(size_t(ring_capacity) * record_size, 0.0f);
+    head.store(0);
+    tail.store(0);
+    dropped.store(0);
+    written.store(0);
+    flush_requested = false;
+    stop_requested = false;
+
+    writer_chunk = static_cast<uint64_t>(chunk_records);
+    writer = std::thread(&ExperienceRecorder::write_loop, this, writer_chunk, flush_interval);
+    return godot::OK;
+}
+
+bool ExperienceRecorder::record(const godot::PackedFloat32Array &values) {
+    ERR_FAIL_COND_V_MSG(file.is_null(), false, "ExperienceRecorder::record - no log is open");
+    ERR_FAIL_COND_V_MSG(values.size() != int64_t(info.record_size), false,
+        "ExperienceRecorder::record - expected " + godot::String::num_int64(info.record_size) + " values");
+
+    const uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= ring_capacity) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(ring.data() + size_t(h % ring_capacity) * info.record_size, values.ptr(),
+                size_t(info.record_size) * sizeof(float));
+    head.store(h + 1, std::memory_order_release);
+
+    // Lock-free hand-off; a missed notification only delays the writer
+    // until its next timed wake-up
+    if (h + 1 - tail.load(std::memory_order_relaxed) == writer_chunk)
+        wake_cv.notify_one();
+    return true;
+}
+
+uint64_t ExperienceRecorder::write_pending(std::vector<float> &staging, uint64_t chunk) {
+    const uint64_t t = tail.load(std::memory_order_relaxed);
+    const uint64_t n = std::min(head.load(std::memory_order_acquire) - t, chunk);
+    if (n == 0)
+        return 0;
+
+    // Copy out first so the slots go back to record() before the slow part
+    const size_t stride = info.record_size;
+    const uint64_t first = t % ring_capacity;
+    const uint64_t before_wrap = std::min(n, ring_capacity - first);
+    std::memcpy(staging.data(), ring.data() + first * stride, before_wrap * stride * sizeof(float));
+    if (n > before_wrap)
+        std::memcpy(staging.data() + before_wrap * stride, ring.data(), (n - before_wrap) * stride * sizeof(float));
+    tail.store(t + n, std::memory_order_release);
+
+    ExperienceLog::write_chunk(*file.ptr(), staging.data(), static_cast<uint32_t>(n), info);
+    info.record_count += n;
+    written.fetch_add(n);
+    return n;
+}
+
+void ExperienceRecorder::write_loop(uint64_t chunk, double interval) {
+    std::vector<float> staging(size_t(chunk) * info.record_size);
+    const auto wait = std::chrono::duration<double>(std::max(interval, MIN_WAIT_SECONDS));
+    auto last_partial = std::chrono::steady_clock::now();
+
+    for (;;) {
+        bool stopping = false;
+        bool flushing = false;
+        {
+            std::unique_lock<std::mutex> lock(writer_mutex);
+            wake_cv.wait_for(lock, wait, [&] {
+                return stop_requested || flush_requested ||
+                       head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed) >= chunk;
+            });
+            stopping = stop_requested;
+            flushing = flush_requested;
+            flush_requested = false;
+        }
+
+        // Full chunks go out as soon as they fill; a partial one waits for
+        // the flush interval unless someone asked for it
+        bool wrote = false;
+        while (head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed) >= chunk)
+            wrote |= write_pending(staging, chunk) > 0;
+        const auto now = std::chrono::steady_clock::now();
+        if (stopping || flushing || now - last_partial >= std::chrono::duration<double>(interval)) {
+            while (write_pending(staging, chunk) > 0)
+                wrote = true;
+            last_partial = now;
+        }
+        if (wrote)
+            file->flush();
+
+        {
+            // Taken so flush() cannot miss the notification
+            std::lock_guard<std::mutex> lock(writer_mutex);
+        }
+        written_cv.notify_all();
+        if (stopping)
+            return;
+    }
+}
+
+void ExperienceRecorder::flush() {
+    if (!writer.joinable())
+        return;
+    const uint64_t target = head.load();
+    std::unique_lock<std::mutex> lock(writer_mutex);
+    flush_requested = true;
+    wake_cv.notify_all();
+    written_cv.wait(lock, [&] { return written.load() >= target; });
+}
+
+void ExperienceRecorder::close() {
+    if (file.is_null())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        stop_requested = true;
+    }
+    wake_cv.notify_all();
+    // The writer drains the ring before it exits
+    writer.join();
+
+    // The final count marks the log as cleanly closed
+    file->seek(0);
+    ExperienceLog::write_header(*file.ptr(), info);
+    file->close();
+    file.unref();
+    ring.clear();
+    ring.shrink_to_fit();
+    Logger::debug(1, "ExperienceRecorder::close - " + std::to_string(info.record_count) + " records written, " +
+                     std::to_string(dropped.load()) + " dropped");
+}
+
+godot::Ref<godot::Matrix> ExperienceRecorder::load_log(const godot::String &path) {
+    const std::string where = std::string("ExperienceRecorder.load_log(") + path.utf8().get_data() + ")";
+    godot::Ref<godot::FileAccess> in = godot::FileAccess::open(path, godot::FileAccess::READ);
+    if (in.is_null()) {
+        Logger::error_raise(where + ": could not open file");
+        return godot::Ref<godot::Matrix>();
+    }
+
+    ExperienceLog::Info log;
+    std::string problem = ExperienceLog::read_header(*in.ptr(), log);
+    if (!problem.empty()) {
+        Logger::error_raise(where + ": " + problem);
+        return godot::Ref<godot::Matrix>();
+    }
+
+    // record_count comes from the file, so never reserve more than the file
+    // could hold uncompressed; compressed chunks just grow the vector
+    std::vector<float> rows;
+    const uint64_t file_records = in->get_length() / sizeof(float) / log.record_size;
+    rows.reserve(size_t(std::min(log.record_count, file_records)) * log.record_size);
+    while (ExperienceLog::read_chunk(*in.ptr(), log, rows, problem)) {
+    }
+    if (!problem.empty()) {
+        Logger::error_raise(where + ": " + problem);
+        return godot::Ref<godot::Matrix>();
+    }
+
+    const int64_t count = int64_t(rows.size() / log.record_size);
+    if (log.record_count == 0 && count > 0)
+        Logger::warn(where + ": log was not closed cleanly, read " + std::to_string(count) + " records");
+    godot::Matrix::EigenMat m = Eigen::Map<const godot::Matrix::EigenMat>(rows.data(), count, log.record_size);
+    return godot::Matrix::from_eigen(std::move(m));
+}
+
+godot::Dictionary ExperienceRecorder::read_log_info(const godot::String &path) {
+    godot::Dictionary out;
+    godot::Ref<godot::FileAccess> in = godot::FileAccess::open(path, godot::FileAccess::READ);
+    ERR_FAIL_COND_V_MSG(in.is_null(), out, "ExperienceRecorder::read_log_info - could not open " + path);
+
+    ExperienceLog::Info log;
+    const std::string problem = ExperienceLog::read_header(*in.ptr(), log);
+    ERR_FAIL_COND_V_MSG(!problem.empty(), out,
+        godot::String("ExperienceRecorder::read_log_info - ") + problem.c_str());
+
+    out["record_size"] = static_cast<int>(log.record_size);
+    out["compression"] = static_cast<int>(log.compression);
+    out["record_count"] = static_cast<int64_t>(log.record_count);
+    out["layout"] = godot::String::utf8(log.layout.c_str());
+    return out;
+}
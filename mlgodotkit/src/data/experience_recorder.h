@@ -0,0 +1,102 @@
+#ifndef EXPERIENCE_RECORDER_H
+#define EXPERIENCE_RECORDER_H
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "data/experience_log.h"
+#include "matrix/matrix.h"
+
+// Records fixed-size float rows (observation, action, reward, ...) from a
+// live session into an experience log (see experience_log.h). record() only
+// copies into an in-memory ring and never blocks or locks; a writer thread
+// drains the ring into compressed chunks.
+class ExperienceRecorder : public godot::RefCounted {
+    GDCLASS(ExperienceRecorder, godot::RefCounted);
+
+public:
+    // Values match ExperienceLog::Compression
+    enum Compression {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_FASTLZ = 1,
+        COMPRESSION_ZSTD = 2,
+    };
+
+private:
+    godot::Ref<godot::FileAccess> file;
+    ExperienceLog::Info info;
+
+    // Settings, read by open()
+    Compression compression = COMPRESSION_FASTLZ;
+    int capacity = 65536;
+    int chunk_records = 4096;
+    double flush_interval = 1.0;
+
+    // Single-producer ring: record() advances head, the writer advances tail
+    std::vector<float> ring;
+    uint64_t ring_capacity = 0;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+
+    std::thread writer;
+    std::mutex writer_mutex;
+    std::condition_variable wake_cv;      // wakes the writer
+    std::condition_variable written_cv;   // wakes flush()
+    bool flush_requested = false;
+    bool stop_requested = false;
+
+    // Chunk size the writer was started with; record() wakes it on a full chunk
+    uint64_t writer_chunk = 0;
+
+    void write_loop(uint64_t chunk, double interval);
+    // Writes up to `chunk` pending records as one chunk; returns how many
+    uint64_t write_pending(std::vector<float> &staging, uint64_t chunk);
+
+protected:
+    static void _bind_methods();
+
+public:
+    ExperienceRecorder() = default;
+    ~ExperienceRecorder();
+
+    godot::Error open(const godot::String &path, int record_size, const godot::String &layout = "");
+    // Call from one thread at a time. False when no log is open, the size is
+    // wrong, or the ring is full (the record is then counted as dropped).
+    bool record(const godot::PackedFloat32Array &values);
+    // Blocks until everything recorded so far is in the file
+    void flush();
+    void close();
+    bool is_open() const { return file.is_valid(); }
+
+    int get_record_size() const { return static_cast<int>(info.record_size); }
+    int64_t get_recorded_count() const { return int64_t(head.load()); }
+    int64_t get_written_count() const { return int64_t(written.load()); }
+    int64_t get_dropped_count() const { return int64_t(dropped.load()); }
+
+    void set_compression(int mode);
+    int get_compression() const { return compression; }
+    void set_capacity(int records) { capacity = records > 0 ? records : 1; }
+    int get_capacity() const { return capacity; }
+    void set_chunk_records(int records) { chunk_records = records > 0 ? records : 1; }
+    int get_chunk_records() const { return chunk_records; }
+    void set_flush_interval(double seconds) { flush_interval = seconds > 0.0 ? seconds : 0.0; }
+    double get_flush_interval() const { return flush_interval; }
+
+    // Reader side: one row per record
+    static godot::Ref<godot::Matrix> load_log(const godot::String &path);
+    static godot::Dictionary read_log_info(const godot::String &path);
+};
+
+VARIANT_ENUM_CAST(ExperienceRecorder::Compression);
+
+#endif // EXPERIENCE_RECORDER_H
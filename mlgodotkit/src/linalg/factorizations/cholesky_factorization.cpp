@@ -0,0 +1,53 @@
+#include "cholesky_factorization.h"
+#include "utility/logger.h"
+
+namespace godot {
+
+void CholeskyFactorization::_bind_methods() {
+    ClassDB::bind_static_method("CholeskyFactorization", D_METHOD("create", "A", "ldlt"), &CholeskyFactorization::create, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("set_use_ldlt", "enabled"), &CholeskyFactorization::set_use_ldlt);
+    ClassDB::bind_method(D_METHOD("get_use_ldlt"), &CholeskyFactorization::get_use_ldlt);
+    ClassDB::bind_method(D_METHOD("is_ldlt"), &CholeskyFactorization::is_ldlt);
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_ldlt"), "set_use_ldlt", "get_use_ldlt");
+}
+
+Ref<CholeskyFactorization> CholeskyFactorization::create(const Ref<Matrix> &A, bool ldlt) {
+    Ref<CholeskyFactorization> out = memnew(CholeskyFactorization());
+    out->use_ldlt = ldlt;
+    out->compute(A);
+    return out;
+}
+
+bool CholeskyFactorization::compute_impl(const Matrix::EigenMat &A) {
+    if (A.rows() != A.cols()) {
+        Logger::error_raise("CholeskyFactorization.compute(): matrix must be square");
+        return false;
+    }
+
+    if (!use_ldlt) {
+        llt.compute(A);
+        if (llt.info() == Eigen::Success) {
+            using_ldlt = false;
+            return true;
+        }
+        Logger::debug(1, "CholeskyFactorization.compute(): not positive definite, falling back to LDLT");
+    }
+
+    ldlt.compute(A);
+    if (ldlt.info() != Eigen::Success) {
+        Logger::error_raise("CholeskyFactorization.compute(): decomposition failed");
+        return false;
+    }
+    using_ldlt = true;
+    return true;
+}
+
+void CholeskyFactorization::solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const {
+    if (using_ldlt)
+        out.noalias() = ldlt.solve(b);
+    else
+        out.noalias() = llt.solve(b);
+}
+
+} // namespace godot
@@ -0,0 +1,38 @@
+#ifndef CHOLESKY_FACTORIZATION_H
+#define CHOLESKY_FACTORIZATION_H
+
+#include "linalg/factorizations/factorization.h"
+#include <Eigen/Dense>
+
+namespace godot {
+
+// Cholesky (LLT) fast path for symmetric positive-definite systems.
+// Falls back to a pivoted LDLT when the matrix is only semi-definite or
+// indefinite, or when use_ldlt is set.
+class CholeskyFactorization : public Factorization {
+    GDCLASS(CholeskyFactorization, Factorization);
+
+private:
+    Eigen::LLT<Eigen::MatrixXf> llt;
+    Eigen::LDLT<Eigen::MatrixXf> ldlt;
+    bool use_ldlt = false;
+    bool using_ldlt = false;
+
+protected:
+    static void _bind_methods();
+
+    bool compute_impl(const Matrix::EigenMat &A) override;
+    void solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const override;
+    const char *name() const override { return "CholeskyFactorization"; }
+
+public:
+    static Ref<CholeskyFactorization> create(const Ref<Matrix> &A, bool ldlt = false);
+
+    void set_use_ldlt(bool enabled) { use_ldlt = enabled; }
+    bool get_use_ldlt() const { return use_ldlt; }
+    bool is_ldlt() const { return using_ldlt; }
+};
+
+} // namespace godot
+
+#endif
@@ -0,0 +1,72 @@
+#include "factorization.h"
+#include "utility/logger.h"
+
+namespace godot {
+
+void Factorization::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("compute", "A"), &Factorization::compute);
+    ClassDB::bind_method(D_METHOD("solve", "b"), &Factorization::solve);
+    ClassDB::bind_method(D_METHOD("solve_into", "b", "out"), &Factorization::solve_into);
+    ClassDB::bind_method(D_METHOD("invalidate"), &Factorization::invalidate);
+    ClassDB::bind_method(D_METHOD("is_valid"), &Factorization::is_valid);
+    ClassDB::bind_method(D_METHOD("rows"), &Factorization::rows);
+    ClassDB::bind_method(D_METHOD("cols"), &Factorization::cols);
+}
+
+bool Factorization::compute_impl(const Matrix::EigenMat &) {
+    ERR_PRINT("Factorization::compute() not implemented.");
+    return false;
+}
+
+void Factorization::solve_impl(const Matrix::EigenMat &, Matrix::EigenMat &) const {
+    ERR_PRINT("Factorization::solve() not implemented.");
+}
+
+bool Factorization::compute(const Ref<Matrix> &A) {
+    valid = false;
+    if (A.is_null()) {
+        Logger::error_raise(std::string(name()) + ".compute(): null input");
+        return false;
+    }
+    n_rows = A->rows();
+    n_cols = A->cols();
+    valid = compute_impl(A->eigen());
+    return valid;
+}
+
+Ref<Matrix> Factorization::solve(const Ref<Matrix> &b) const {
+    Ref<Matrix> out = memnew(Matrix());
+    if (!solve_into(b, out))
+        return Ref<Matrix>();
+    return out;
+}
+
+bool Factorization::solve_into(const Ref<Matrix> &b, const Ref<Matrix> &out) const {
+    if (!valid) {
+        Logger::error_raise(std::string(name()) + ".solve(): no valid factorization, call compute() first");
+        return false;
+    }
+    if (b.is_null() || out.is_null()) {
+        Logger::error_raise(std::string(name()) + ".solve(): null input");
+        return false;
+    }
+    if (b->rows() != n_rows) {
+        Logger::error_raise(std::string(name()) + ".solve(): dimension mismatch");
+        return false;
+    }
+    if (b == out) {
+        Matrix::EigenMat tmp;
+        solve_impl(b->eigen(), tmp);
+        out->eigen().swap(tmp);
+        return true;
+    }
+    // Assigning into an already-sized out reuses its buffer
+    solve_impl(b->eigen(), out->eigen());
+    return true;
+}
+
+void Factorization::invalidate() {
+    valid = false;
+}
+
+} // namespace godot
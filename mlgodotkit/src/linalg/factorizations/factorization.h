@@ -0,0 +1,41 @@
+#ifndef FACTORIZATION_H
+#define FACTORIZATION_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include "matrix/matrix.h"
+
+namespace godot {
+
+// Base for cached matrix factorizations. A factorization is computed once by
+// compute() and reused by every solve() until invalidate() or the next compute().
+class Factorization : public RefCounted {
+    GDCLASS(Factorization, RefCounted);
+
+protected:
+    bool valid = false;
+    int n_rows = 0;
+    int n_cols = 0;
+
+    static void _bind_methods();
+
+    virtual bool compute_impl(const Matrix::EigenMat &A);
+    virtual void solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const;
+    virtual const char *name() const { return "Factorization"; }
+
+public:
+    virtual ~Factorization() {}
+
+    bool compute(const Ref<Matrix> &A);
+    Ref<Matrix> solve(const Ref<Matrix> &b) const;
+    bool solve_into(const Ref<Matrix> &b, const Ref<Matrix> &out) const;
+
+    void invalidate();
+    bool is_valid() const { return valid; }
+    int rows() const { return n_rows; }
+    int cols() const { return n_cols; }
+};
+
+} // namespace godot
+
+#endif
@@ -0,0 +1,38 @@
+#include "lu_factorization.h"
+#include "utility/logger.h"
+
+namespace godot {
+
+void LUFactorization::_bind_methods() {
+    ClassDB::bind_static_method("LUFactorization", D_METHOD("create", "A"), &LUFactorization::create);
+    ClassDB::bind_method(D_METHOD("det"), &LUFactorization::det);
+}
+
+Ref<LUFactorization> LUFactorization::create(const Ref<Matrix> &A) {
+    Ref<LUFactorization> out = memnew(LUFactorization());
+    out->compute(A);
+    return out;
+}
+
+bool LUFactorization::compute_impl(const Matrix::EigenMat &A) {
+    if (A.rows() != A.cols()) {
+        Logger::error_raise("LUFactorization.compute(): matrix must be square");
+        return false;
+    }
+    lu.compute(A);
+    return true;
+}
+
+void LUFactorization::solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const {
+    out.noalias() = lu.solve(b);
+}
+
+float LUFactorization::det() const {
+    if (!valid) {
+        Logger::error_raise("LUFactorization.det(): no valid factorization");
+        return 0.0f;
+    }
+    return lu.determinant();
+}
+
+} // namespace godot
@@ -0,0 +1,31 @@
+#ifndef LU_FACTORIZATION_H
+#define LU_FACTORIZATION_H
+
+#include "linalg/factorizations/factorization.h"
+#include <Eigen/Dense>
+
+namespace godot {
+
+// Partial-pivoting LU for square, invertible systems.
+class LUFactorization : public Factorization {
+    GDCLASS(LUFactorization, Factorization);
+
+private:
+    Eigen::PartialPivLU<Eigen::MatrixXf> lu;
+
+protected:
+    static void _bind_methods();
+
+    bool compute_impl(const Matrix::EigenMat &A) override;
+    void solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const override;
+    const char *name() const override { return "LUFactorization"; }
+
+public:
+    static Ref<LUFactorization> create(const Ref<Matrix> &A);
+
+    float det() const;
+};
+
+} // namespace godot
+
+#endif
@@ -0,0 +1,34 @@
+#include "qr_factorization.h"
+#include "utility/logger.h"
+
+namespace godot {
+
+void QRFactorization::_bind_methods() {
+    ClassDB::bind_static_method("QRFactorization", D_METHOD("create", "A"), &QRFactorization::create);
+    ClassDB::bind_method(D_METHOD("rank"), &QRFactorization::rank);
+}
+
+Ref<QRFactorization> QRFactorization::create(const Ref<Matrix> &A) {
+    Ref<QRFactorization> out = memnew(QRFactorization());
+    out->compute(A);
+    return out;
+}
+
+bool QRFactorization::compute_impl(const Matrix::EigenMat &A) {
+    qr.compute(A);
+    return true;
+}
+
+void QRFactorization::solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const {
+    out.noalias() = qr.solve(b);
+}
+
+int QRFactorization::rank() const {
+    if (!valid) {
+        Logger::error_raise("QRFactorization.rank(): no valid factorization");
+        return 0;
+    }
+    return qr.rank();
+}
+
+} // namespace godot
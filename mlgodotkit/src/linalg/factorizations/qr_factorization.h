@@ -0,0 +1,32 @@
+#ifndef QR_FACTORIZATION_H
+#define QR_FACTORIZATION_H
+
+#include "linalg/factorizations/factorization.h"
+#include <Eigen/Dense>
+
+namespace godot {
+
+// Column-pivoted Householder QR. solve() returns the least-squares solution
+// for rectangular systems, matching Linalg.least_squares().
+class QRFactorization : public Factorization {
+    GDCLASS(QRFactorization, Factorization);
+
+private:
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXf> qr;
+
+protected:
+    static void _bind_methods();
+
+    bool compute_impl(const Matrix::EigenMat &A) override;
+    void solve_impl(const Matrix::EigenMat &b, Matrix::EigenMat &out) const override;
+    const char *name() const override { return "QRFactorization"; }
+
+public:
+    static Ref<QRFactorization> create(const Ref<Matrix> &A);
+
+    int rank() const;
+};
+
+} // namespace godot
+
+#endif
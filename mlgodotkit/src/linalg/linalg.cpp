@@ -1,8 +1,10 @@
 #include "linalg.h"
 #include "utility/logger.h"
-#include "utility/utils.h"
+#include "linalg/linalg_core.h"
 #include <godot_cpp/core/class_db.hpp>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <algorithm>
 
 namespace godot {
 
@@ -11,9 +13,15 @@ void Linalg::_bind_methods() {
     ClassDB::bind_static_method("Linalg", D_METHOD("least_squares", "A", "b"), &Linalg::least_squares);
     ClassDB::bind_static_method("Linalg", D_METHOD("pinv", "A"), &Linalg::pinv);
 
-    ClassDB::bind_static_method("Linalg", D_METHOD("qr", "A"), &Linalg::qr);
-    ClassDB::bind_static_method("Linalg", D_METHOD("svd", "A"), &Linalg::svd);
-    ClassDB::bind_static_method("Linalg", D_METHOD("eig", "A"), &Linalg::eig);
+    ClassDB::bind_static_method("Linalg", D_METHOD("solve_batched", "A_stack", "b_stack", "n"), &Linalg::solve_batched);
+
+    ClassDB::bind_static_method("Linalg", D_METHOD("solve_sparse_ldlt", "A", "b"), &Linalg::solve_sparse_ldlt);
+    ClassDB::bind_static_method("Linalg", D_METHOD("solve_cg", "A", "b", "tol", "max_iter"), &Linalg::solve_cg, DEFVAL(1e-6f), DEFVAL(0));
+    ClassDB::bind_static_method("Linalg", D_METHOD("solve_bicgstab", "A", "b", "tol", "max_iter"), &Linalg::solve_bicgstab, DEFVAL(1e-6f), DEFVAL(0));
+
+    ClassDB::bind_static_method("Linalg", D_METHOD("qr", "A", "compute_q"), &Linalg::qr, DEFVAL(true));
+    ClassDB::bind_static_method("Linalg", D_METHOD("svd", "A", "compute_uv"), &Linalg::svd, DEFVAL(true));
+    ClassDB::bind_static_method("Linalg", D_METHOD("eig", "A", "compute_vectors"), &Linalg::eig, DEFVAL(true));
     ClassDB::bind_static_method("Linalg", D_METHOD("lu", "A"), &Linalg::lu);
 }
 
@@ -55,61 +63,159 @@ Ref<Matrix> Linalg::least_squares(const Ref<Matrix> &A, const Ref<Matrix> &b) {
     return out;
 }
 
+using RowMat = LinalgCore::RowMat;
+using RowVec = LinalgCore::RowVec;
+
 Ref<Matrix> Linalg::pinv(const Ref<Matrix> &A) {
     if (A.is_null()) {
         Logger::error_raise("Linalg.pinv(): null input");
         return Ref<Matrix>();
     }
 
-    const auto &m = A->eigen();
+    return Matrix::from_eigen(LinalgCore::pinv(A->eigen()));
+}
+
+PackedFloat32Array Linalg::solve_batched(const PackedFloat32Array &A_stack,
+                                         const PackedFloat32Array &b_stack, int n) {
+    if (n <= 0 || A_stack.size() % (int64_t(n) * n) != 0) {
+        Logger::error_raise("Linalg.solve_batched(): A_stack size must be a multiple of n*n");
+        return PackedFloat32Array();
+    }
+    const int count = A_stack.size() / (n * n);
+    if (count == 0)
+        return PackedFloat32Array();
+    if (b_stack.size() % (int64_t(count) * n) != 0 || b_stack.size() == 0) {
+        Logger::error_raise("Linalg.solve_batched(): b_stack size must be a multiple of count*n");
+        return PackedFloat32Array();
+    }
+    const int k = b_stack.size() / (count * n);
+
+    PackedFloat32Array out;
+    out.resize(b_stack.size());
+
+    const float *A = A_stack.ptr();
+    const float *b = b_stack.ptr();
+    float *x = out.ptrw();
+
+    LinalgCore::solve_batched(A, b, x, count, n, k);
+
+    return out;
+}
 
-    Eigen::JacobiSVD<Eigen::MatrixXf> svd(
-        m, Eigen::ComputeThinU | Eigen::ComputeThinV
-    );
+static bool check_sparse_system(const Ref<SparseMatrix> &A, const Ref<Matrix> &b, const char *who) {
+    if (A.is_null() || b.is_null()) {
+        Logger::error_raise(std::string("Linalg.") + who + "(): null input");
+        return false;
+    }
+    if (A->rows() != A->cols() || A->rows() != b->rows()) {
+        Logger::error_raise(std::string("Linalg.") + who + "(): dimension mismatch");
+        return false;
+    }
+    return true;
+}
 
-    float tol = 1e-6f * std::max(m.rows(), m.cols()) *
-                svd.singularValues().array().abs().maxCoeff();
+Ref<Matrix> Linalg::solve_sparse_ldlt(const Ref<SparseMatrix> &A, const Ref<Matrix> &b) {
+    if (!check_sparse_system(A, b, "solve_sparse_ldlt"))
+        return Ref<Matrix>();
 
-    Eigen::VectorXf inv_s = svd.singularValues();
-    for (int i = 0; i < inv_s.size(); ++i)
-        inv_s(i) = (inv_s(i) > tol) ? 1.0f / inv_s(i) : 0.0f;
+    // Simplicial factorizations work on column-major storage
+    Eigen::SparseMatrix<float> colA = A->eigen();
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<float>> ldlt(colA);
+    if (ldlt.info() != Eigen::Success) {
+        Logger::error_raise("Linalg.solve_sparse_ldlt(): factorization failed (matrix must be symmetric positive semi-definite)");
+        return Ref<Matrix>();
+    }
 
     Ref<Matrix> out = memnew(Matrix());
-    out->eigen() =
-        svd.matrixV() * inv_s.asDiagonal() * svd.matrixU().transpose();
+    out->eigen() = ldlt.solve(b->eigen());
+    return out;
+}
+
+Ref<Matrix> Linalg::solve_cg(const Ref<SparseMatrix> &A, const Ref<Matrix> &b, float tol, int max_iter) {
+    if (!check_sparse_system(A, b, "solve_cg"))
+        return Ref<Matrix>();
 
+    // Lower|Upper on row-major storage lets Eigen run the matvec across threads
+    Eigen::ConjugateGradient<SparseMatrix::EigenSparse, Eigen::Lower | Eigen::Upper> cg;
+    cg.setTolerance(tol);
+    if (max_iter > 0)
+        cg.setMaxIterations(max_iter);
+    cg.compute(A->eigen());
+
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen() = cg.solve(b->eigen());
+    if (cg.info() != Eigen::Success) {
+        Logger::warn("Linalg.solve_cg(): did not converge (iterations=" +
+            std::to_string(cg.iterations()) + ", error=" + std::to_string(cg.error()) + ")");
+    }
     return out;
 }
 
-Dictionary Linalg::qr(const Ref<Matrix> &A) {
-    const auto &m = A->eigen();
+Ref<Matrix> Linalg::solve_bicgstab(const Ref<SparseMatrix> &A, const Ref<Matrix> &b, float tol, int max_iter) {
+    if (!check_sparse_system(A, b, "solve_bicgstab"))
+        return Ref<Matrix>();
+
+    Eigen::BiCGSTAB<SparseMatrix::EigenSparse> solver;
+    solver.setTolerance(tol);
+    if (max_iter > 0)
+        solver.setMaxIterations(max_iter);
+    solver.compute(A->eigen());
+    if (solver.info() != Eigen::Success) {
+        Logger::error_raise("Linalg.solve_bicgstab(): preconditioner setup failed");
+        return Ref<Matrix>();
+    }
+
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen() = solver.solve(b->eigen());
+    if (solver.info() != Eigen::Success) {
+        Logger::warn("Linalg.solve_bicgstab(): did not converge (iterations=" +
+            std::to_string(solver.iterations()) + ", error=" + std::to_string(solver.error()) + ")");
+    }
+    return out;
+}
 
-    Eigen::HouseholderQR<Eigen::MatrixXf> qr(m);
-    Eigen::MatrixXf Q = qr.householderQ() *
-        Eigen::MatrixXf::Identity(m.rows(), m.cols());
-    Eigen::MatrixXf R = qr.matrixQR().triangularView<Eigen::Upper>();
+Dictionary Linalg::qr(const Ref<Matrix> &A, bool compute_q) {
+    if (A.is_null()) {
+        Logger::error_raise("Linalg.qr(): null input");
+        return Dictionary();
+    }
+    RowMat Q, R;
+    LinalgCore::qr(A->eigen(), compute_q, &Q, R);
 
+    // Thin factors: Q is (m x k), R is (k x n)
     Dictionary out;
-    out["Q"] = Matrix::from_array(Utils::eigen_to_godot(Q));
-    out["R"] = Matrix::from_array(Utils::eigen_to_godot(R));
+    if (compute_q)
+        out["Q"] = Matrix::from_eigen(std::move(Q));
+    out["R"] = Matrix::from_eigen(std::move(R));
     return out;
 }
 
-Dictionary Linalg::svd(const Ref<Matrix> &A) {
-    const auto &m = A->eigen();
+Dictionary Linalg::svd(const Ref<Matrix> &A, bool compute_uv) {
+    if (A.is_null()) {
+        Logger::error_raise("Linalg.svd(): null input");
+        return Dictionary();
+    }
 
-    Eigen::JacobiSVD<Eigen::MatrixXf> svd(
-        m, Eigen::ComputeThinU | Eigen::ComputeThinV
-    );
+    RowMat U, V;
+    RowVec S;
+    LinalgCore::svd(A->eigen(), compute_uv, &U, S, &V);
 
     Dictionary out;
-    out["U"] = Matrix::from_array(Utils::eigen_to_godot(svd.matrixU()));
-    out["S"] = Matrix::from_array(Utils::eigen_to_godot(svd.singularValues().asDiagonal()));
-    out["V"] = Matrix::from_array(Utils::eigen_to_godot(svd.matrixV()));
+    if (compute_uv) {
+        // Square diagonal S kept for U * S * V^T reconstruction; it is only k x k
+        out["U"] = Matrix::from_eigen(std::move(U));
+        out["S"] = Matrix::from_eigen(RowMat(S.asDiagonal()));
+        out["V"] = Matrix::from_eigen(std::move(V));
+    }
+    out["singular_values"] = Matrix::from_eigen(RowMat(S));
     return out;
 }
 
-Dictionary Linalg::eig(const Ref<Matrix> &A) {
+Dictionary Linalg::eig(const Ref<Matrix> &A, bool compute_vectors) {
+    if (A.is_null()) {
+        Logger::error_raise("Linalg.eig(): null input");
+        return Dictionary();
+    }
     const auto &m = A->eigen();
 
     if (m.rows() != m.cols()) {
@@ -117,31 +223,40 @@ Dictionary Linalg::eig(const Ref<Matrix> &A) {
         return Dictionary();
     }
 
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXf> eig(m);
-    if (eig.info() != Eigen::Success) {
+    RowVec values;
+    RowMat vectors;
+    if (!LinalgCore::eig(m, compute_vectors, values, &vectors)) {
         Logger::error_raise("Linalg.eig(): decomposition failed");
         return Dictionary();
     }
 
     Dictionary out;
-    out["values"] = Matrix::from_array(Utils::eigen_to_godot(eig.eigenvalues()));
-    out["vectors"] = Matrix::from_array(Utils::eigen_to_godot(eig.eigenvectors()));
+    out["values"] = Matrix::from_eigen(RowMat(values));
+    if (compute_vectors)
+        out["vectors"] = Matrix::from_eigen(std::move(vectors));
     return out;
 }
 
 Dictionary Linalg::lu(const Ref<Matrix> &A) {
+    if (A.is_null()) {
+        Logger::error_raise("Linalg.lu(): null input");
+        return Dictionary();
+    }
     const auto &m = A->eigen();
 
-    Eigen::PartialPivLU<Eigen::MatrixXf> lu(m);
+    if (m.rows() != m.cols()) {
+        Logger::error_raise("Linalg.lu(): matrix must be square");
+        return Dictionary();
+    }
+
+    RowMat L, U, P;
+    LinalgCore::lu(m, L, U, P);
 
+    // A = P L U
     Dictionary out;
-    out["L"] = Matrix::from_array(Utils::eigen_to_godot(
-        Eigen::MatrixXf(lu.matrixLU().triangularView<Eigen::UnitLower>())
-    ));
-    out["U"] = Matrix::from_array(Utils::eigen_to_godot(
-        Eigen::MatrixXf(lu.matrixLU().triangularView<Eigen::Upper>())
-    ));
-    out["P"] = Matrix::from_array(Utils::eigen_to_godot(lu.permutationP()));
+    out["L"] = Matrix::from_eigen(std::move(L));
+    out["U"] = Matrix::from_eigen(std::move(U));
+    out["P"] = Matrix::from_eigen(std::move(P));
     return out;
 }
 
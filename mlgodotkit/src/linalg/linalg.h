@@ -3,7 +3,10 @@
 
 #include <godot_cpp/classes/object.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include "matrix/matrix.h"
+#include "matrix/sparse_matrix.h"
+#include "linalg/linalg_core.h"
 
 namespace godot {
 
@@ -18,10 +21,24 @@ public:
     static Ref<Matrix> least_squares(const Ref<Matrix> &A, const Ref<Matrix> &b);
     static Ref<Matrix> pinv(const Ref<Matrix> &A);
 
-    static Dictionary qr(const Ref<Matrix> &A);
-    static Dictionary svd(const Ref<Matrix> &A);
-    static Dictionary eig(const Ref<Matrix> &A);
+    // Many independent n x n systems packed back to back (row-major)
+    static PackedFloat32Array solve_batched(const PackedFloat32Array &A_stack,
+                                            const PackedFloat32Array &b_stack, int n);
+
+    // Sparse solvers
+    static Ref<Matrix> solve_sparse_ldlt(const Ref<SparseMatrix> &A, const Ref<Matrix> &b);
+    static Ref<Matrix> solve_cg(const Ref<SparseMatrix> &A, const Ref<Matrix> &b,
+                                float tol = 1e-6f, int max_iter = 0);
+    static Ref<Matrix> solve_bicgstab(const Ref<SparseMatrix> &A, const Ref<Matrix> &b,
+                                      float tol = 1e-6f, int max_iter = 0);
+
+    static Dictionary qr(const Ref<Matrix> &A, bool compute_q = true);
+    static Dictionary svd(const Ref<Matrix> &A, bool compute_uv = true);
+    static Dictionary eig(const Ref<Matrix> &A, bool compute_vectors = true);
     static Dictionary lu(const Ref<Matrix> &A);
+
+    // Above this size svd()/pinv() switch from Jacobi to divide-and-conquer SVD
+    static constexpr int BDCSVD_THRESHOLD = LinalgCore::BDCSVD_THRESHOLD;
 };
 
 } // namespace godot
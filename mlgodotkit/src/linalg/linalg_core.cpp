@@ -0,0 +1,115 @@
+#include "linalg_core.h"
+#include "utility/thread_pool.h"
+#include <algorithm>
+
+namespace LinalgCore {
+
+template <typename SVD>
+static void thin_svd(const RowMat &m, bool compute_uv, RowMat *U, RowVec &S, RowMat *V) {
+    SVD svd(m, compute_uv ? (Eigen::ComputeThinU | Eigen::ComputeThinV) : 0);
+    S = svd.singularValues();
+    if (compute_uv) {
+        *U = svd.matrixU();
+        *V = svd.matrixV();
+    }
+}
+
+void svd(const RowMat &m, bool compute_uv, RowMat *U, RowVec &S, RowMat *V) {
+    if (std::min(m.rows(), m.cols()) > BDCSVD_THRESHOLD)
+        thin_svd<Eigen::BDCSVD<RowMat>>(m, compute_uv, U, S, V);
+    else
+        thin_svd<Eigen::JacobiSVD<RowMat>>(m, compute_uv, U, S, V);
+}
+
+RowMat pinv(const RowMat &m) {
+    RowMat U, V;
+    RowVec S;
+    svd(m, true, &U, S, &V);
+
+    float tol = 1e-6f * std::max(m.rows(), m.cols()) *
+                (S.size() > 0 ? S.array().abs().maxCoeff() : 0.0f);
+
+    RowVec inv_s = S;
+    for (int i = 0; i < inv_s.size(); ++i)
+        inv_s(i) = (inv_s(i) > tol) ? 1.0f / inv_s(i) : 0.0f;
+
+    RowMat out;
+    out.noalias() = V * inv_s.asDiagonal() * U.transpose();
+    return out;
+}
+
+void qr(const RowMat &m, bool compute_q, RowMat *Q, RowMat &R) {
+    const int k = std::min(m.rows(), m.cols());
+    Eigen::HouseholderQR<RowMat> qr(m);
+    if (compute_q)
+        *Q = qr.householderQ() * RowMat::Identity(m.rows(), k);
+    R = qr.matrixQR().topRows(k).triangularView<Eigen::Upper>();
+}
+
+bool eig(const RowMat &m, bool compute_vectors, RowVec &values, RowMat *vectors) {
+    Eigen::SelfAdjointEigenSolver<RowMat> eig(
+        m, compute_vectors ? Eigen::ComputeEigenvectors : Eigen::EigenvaluesOnly);
+    if (eig.info() != Eigen::Success)
+        return false;
+    values = eig.eigenvalues();
+    if (compute_vectors)
+        *vectors = eig.eigenvectors();
+    return true;
+}
+
+void lu(const RowMat &m, RowMat &L, RowMat &U, RowMat &P) {
+    Eigen::PartialPivLU<RowMat> lu(m);
+
+    // Eigen factors P A = L U; P is returned transposed so that A = P L U
+    L = lu.matrixLU().triangularView<Eigen::UnitLower>();
+    U = lu.matrixLU().triangularView<Eigen::Upper>();
+    P = lu.permutationP().transpose();
+}
+
+// Fixed-size kernel: everything for one system stays on the stack and the LU
+// is fully unrolled for small N.
+template <int N>
+static void solve_batched_fixed(const float *A, const float *b, float *x, int begin, int end, int k) {
+    using MatN = Eigen::Matrix<float, N, N, Eigen::RowMajor>;
+    using RhsN = Eigen::Matrix<float, N, Eigen::Dynamic, Eigen::RowMajor>;
+
+    for (int s = begin; s < end; ++s) {
+        Eigen::Map<const MatN> mA(A + s * N * N);
+        Eigen::Map<const RhsN> mb(b + s * N * k, N, k);
+        Eigen::Map<RhsN> mx(x + s * N * k, N, k);
+        Eigen::PartialPivLU<MatN> lu(mA);
+        mx.noalias() = lu.solve(mb);
+    }
+}
+
+static void solve_batched_dynamic(const float *A, const float *b, float *x, int begin, int end, int n, int k) {
+    Eigen::PartialPivLU<RowMat> lu(n);
+    for (int s = begin; s < end; ++s) {
+        Eigen::Map<const RowMat> mA(A + s * n * n, n, n);
+        Eigen::Map<const RowMat> mb(b + s * n * k, n, k);
+        Eigen::Map<RowMat> mx(x + s * n * k, n, k);
+        lu.compute(mA);
+        mx.noalias() = lu.solve(mb);
+    }
+}
+
+void solve_batched(const float *A, const float *b, float *x, int count, int n, int k) {
+    // Aim for roughly 32k flops of work per chunk before paying for a thread
+    const int min_chunk = std::max(1, 32768 / (n * n * n + 1));
+
+    ThreadPool::parallel_for(count, min_chunk, [&](int begin, int end) {
+        switch (n) {
+            case 1: solve_batched_fixed<1>(A, b, x, begin, end, k); break;
+            case 2: solve_batched_fixed<2>(A, b, x, begin, end, k); break;
+            case 3: solve_batched_fixed<3>(A, b, x, begin, end, k); break;
+            case 4: solve_batched_fixed<4>(A, b, x, begin, end, k); break;
+            case 5: solve_batched_fixed<5>(A, b, x, begin, end, k); break;
+            case 6: solve_batched_fixed<6>(A, b, x, begin, end, k); break;
+            case 7: solve_batched_fixed<7>(A, b, x, begin, end, k); break;
+            case 8: solve_batched_fixed<8>(A, b, x, begin, end, k); break;
+            default: solve_batched_dynamic(A, b, x, begin, end, n, k); break;
+        }
+    });
+}
+
+} // namespace LinalgCore
@@ -0,0 +1,35 @@
+#ifndef LINALG_CORE_H
+#define LINALG_CORE_H
+
+#include <Eigen/Dense>
+
+// Dense kernels behind Linalg, on plain Eigen types so they can be used
+// and benchmarked without the engine. Decompositions run directly on the
+// row-major storage type so every factor can be moved into a Matrix without
+// a layout conversion.
+namespace LinalgCore {
+
+    using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using RowVec = Eigen::Matrix<float, Eigen::Dynamic, 1>;
+
+    // Above this size svd()/pinv() switch from Jacobi to divide-and-conquer SVD
+    constexpr int BDCSVD_THRESHOLD = 16;
+
+    // Thin SVD; U and V may be null when compute_uv is false
+    void svd(const RowMat &m, bool compute_uv, RowMat *U, RowVec &S, RowMat *V);
+    RowMat pinv(const RowMat &m);
+
+    // Thin factors: Q is (m x k), R is (k x n); Q may be null when compute_q is false
+    void qr(const RowMat &m, bool compute_q, RowMat *Q, RowMat &R);
+    // Symmetric eigendecomposition; false if it failed
+    bool eig(const RowMat &m, bool compute_vectors, RowVec &values, RowMat *vectors);
+    // A = P L U for square A
+    void lu(const RowMat &m, RowMat &L, RowMat &U, RowMat &P);
+
+    // `count` independent n x n systems with k right-hand sides each, packed
+    // back to back in row-major order. Runs on the shared thread pool.
+    void solve_batched(const float *A, const float *b, float *x, int count, int n, int k);
+
+} // namespace LinalgCore
+
+#endif // LINALG_CORE_H
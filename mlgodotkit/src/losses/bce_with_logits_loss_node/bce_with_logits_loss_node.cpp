@@ -0,0 +1,36 @@
+#include "bce_with_logits_loss_node.h"
+#include <algorithm>
+#include <cmath>
+
+void BCEWithLogitsLossNode::_bind_methods() {}
+
+double BCEWithLogitsLossNode::compute_raw(const float *pred, const float *target, int rows, int cols,
+                                          const float *weights, float *grad_out) {
+    if (rows == 0 || cols == 0)
+        return 0.0;
+
+    const float scale = 1.0f / (static_cast<float>(rows) * cols);
+    double loss = 0.0;
+
+    for (int i = 0; i < rows; ++i) {
+        const float w = weights ? weights[i] : 1.0f;
+        const float gs = w * scale;
+        double row_loss = 0.0;
+        for (int j = 0; j < cols; ++j) {
+            const size_t k = static_cast<size_t>(i) * cols + j;
+            const float z = pred[k];
+            const float t = target[k];
+
+            // -[t log s(z) + (1 - t) log(1 - s(z))] = max(z, 0) - z t + log(1 + e^-|z|)
+            const float e = std::exp(-std::abs(z));
+            row_loss += std::max(z, 0.0f) - z * t + std::log1p(e);
+
+            if (grad_out) {
+                const float s = z >= 0.0f ? 1.0f / (1.0f + e) : e / (1.0f + e);
+                grad_out[k] = gs * (s - t);
+            }
+        }
+        loss += w * row_loss;
+    }
+    return loss * scale;
+}
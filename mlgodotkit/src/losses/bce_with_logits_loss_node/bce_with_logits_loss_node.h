@@ -0,0 +1,15 @@
+#pragma once
+
+#include "losses/loss_node/loss_node.h"
+
+// Binary cross-entropy on raw logits with the sigmoid fused in.
+// Stable for any logit magnitude; targets may be soft labels in [0, 1].
+class BCEWithLogitsLossNode : public LossNode {
+    GDCLASS(BCEWithLogitsLossNode, LossNode);
+
+protected:
+    static void _bind_methods();
+
+    double compute_raw(const float *pred, const float *target, int rows, int cols,
+                       const float *weights, float *grad_out) override;
+};
@@ -0,0 +1,48 @@
+#include "huber_loss_node.h"
+#include <cmath>
+
+void HuberLossNode::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_delta", "value"), &HuberLossNode::set_delta);
+    ClassDB::bind_method(D_METHOD("get_delta"), &HuberLossNode::get_delta);
+    ClassDB::bind_method(D_METHOD("set_smooth_l1", "enabled"), &HuberLossNode::set_smooth_l1);
+    ClassDB::bind_method(D_METHOD("get_smooth_l1"), &HuberLossNode::get_smooth_l1);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "delta",
+        PROPERTY_HINT_RANGE, "0.001,100.0,0.001,or_greater"),
+        "set_delta", "get_delta");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "smooth_l1"), "set_smooth_l1", "get_smooth_l1");
+}
+
+void HuberLossNode::set_delta(float value) {
+    delta = value > 0.0f ? value : 1.0f;
+}
+
+double HuberLossNode::compute_raw(const float *pred, const float *target, int rows, int cols,
+                                  const float *weights, float *grad_out) {
+    if (rows == 0 || cols == 0)
+        return 0.0;
+
+    // SmoothL1 is Huber scaled by 1 / delta, applied once to both loss and gradient
+    const float scale = 1.0f / (static_cast<float>(rows) * cols) / (smooth_l1 ? delta : 1.0f);
+    double loss = 0.0;
+
+    for (int i = 0; i < rows; ++i) {
+        const float w = weights ? weights[i] : 1.0f;
+        const float gs = w * scale;
+        double row_loss = 0.0;
+        for (int j = 0; j < cols; ++j) {
+            const size_t k = static_cast<size_t>(i) * cols + j;
+            const float r = pred[k] - target[k];
+            const float a = std::abs(r);
+            if (a <= delta) {
+                row_loss += 0.5 * r * r;
+                if (grad_out) grad_out[k] = gs * r;
+            } else {
+                row_loss += delta * (a - 0.5 * delta);
+                if (grad_out) grad_out[k] = gs * std::copysign(delta, r);
+            }
+        }
+        loss += w * row_loss;
+    }
+    return loss * scale;
+}
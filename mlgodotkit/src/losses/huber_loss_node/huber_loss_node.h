@@ -0,0 +1,25 @@
+#pragma once
+
+#include "losses/loss_node/loss_node.h"
+
+// Huber loss: quadratic for |r| <= delta, linear beyond it.
+// With smooth_l1 set the loss is divided by delta (PyTorch's SmoothL1Loss).
+class HuberLossNode : public LossNode {
+    GDCLASS(HuberLossNode, LossNode);
+
+private:
+    float delta = 1.0f;
+    bool smooth_l1 = false;
+
+protected:
+    static void _bind_methods();
+
+    double compute_raw(const float *pred, const float *target, int rows, int cols,
+                       const float *weights, float *grad_out) override;
+
+public:
+    void set_delta(float value);
+    float get_delta() const { return delta; }
+    void set_smooth_l1(bool enabled) { smooth_l1 = enabled; }
+    bool get_smooth_l1() const { return smooth_l1; }
+};
@@ -1,16 +1,86 @@
 #include "loss_node.h"
+#include "utility/logger.h"
+#include "utility/utils.h"
 
 void LossNode::_bind_methods() {
     ClassDB::bind_method(D_METHOD("forward", "prediction", "target"), &LossNode::forward);
     ClassDB::bind_method(D_METHOD("backward"), &LossNode::backward);
+    ClassDB::bind_method(D_METHOD("compute", "prediction", "target", "grad_out", "weights"),
+                         &LossNode::compute, DEFVAL(Ref<Matrix>()), DEFVAL(PackedFloat32Array()));
+    ClassDB::bind_method(D_METHOD("compute_packed", "prediction", "target", "cols", "grad_out", "weights"),
+                         &LossNode::compute_packed, DEFVAL(Ref<Matrix>()), DEFVAL(PackedFloat32Array()));
+}
+
+double LossNode::compute_raw(const float *, const float *, int, int, const float *, float *) {
+    ERR_PRINT("LossNode::compute_raw() not implemented.");
+    return 0.0;
 }
 
 float LossNode::forward(Array prediction, Array target) {
-    ERR_PRINT("LossNode::forward() not implemented.");
-    return 0.0f;
+    const Matrix::EigenMat pred = Utils::godot_to_eigen(prediction);
+    const Matrix::EigenMat tgt = Utils::godot_to_eigen(target);
+    ERR_FAIL_COND_V_MSG(pred.rows() != tgt.rows() || pred.cols() != tgt.cols(), 0.0f,
+                        "Prediction and target shape mismatch");
+
+    last_grad.resize(pred.rows(), pred.cols());
+    return static_cast<float>(compute_raw(pred.data(), tgt.data(), pred.rows(), pred.cols(),
+                                          nullptr, last_grad.data()));
 }
 
 Array LossNode::backward() {
-    ERR_PRINT("LossNode::backward() not implemented.");
-    return Array();
-}
\ No newline at end of file
+    return Utils::eigen_to_godot(last_grad);
+}
+
+float LossNode::compute(const Ref<Matrix> &prediction, const Ref<Matrix> &target,
+                        const Ref<Matrix> &grad_out, const PackedFloat32Array &weights) {
+    if (prediction.is_null() || target.is_null() ||
+        prediction->rows() != target->rows() || prediction->cols() != target->cols()) {
+        Logger::error_raise("LossNode.compute(): prediction and target shape mismatch");
+        return 0.0f;
+    }
+    const int rows = prediction->rows();
+    const int cols = prediction->cols();
+    if (!weights.is_empty() && weights.size() != rows) {
+        Logger::error_raise("LossNode.compute(): need one weight per row");
+        return 0.0f;
+    }
+
+    // Read the inputs before grad_out is resized, in case it aliases one of them
+    const float *p = static_cast<const Matrix *>(prediction.ptr())->eigen().data();
+    const float *t = static_cast<const Matrix *>(target.ptr())->eigen().data();
+    float *g = nullptr;
+    if (grad_out.is_valid()) {
+        if (grad_out->rows() != rows || grad_out->cols() != cols) {
+            if (grad_out == prediction || grad_out == target) {
+                Logger::error_raise("LossNode.compute(): aliased grad_out must match the input shape");
+                return 0.0f;
+            }
+            grad_out->eigen().resize(rows, cols);
+        }
+        g = grad_out->eigen().data();
+    }
+
+    return static_cast<float>(compute_raw(p, t, rows, cols,
+                                          weights.is_empty() ? nullptr : weights.ptr(), g));
+}
+
+float LossNode::compute_packed(const PackedFloat32Array &prediction, const PackedFloat32Array &target, int cols,
+                               const Ref<Matrix> &grad_out, const PackedFloat32Array &weights) {
+    if (cols < 1 || prediction.size() != target.size() || prediction.size() % cols != 0) {
+        Logger::error_raise("LossNode.compute_packed(): size mismatch");
+        return 0.0f;
+    }
+    const int rows = prediction.size() / cols;
+    if (!weights.is_empty() && weights.size() != rows) {
+        Logger::error_raise("LossNode.compute_packed(): need one weight per row");
+        return 0.0f;
+    }
+
+    float *g = nullptr;
+    if (grad_out.is_valid()) {
+        grad_out->eigen().resize(rows, cols);
+        g = grad_out->eigen().data();
+    }
+    return static_cast<float>(compute_raw(prediction.ptr(), target.ptr(), rows, cols,
+                                          weights.is_empty() ? nullptr : weights.ptr(), g));
+}
@@ -3,6 +3,9 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <Eigen/Dense>
+#include "matrix/matrix.h"
 
 using namespace godot;
 
@@ -10,9 +13,29 @@ class LossNode : public RefCounted {
     GDCLASS(LossNode, RefCounted);
 
 protected:
+    // Gradient of the last Array forward(), returned by backward()
+    Matrix::EigenMat last_grad;
+
     static void _bind_methods();
 
+    // Fused forward + gradient over row-major (rows x cols) buffers.
+    // weights is null or one weight per row; grad is null or rows x cols and
+    // may alias pred. Returns the weighted mean loss.
+    virtual double compute_raw(const float *pred, const float *target, int rows, int cols,
+                               const float *weights, float *grad_out);
+
 public:
+    // Native entry point for trainers; same contract as compute_raw()
+    double evaluate(const float *pred, const float *target, int rows, int cols,
+                    const float *weights, float *grad_out) {
+        return compute_raw(pred, target, rows, cols, weights, grad_out);
+    }
+
     virtual float forward(Array prediction, Array target);
     virtual Array backward();
-};
\ No newline at end of file
+
+    float compute(const Ref<Matrix> &prediction, const Ref<Matrix> &target,
+                  const Ref<Matrix> &grad_out, const PackedFloat32Array &weights);
+    float compute_packed(const PackedFloat32Array &prediction, const PackedFloat32Array &target, int cols,
+                         const Ref<Matrix> &grad_out, const PackedFloat32Array &weights);
+};
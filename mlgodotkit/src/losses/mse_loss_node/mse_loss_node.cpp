@@ -26,4 +26,26 @@ float MSELossNode::forward(Array prediction, Array target) {
 
 Array MSELossNode::backward() {
     return eigen_to_godot(grad);
+}
+
+double MSELossNode::compute_raw(const float *pred, const float *target, int rows, int cols,
+                                const float *weights, float *grad_out) {
+    if (rows == 0 || cols == 0)
+        return 0.0;
+
+    const float scale = 1.0f / (static_cast<float>(rows) * cols);
+    double loss = 0.0;
+
+    for (int i = 0; i < rows; ++i) {
+        const float w = weights ? weights[i] : 1.0f;
+        double row_loss = 0.0;
+        for (int j = 0; j < cols; ++j) {
+            const size_t k = static_cast<size_t>(i) * cols + j;
+            const float r = pred[k] - target[k];
+            row_loss += r * r;
+            if (grad_out) grad_out[k] = 2.0f * w * scale * r;
+        }
+        loss += w * row_loss;
+    }
+    return loss * scale;
 }
\ No newline at end of file
@@ -13,6 +13,9 @@ private:
 protected:
     static void _bind_methods();
 
+    double compute_raw(const float *pred, const float *target, int rows, int cols,
+                       const float *weights, float *grad_out) override;
+
 public:
     float forward(godot::Array prediction, godot::Array target) override;
     godot::Array backward() override;
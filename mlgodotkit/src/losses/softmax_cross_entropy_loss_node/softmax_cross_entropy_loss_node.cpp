@@ -0,0 +1,109 @@
+#include "softmax_cross_entropy_loss_node.h"
+#include "utility/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    // log(sum(exp(z))) of one row, shifted by its max so exp never overflows
+    inline float log_sum_exp(const float *z, int cols) {
+        float zmax = z[0];
+        for (int j = 1; j < cols; ++j)
+            zmax = std::max(zmax, z[j]);
+        float sum = 0.0f;
+        for (int j = 0; j < cols; ++j)
+            sum += std::exp(z[j] - zmax);
+        return zmax + std::log(sum);
+    }
+
+} // namespace
+
+void SoftmaxCrossEntropyLossNode::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("compute_labels", "logits", "labels", "grad_out", "weights"),
+                         &SoftmaxCrossEntropyLossNode::compute_labels,
+                         DEFVAL(Ref<Matrix>()), DEFVAL(PackedFloat32Array()));
+}
+
+double SoftmaxCrossEntropyLossNode::compute_raw(const float *pred, const float *target, int rows, int cols,
+                                                const float *weights, float *grad_out) {
+    if (rows == 0 || cols == 0)
+        return 0.0;
+
+    const float scale = 1.0f / rows;
+    double loss = 0.0;
+
+    for (int i = 0; i < rows; ++i) {
+        const float *z = pred + static_cast<size_t>(i) * cols;
+        const float *t = target + static_cast<size_t>(i) * cols;
+        const float w = weights ? weights[i] : 1.0f;
+        const float lse = log_sum_exp(z, cols);
+
+        // sum_j t_j (lse - z_j); the gradient is softmax(z) * sum(t) - t
+        float t_sum = 0.0f;
+        double row_loss = 0.0;
+        for (int j = 0; j < cols; ++j) {
+            t_sum += t[j];
+            row_loss += t[j] * (lse - z[j]);
+        }
+        loss += w * row_loss;
+
+        if (grad_out) {
+            float *g = grad_out + static_cast<size_t>(i) * cols;
+            const float gs = w * scale;
+            for (int j = 0; j < cols; ++j)
+                g[j] = gs * (std::exp(z[j] - lse) * t_sum - t[j]);
+        }
+    }
+    return loss * scale;
+}
+
+float SoftmaxCrossEntropyLossNode::compute_labels(const Ref<Matrix> &logits, const PackedInt32Array &labels,
+                                                  const Ref<Matrix> &grad_out, const PackedFloat32Array &weights) {
+    if (logits.is_null() || logits->rows() != labels.size()) {
+        Logger::error_raise("SoftmaxCrossEntropyLossNode.compute_labels(): need one label per row");
+        return 0.0f;
+    }
+    const int rows = logits->rows();
+    const int cols = logits->cols();
+    if (!weights.is_empty() && weights.size() != rows) {
+        Logger::error_raise("SoftmaxCrossEntropyLossNode.compute_labels(): need one weight per row");
+        return 0.0f;
+    }
+    const int32_t *y = labels.ptr();
+    for (int i = 0; i < rows; ++i) {
+        if (y[i] < 0 || y[i] >= cols) {
+            Logger::error_raise("SoftmaxCrossEntropyLossNode.compute_labels(): label out of range");
+            return 0.0f;
+        }
+    }
+    if (rows == 0)
+        return 0.0f;
+
+    float *g = nullptr;
+    if (grad_out.is_valid()) {
+        if (grad_out != logits)
+            grad_out->eigen().resize(rows, cols);
+        g = grad_out->eigen().data();
+    }
+
+    const float *p = static_cast<const Matrix *>(logits.ptr())->eigen().data();
+    const float *w = weights.is_empty() ? nullptr : weights.ptr();
+    const float scale = 1.0f / rows;
+    double loss = 0.0;
+
+    for (int i = 0; i < rows; ++i) {
+        const float *z = p + static_cast<size_t>(i) * cols;
+        const float wi = w ? w[i] : 1.0f;
+        const float lse = log_sum_exp(z, cols);
+        loss += wi * (lse - z[y[i]]);
+
+        if (g) {
+            float *gi = g + static_cast<size_t>(i) * cols;
+            const float gs = wi * scale;
+            for (int j = 0; j < cols; ++j)
+                gi[j] = gs * std::exp(z[j] - lse);
+            gi[y[i]] -= gs;
+        }
+    }
+    return static_cast<float>(loss * scale);
+}
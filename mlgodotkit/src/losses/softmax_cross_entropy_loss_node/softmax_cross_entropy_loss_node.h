@@ -0,0 +1,21 @@
+#pragma once
+
+#include "losses/loss_node/loss_node.h"
+#include <godot_cpp/variant/packed_int32_array.hpp>
+
+// Softmax + cross-entropy over each row of logits, fused through log-sum-exp.
+// Targets are per-row class distributions (one-hot or soft); compute_labels()
+// takes class indices instead.
+class SoftmaxCrossEntropyLossNode : public LossNode {
+    GDCLASS(SoftmaxCrossEntropyLossNode, LossNode);
+
+protected:
+    static void _bind_methods();
+
+    double compute_raw(const float *pred, const float *target, int rows, int cols,
+                       const float *weights, float *grad_out) override;
+
+public:
+    float compute_labels(const Ref<Matrix> &logits, const PackedInt32Array &labels,
+                         const Ref<Matrix> &grad_out, const PackedFloat32Array &weights);
+};
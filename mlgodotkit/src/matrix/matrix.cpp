@@ -1,6 +1,8 @@
 #include "matrix.h"
+#include "matrix_view.h"
 #include "utility/logger.h"
 #include "utility/utils.h"
+#include "utility/npy.h"
 #include <godot_cpp/core/class_db.hpp>
 
 namespace godot {
@@ -14,6 +16,8 @@ void Matrix::_bind_methods() {
     ClassDB::bind_static_method("Matrix", D_METHOD("from_vector2", "v", "column"), &Matrix::from_vector2, DEFVAL(true));
     ClassDB::bind_static_method("Matrix", D_METHOD("from_vector3", "v", "column"), &Matrix::from_vector3, DEFVAL(true));
     ClassDB::bind_static_method("Matrix", D_METHOD("from_vector4", "v", "column"), &Matrix::from_vector4, DEFVAL(true));
+    ClassDB::bind_static_method("Matrix", D_METHOD("load_npy", "path"), &Matrix::load_npy);
+    ClassDB::bind_static_method("Matrix", D_METHOD("load_npz", "path"), &Matrix::load_npz);
 
     ClassDB::bind_method(D_METHOD("to_vector2"), &Matrix::to_vector2);
     ClassDB::bind_method(D_METHOD("to_vector3"), &Matrix::to_vector3);
@@ -38,6 +42,10 @@ void Matrix::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get", "i", "j"), &Matrix::get);
     ClassDB::bind_method(D_METHOD("set", "i", "j", "value"), &Matrix::set);
 
+    ClassDB::bind_method(D_METHOD("row_view", "i"), &Matrix::row_view);
+    ClassDB::bind_method(D_METHOD("col_view", "j"), &Matrix::col_view);
+    ClassDB::bind_method(D_METHOD("block", "r", "c", "h", "w"), &Matrix::block);
+
     ClassDB::bind_method(D_METHOD("copy"), &Matrix::copy);
     ClassDB::bind_method(D_METHOD("equals", "other", "eps"), &Matrix::equals);
     ClassDB::bind_method(D_METHOD("info"), &Matrix::info);
@@ -72,6 +80,67 @@ Ref<Matrix> Matrix::from_array(const Array &A) {
     return out;
 }
 
+Ref<Matrix> Matrix::from_eigen(EigenMat &&data) {
+    Ref<Matrix> out = memnew(Matrix());
+    out->m = std::move(data);
+    return out;
+}
+
+namespace {
+
+// One copy from the (mapped) file straight into the matrix storage
+Ref<Matrix> matrix_from_npy(const Npy::ArrayView &a, const std::string &where) {
+    int rows = 0, cols = 0;
+    if (!a.matrix_shape(rows, cols)) {
+        Logger::error_raise(where + ": expected a 1-D or 2-D array, got shape " + a.shape_string());
+        return Ref<Matrix>();
+    }
+    Matrix::EigenMat data(rows, cols);
+    Npy::copy_row_major(a, rows, cols, data.data());
+    return Matrix::from_eigen(std::move(data));
+}
+
+} // namespace
+
+Ref<Matrix> Matrix::load_npy(const String &path) {
+    const std::string where = std::string("Matrix.load_npy(") + path.utf8().get_data() + ")";
+    const std::shared_ptr<const MappedFile> file = Utils::map_file(path);
+    if (!file) {
+        Logger::error_raise(where + ": could not open file");
+        return Ref<Matrix>();
+    }
+    Npy::ArrayView a;
+    const std::string problem = Npy::parse_npy(file->data(), file->size(), a);
+    if (!problem.empty()) {
+        Logger::error_raise(where + ": " + problem);
+        return Ref<Matrix>();
+    }
+    return matrix_from_npy(a, where);
+}
+
+Dictionary Matrix::load_npz(const String &path) {
+    const std::string where = std::string("Matrix.load_npz(") + path.utf8().get_data() + ")";
+    Dictionary out;
+    const std::shared_ptr<const MappedFile> file = Utils::map_file(path);
+    if (!file) {
+        Logger::error_raise(where + ": could not open file");
+        return out;
+    }
+    Npy::Archive archive;
+    const std::string problem = Npy::parse_npz(file->data(), file->size(), archive);
+    if (!problem.empty()) {
+        Logger::error_raise(where + ": " + problem);
+        return out;
+    }
+    for (const auto &member : archive) {
+        Ref<Matrix> m = matrix_from_npy(member.second, where + " '" + member.first + "'");
+        if (m.is_null())
+            return Dictionary();
+        out[String(member.first.c_str())] = m;
+    }
+    return out;
+}
+
 Ref<Matrix> Matrix::from_vector2(const Vector2 &v, bool column) {
     Ref<Matrix> out = memnew(Matrix());
     out->m = column ? Eigen::MatrixXf(2,1) : Eigen::MatrixXf(1,2);
@@ -176,6 +245,18 @@ float Matrix::norm() const { return m.norm(); }
 float Matrix::get(int i, int j) const { return m(i, j); }
 void Matrix::set(int i, int j, float value) { m(i, j) = value; }
 
+Ref<MatrixView> Matrix::row_view(int i) {
+    return MatrixView::create(Ref<Matrix>(this), i, 0, 1, m.cols());
+}
+
+Ref<MatrixView> Matrix::col_view(int j) {
+    return MatrixView::create(Ref<Matrix>(this), 0, j, m.rows(), 1);
+}
+
+Ref<MatrixView> Matrix::block(int r, int c, int h, int w) {
+    return MatrixView::create(Ref<Matrix>(this), r, c, h, w);
+}
+
 Ref<Matrix> Matrix::copy() const {
     Ref<Matrix> out = memnew(Matrix());
     out->m = m;
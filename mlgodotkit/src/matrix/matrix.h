@@ -12,6 +12,8 @@
 
 namespace godot {
 
+    class MatrixView;
+
     class Matrix : public RefCounted {
         GDCLASS(Matrix, RefCounted);
 
@@ -34,6 +36,10 @@ namespace godot {
         static Ref<Matrix> from_vector3(const Vector3 &v, bool column = true);
         static Ref<Matrix> from_vector4(const Vector4 &v, bool column = true);
 
+        // NumPy float32 files; 1-D arrays load as a column
+        static Ref<Matrix> load_npy(const String &path);
+        static Dictionary load_npz(const String &path);
+
         Array to_array() const;
 
         Vector2 to_vector2() const;
@@ -58,6 +64,10 @@ namespace godot {
         float get(int i, int j) const;
         void set(int i, int j, float value);
 
+        Ref<MatrixView> row_view(int i);
+        Ref<MatrixView> col_view(int j);
+        Ref<MatrixView> block(int r, int c, int h, int w);
+
         Ref<Matrix> copy() const;
         bool equals(const Ref<Matrix> &other, float eps = 1e-6f) const;
         Dictionary info() const;
@@ -67,6 +77,9 @@ namespace godot {
         using EigenMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
         const EigenMat &eigen() const { return m; }
         EigenMat &eigen() { return m; }
+
+        // Adopt an existing buffer without copying (C++ only)
+        static Ref<Matrix> from_eigen(EigenMat &&data);
     };
 
 } // namespace godot
@@ -0,0 +1,141 @@
+#include "matrix_view.h"
+#include "utility/logger.h"
+#include "utility/utils.h"
+#include <godot_cpp/core/class_db.hpp>
+
+namespace godot {
+
+void MatrixView::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("rows"), &MatrixView::rows);
+    ClassDB::bind_method(D_METHOD("cols"), &MatrixView::cols);
+    ClassDB::bind_method(D_METHOD("get_row_offset"), &MatrixView::get_row_offset);
+    ClassDB::bind_method(D_METHOD("get_col_offset"), &MatrixView::get_col_offset);
+    ClassDB::bind_method(D_METHOD("get_parent"), &MatrixView::get_parent);
+
+    ClassDB::bind_method(D_METHOD("get", "i", "j"), &MatrixView::get);
+    ClassDB::bind_method(D_METHOD("set", "i", "j", "value"), &MatrixView::set);
+    ClassDB::bind_method(D_METHOD("fill", "value"), &MatrixView::fill);
+    ClassDB::bind_method(D_METHOD("assign", "src"), &MatrixView::assign);
+
+    ClassDB::bind_method(D_METHOD("to_matrix"), &MatrixView::to_matrix);
+    ClassDB::bind_method(D_METHOD("to_array"), &MatrixView::to_array);
+    ClassDB::bind_method(D_METHOD("matmul", "B"), &MatrixView::matmul);
+    ClassDB::bind_method(D_METHOD("sum"), &MatrixView::sum);
+    ClassDB::bind_method(D_METHOD("norm"), &MatrixView::norm);
+
+    ClassDB::bind_method(D_METHOD("is_valid"), &MatrixView::is_valid);
+    ClassDB::bind_method(D_METHOD("_to_string"), &MatrixView::_to_string);
+}
+
+MatrixView::MatrixView() {}
+
+Ref<MatrixView> MatrixView::create(const Ref<Matrix> &parent, int r, int c, int h, int w) {
+    if (parent.is_null()) {
+        Logger::error_raise("MatrixView: null parent");
+        return Ref<MatrixView>();
+    }
+    if (r < 0 || c < 0 || h < 0 || w < 0 ||
+        r + h > parent->rows() || c + w > parent->cols()) {
+        Logger::error_raise("MatrixView: block out of bounds");
+        return Ref<MatrixView>();
+    }
+
+    Ref<MatrixView> out = memnew(MatrixView());
+    out->parent = parent;
+    out->row_offset = r;
+    out->col_offset = c;
+    out->n_rows = h;
+    out->n_cols = w;
+    return out;
+}
+
+bool MatrixView::is_valid() const {
+    return parent.is_valid() &&
+           row_offset + n_rows <= parent->rows() &&
+           col_offset + n_cols <= parent->cols();
+}
+
+MatrixView::EigenMap MatrixView::eigen() {
+    if (!is_valid())
+        return EigenMap(nullptr, 0, 0, Stride(1));
+    auto &pm = parent->eigen();
+    return EigenMap(pm.data() + Eigen::Index(row_offset) * pm.cols() + col_offset,
+                    n_rows, n_cols, Stride(pm.cols()));
+}
+
+MatrixView::ConstEigenMap MatrixView::eigen() const {
+    if (!is_valid())
+        return ConstEigenMap(nullptr, 0, 0, Stride(1));
+    const auto &pm = static_cast<const Matrix *>(parent.ptr())->eigen();
+    return ConstEigenMap(pm.data() + Eigen::Index(row_offset) * pm.cols() + col_offset,
+                         n_rows, n_cols, Stride(pm.cols()));
+}
+
+int MatrixView::rows() const { return n_rows; }
+int MatrixView::cols() const { return n_cols; }
+
+float MatrixView::get(int i, int j) const {
+    if (!is_valid() || i < 0 || j < 0 || i >= n_rows || j >= n_cols) {
+        Logger::error_raise("MatrixView.get(): index out of bounds");
+        return 0.0f;
+    }
+    return eigen()(i, j);
+}
+
+void MatrixView::set(int i, int j, float value) {
+    if (!is_valid() || i < 0 || j < 0 || i >= n_rows || j >= n_cols) {
+        Logger::error_raise("MatrixView.set(): index out of bounds");
+        return;
+    }
+    eigen()(i, j) = value;
+}
+
+void MatrixView::fill(float value) {
+    if (!is_valid()) {
+        Logger::error_raise("MatrixView.fill(): view no longer fits its parent");
+        return;
+    }
+    eigen().setConstant(value);
+}
+
+void MatrixView::assign(const Ref<Matrix> &src) {
+    if (!is_valid()) {
+        Logger::error_raise("MatrixView.assign(): view no longer fits its parent");
+        return;
+    }
+    if (src.is_null() || src->rows() != n_rows || src->cols() != n_cols) {
+        Logger::error_raise("MatrixView.assign(): shape mismatch");
+        return;
+    }
+    eigen() = src->eigen();
+}
+
+Ref<Matrix> MatrixView::to_matrix() const {
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen() = eigen();
+    return out;
+}
+
+Array MatrixView::to_array() const {
+    return Utils::eigen_to_godot(eigen());
+}
+
+Ref<Matrix> MatrixView::matmul(const Ref<Matrix> &B) const {
+    if (B.is_null() || B->rows() != n_cols) {
+        Logger::error_raise("MatrixView.matmul(): dimension mismatch");
+        return Ref<Matrix>();
+    }
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen().noalias() = eigen() * B->eigen();
+    return out;
+}
+
+float MatrixView::sum() const { return eigen().sum(); }
+float MatrixView::norm() const { return eigen().norm(); }
+
+String MatrixView::_to_string() const {
+    return "MatrixView(" + itos(n_rows) + "x" + itos(n_cols) +
+           " @ " + itos(row_offset) + "," + itos(col_offset) + ")";
+}
+
+} // namespace godot
@@ -0,0 +1,64 @@
+#ifndef MATRIX_VIEW_H
+#define MATRIX_VIEW_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include "matrix/matrix.h"
+
+namespace godot {
+
+    // Non-owning rectangular window into a parent Matrix.
+    // The parent is kept alive through its Ref; reads and writes go straight
+    // to the parent's storage.
+    class MatrixView : public RefCounted {
+        GDCLASS(MatrixView, RefCounted);
+
+    private:
+        Ref<Matrix> parent;
+        int row_offset = 0;
+        int col_offset = 0;
+        int n_rows = 0;
+        int n_cols = 0;
+
+    protected:
+        static void _bind_methods();
+
+    public:
+        MatrixView();
+
+        static Ref<MatrixView> create(const Ref<Matrix> &parent, int r, int c, int h, int w);
+
+        int rows() const;
+        int cols() const;
+        int get_row_offset() const { return row_offset; }
+        int get_col_offset() const { return col_offset; }
+        Ref<Matrix> get_parent() const { return parent; }
+
+        float get(int i, int j) const;
+        void set(int i, int j, float value);
+        void fill(float value);
+        void assign(const Ref<Matrix> &src);
+
+        Ref<Matrix> to_matrix() const;
+        Array to_array() const;
+        Ref<Matrix> matmul(const Ref<Matrix> &B) const;
+        float sum() const;
+        float norm() const;
+
+        String _to_string() const;
+
+        // Strided map over the parent's row-major buffer. Rebuilt on every
+        // call so a parent that was reallocated is never read through a stale pointer.
+        using Stride = Eigen::OuterStride<>;
+        using EigenMap = Eigen::Map<Matrix::EigenMat, Eigen::Unaligned, Stride>;
+        using ConstEigenMap = Eigen::Map<const Matrix::EigenMat, Eigen::Unaligned, Stride>;
+
+        bool is_valid() const;
+        EigenMap eigen();
+        ConstEigenMap eigen() const;
+    };
+
+} // namespace godot
+
+#endif
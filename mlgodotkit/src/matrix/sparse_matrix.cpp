@@ -0,0 +1,204 @@
+#include "sparse_matrix.h"
+#include "utility/logger.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace godot {
+
+void SparseMatrix::_bind_methods() {
+    ClassDB::bind_static_method("SparseMatrix", D_METHOD("from_triplets", "rows", "cols", "row_idx", "col_idx", "values"), &SparseMatrix::from_triplets);
+    ClassDB::bind_static_method("SparseMatrix", D_METHOD("from_csr", "rows", "cols", "indptr", "indices", "data"), &SparseMatrix::from_csr);
+    ClassDB::bind_static_method("SparseMatrix", D_METHOD("from_dense", "A", "tol"), &SparseMatrix::from_dense, DEFVAL(0.0f));
+    ClassDB::bind_static_method("SparseMatrix", D_METHOD("identity", "n"), &SparseMatrix::identity);
+
+    ClassDB::bind_method(D_METHOD("rows"), &SparseMatrix::rows);
+    ClassDB::bind_method(D_METHOD("cols"), &SparseMatrix::cols);
+    ClassDB::bind_method(D_METHOD("nnz"), &SparseMatrix::nnz);
+    ClassDB::bind_method(D_METHOD("get", "i", "j"), &SparseMatrix::get);
+
+    ClassDB::bind_method(D_METHOD("matmul", "B"), &SparseMatrix::matmul);
+    ClassDB::bind_method(D_METHOD("matmul_sparse", "B"), &SparseMatrix::matmul_sparse);
+    ClassDB::bind_method(D_METHOD("transpose"), &SparseMatrix::transpose);
+    ClassDB::bind_method(D_METHOD("to_dense"), &SparseMatrix::to_dense);
+    ClassDB::bind_method(D_METHOD("to_csr"), &SparseMatrix::to_csr);
+
+    ClassDB::bind_method(D_METHOD("info"), &SparseMatrix::info);
+    ClassDB::bind_method(D_METHOD("_to_string"), &SparseMatrix::_to_string);
+}
+
+SparseMatrix::SparseMatrix() {}
+
+Ref<SparseMatrix> SparseMatrix::from_triplets(int rows, int cols,
+                                              const PackedInt32Array &row_idx,
+                                              const PackedInt32Array &col_idx,
+                                              const PackedFloat32Array &values) {
+    const int64_t n = values.size();
+    if (rows < 0 || cols < 0 || row_idx.size() != n || col_idx.size() != n) {
+        Logger::error_raise("SparseMatrix.from_triplets(): array length mismatch");
+        return Ref<SparseMatrix>();
+    }
+
+    const int32_t *ri = row_idx.ptr();
+    const int32_t *ci = col_idx.ptr();
+    const float *v = values.ptr();
+
+    std::vector<Eigen::Triplet<float, int>> triplets;
+    triplets.reserve(n);
+    for (int64_t k = 0; k < n; ++k) {
+        if (ri[k] < 0 || ri[k] >= rows || ci[k] < 0 || ci[k] >= cols) {
+            Logger::error_raise("SparseMatrix.from_triplets(): index out of bounds");
+            return Ref<SparseMatrix>();
+        }
+        triplets.emplace_back(ri[k], ci[k], v[k]);
+    }
+
+    // Duplicate entries are summed, matching scipy's coo -> csr conversion
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m.resize(rows, cols);
+    out->m.setFromTriplets(triplets.begin(), triplets.end());
+    return out;
+}
+
+Ref<SparseMatrix> SparseMatrix::from_csr(int rows, int cols,
+                                         const PackedInt32Array &indptr,
+                                         const PackedInt32Array &indices,
+                                         const PackedFloat32Array &data) {
+    if (rows < 0 || cols < 0 || indptr.size() != rows + 1 || indices.size() != data.size()) {
+        Logger::error_raise("SparseMatrix.from_csr(): array length mismatch");
+        return Ref<SparseMatrix>();
+    }
+
+    const int32_t *p = indptr.ptr();
+    if (p[0] != 0 || p[rows] != indices.size()) {
+        Logger::error_raise("SparseMatrix.from_csr(): malformed indptr");
+        return Ref<SparseMatrix>();
+    }
+    for (int i = 0; i < rows; ++i) {
+        if (p[i + 1] < p[i]) {
+            Logger::error_raise("SparseMatrix.from_csr(): indptr must be non-decreasing");
+            return Ref<SparseMatrix>();
+        }
+    }
+    const int32_t *idx = indices.ptr();
+    for (int64_t k = 0; k < indices.size(); ++k) {
+        if (idx[k] < 0 || idx[k] >= cols) {
+            Logger::error_raise("SparseMatrix.from_csr(): column index out of bounds");
+            return Ref<SparseMatrix>();
+        }
+    }
+
+    // Go through triplets so unsorted column indices and duplicates are
+    // normalized the same way as from_triplets()
+    const float *v = data.ptr();
+    std::vector<Eigen::Triplet<float, int>> triplets;
+    triplets.reserve(indices.size());
+    for (int i = 0; i < rows; ++i)
+        for (int k = p[i]; k < p[i + 1]; ++k)
+            triplets.emplace_back(i, idx[k], v[k]);
+
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m.resize(rows, cols);
+    out->m.setFromTriplets(triplets.begin(), triplets.end());
+    return out;
+}
+
+Ref<SparseMatrix> SparseMatrix::from_dense(const Ref<Matrix> &A, float tol) {
+    if (A.is_null()) {
+        Logger::error_raise("SparseMatrix.from_dense(): null input");
+        return Ref<SparseMatrix>();
+    }
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m = A->eigen().sparseView(1.0f, tol);
+    return out;
+}
+
+Ref<SparseMatrix> SparseMatrix::identity(int n) {
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m.resize(n, n);
+    out->m.setIdentity();
+    return out;
+}
+
+int SparseMatrix::rows() const { return m.rows(); }
+int SparseMatrix::cols() const { return m.cols(); }
+int SparseMatrix::nnz() const { return m.nonZeros(); }
+
+float SparseMatrix::get(int i, int j) const {
+    if (i < 0 || j < 0 || i >= m.rows() || j >= m.cols()) {
+        Logger::error_raise("SparseMatrix.get(): index out of bounds");
+        return 0.0f;
+    }
+    return m.coeff(i, j);
+}
+
+Ref<Matrix> SparseMatrix::matmul(const Ref<Matrix> &B) const {
+    if (B.is_null() || B->rows() != m.cols()) {
+        Logger::error_raise("SparseMatrix.matmul(): dimension mismatch");
+        return Ref<Matrix>();
+    }
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen().noalias() = m * B->eigen();
+    return out;
+}
+
+Ref<SparseMatrix> SparseMatrix::matmul_sparse(const Ref<SparseMatrix> &B) const {
+    if (B.is_null() || B->m.rows() != m.cols()) {
+        Logger::error_raise("SparseMatrix.matmul_sparse(): dimension mismatch");
+        return Ref<SparseMatrix>();
+    }
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m = m * B->m;
+    return out;
+}
+
+Ref<SparseMatrix> SparseMatrix::transpose() const {
+    Ref<SparseMatrix> out = memnew(SparseMatrix());
+    out->m = m.transpose();
+    return out;
+}
+
+Ref<Matrix> SparseMatrix::to_dense() const {
+    Ref<Matrix> out = memnew(Matrix());
+    out->eigen() = Matrix::EigenMat(m);
+    return out;
+}
+
+Dictionary SparseMatrix::to_csr() const {
+    EigenSparse c = m;
+    c.makeCompressed();
+
+    PackedInt32Array indptr;
+    PackedInt32Array indices;
+    PackedFloat32Array data;
+    indptr.resize(c.rows() + 1);
+    indices.resize(c.nonZeros());
+    data.resize(c.nonZeros());
+
+    std::copy(c.outerIndexPtr(), c.outerIndexPtr() + c.rows() + 1, indptr.ptrw());
+    std::copy(c.innerIndexPtr(), c.innerIndexPtr() + c.nonZeros(), indices.ptrw());
+    std::copy(c.valuePtr(), c.valuePtr() + c.nonZeros(), data.ptrw());
+
+    Dictionary d;
+    d["indptr"] = indptr;
+    d["indices"] = indices;
+    d["data"] = data;
+    return d;
+}
+
+Dictionary SparseMatrix::info() const {
+    Dictionary d;
+    d["rows"] = m.rows();
+    d["cols"] = m.cols();
+    d["nnz"] = m.nonZeros();
+    const double total = double(m.rows()) * double(m.cols());
+    d["density"] = total > 0.0 ? double(m.nonZeros()) / total : 0.0;
+    return d;
+}
+
+String SparseMatrix::_to_string() const {
+    return "SparseMatrix(" + itos(m.rows()) + "x" + itos(m.cols()) +
+           ", nnz=" + itos(m.nonZeros()) + ")";
+}
+
+} // namespace godot
@@ -0,0 +1,63 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/string.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <Eigen/Sparse>
+#include "matrix/matrix.h"
+
+namespace godot {
+
+    // Compressed sparse row (CSR) matrix for large, mostly-zero systems.
+    class SparseMatrix : public RefCounted {
+        GDCLASS(SparseMatrix, RefCounted);
+
+    public:
+        using EigenSparse = Eigen::SparseMatrix<float, Eigen::RowMajor, int>;
+
+    private:
+        EigenSparse m;
+
+    protected:
+        static void _bind_methods();
+
+    public:
+        SparseMatrix();
+
+        static Ref<SparseMatrix> from_triplets(int rows, int cols,
+                                               const PackedInt32Array &row_idx,
+                                               const PackedInt32Array &col_idx,
+                                               const PackedFloat32Array &values);
+        static Ref<SparseMatrix> from_csr(int rows, int cols,
+                                          const PackedInt32Array &indptr,
+                                          const PackedInt32Array &indices,
+                                          const PackedFloat32Array &data);
+        static Ref<SparseMatrix> from_dense(const Ref<Matrix> &A, float tol = 0.0f);
+        static Ref<SparseMatrix> identity(int n);
+
+        int rows() const;
+        int cols() const;
+        int nnz() const;
+
+        float get(int i, int j) const;
+
+        Ref<Matrix> matmul(const Ref<Matrix> &B) const;
+        Ref<SparseMatrix> matmul_sparse(const Ref<SparseMatrix> &B) const;
+        Ref<SparseMatrix> transpose() const;
+        Ref<Matrix> to_dense() const;
+        Dictionary to_csr() const;
+
+        Dictionary info() const;
+        String _to_string() const;
+
+        const EigenSparse &eigen() const { return m; }
+        EigenSparse &eigen() { return m; }
+    };
+
+} // namespace godot
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef DECISION_TREE_H
+#define DECISION_TREE_H
+
+#include <Eigen/Dense>
+
+// Classification tree (Gini impurity) on plain Eigen data, with no Godot
+// dependency. DecisionTreeNode wraps it for scripts and validates settings.
+class DecisionTree {
+private:
+    struct SplitData {
+        Eigen::MatrixXf left_X, right_X;
+        Eigen::VectorXf left_y, right_y;
+    };
+  
+    struct SubNode {
+        int feature_idx;
+        float threshold;
+        SubNode* left;
+        SubNode* right;
+        int value;
+        bool is_leaf;
+
+        SubNode() : left(nullptr), right(nullptr), is_leaf(false), value(-1) {}
+    };
+
+    SubNode* root = nullptr;
+    int max_depth = 10;
+    int min_samples_split = 2;
+
+    // Recursively build the tree
+    SubNode* buildTree(const Eigen::MatrixXf& X,
+                    const Eigen::VectorXf& y,
+                    int depth);
+
+    // Find best feature to split on
+    void findBestSplit(const Eigen::MatrixXf& X,
+                       const Eigen::VectorXf& y,
+                       int& best_feature,
+                       float& best_threshold);
+
+    SplitData splitData(const Eigen::MatrixXf& X,
+                        const Eigen::VectorXf& y,
+                        int feature_idx, float threshold);
+
+    float calculateImpurity(const Eigen::VectorXf& y);
+
+    int computeLeafValue(const Eigen::VectorXf& y);
+
+    int predictRecursive(SubNode* node, const Eigen::VectorXf& sample) const;
+
+    void freeTree(SubNode* node);
+
+
+public:
+    DecisionTree() = default;
+    ~DecisionTree();
+    DecisionTree(const DecisionTree&) = delete;
+    DecisionTree& operator=(const DecisionTree&) = delete;
+
+    // Replaces any previously fitted tree
+    void fit(const Eigen::MatrixXf& X, const Eigen::VectorXf& y);
+    bool is_fitted() const { return root != nullptr; }
+    // Class of one sample; the tree must be fitted
+    int predict(const Eigen::VectorXf& sample) const;
+
+    void set_max_depth(int depth) { max_depth = depth; }
+    int get_max_depth() const { return max_depth; }
+    void set_min_samples_split(int min_samples) { min_samples_split = min_samples; }
+    int get_min_samples_split() const { return min_samples_split; }
+};
+
+#endif // DECISION_TREE_H
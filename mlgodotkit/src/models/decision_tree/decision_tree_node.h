@@ -6,6 +6,8 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/node.hpp>
 #include "utility/utils.h"
+#include "matrix/matrix.h"
+#include "models/decision_tree/decision_tree.h"
 #include <Eigen/Dense>
 #include <vector>
 #include <limits>
@@ -17,57 +19,16 @@ class DecisionTreeNode : public godot::Node {
     GDCLASS(DecisionTreeNode, godot::Node);
 
 private:
-  
-    struct SplitData {
-        Eigen::MatrixXf left_X, right_X;
-        Eigen::VectorXf left_y, right_y;
-    };
-  
-    struct SubNode {
-        int feature_idx;
-        float threshold;
-        SubNode* left;
-        SubNode* right;
-        int value;
-        bool is_leaf;
+    DecisionTree tree;
 
-        SubNode() : left(nullptr), right(nullptr), is_leaf(false), value(-1) {}
-    };
-
-    SubNode* root;
-    int max_depth;
-    int min_samples_split;
-
-    // Recursively build the tree
-    SubNode* buildTree(const Eigen::MatrixXf& X,
-                    const Eigen::VectorXf& y,
-                    int depth);
-
-    // Find best feature to split on
-    void findBestSplit(const Eigen::MatrixXf& X,
-                       const Eigen::VectorXf& y,
-                       int& best_feature,
-                       float& best_threshold);
-
-    SplitData splitData(const Eigen::MatrixXf& X,
-                        const Eigen::VectorXf& y,
-                        int feature_idx, float threshold);
-
-    float calculateImpurity(const Eigen::VectorXf& y);
-
-    int computeLeafValue(const Eigen::VectorXf& y);
-
-    int predictRecursive(SubNode* node, const Eigen::VectorXf& sample) const;
-
-    void freeTree(SubNode* node);
+    void fit_eigen(const Eigen::MatrixXf& X, const Eigen::VectorXf& y);
 
 public:
-    DecisionTreeNode();
-    ~DecisionTreeNode();
-
     static void _bind_methods();
 
     void fit(godot::Array inputs, godot::Array targets);
+    // targets is a single column
+    void fit_matrix(const godot::Ref<godot::Matrix>& inputs, const godot::Ref<godot::Matrix>& targets);
     void set_min_samples_split(int min_samples);
 
     void set_max_depth(int depth);
@@ -1,4 +1,7 @@
 #include "linear_model_node.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 LinearModelNode::LinearModelNode() : learning_rate(0.01), bias(0) {}
 
@@ -8,13 +11,58 @@ void LinearModelNode::_bind_methods() {
     godot::ClassDB::bind_method(godot::D_METHOD("initialize", "input_size"), &LinearModelNode::initialize);
     godot::ClassDB::bind_method(godot::D_METHOD("predict", "input"), &LinearModelNode::predict);
     godot::ClassDB::bind_method(godot::D_METHOD("train", "inputs", "targets", "epochs"), &LinearModelNode::train);
+    godot::ClassDB::bind_method(godot::D_METHOD("partial_fit", "inputs", "targets"), &LinearModelNode::partial_fit);
+    godot::ClassDB::bind_method(godot::D_METHOD("partial_fit_matrix", "inputs", "targets"), &LinearModelNode::partial_fit_matrix);
     godot::ClassDB::bind_method(godot::D_METHOD("set_learning_rate", "lr"), &LinearModelNode::set_learning_rate);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_learning_rate"), &LinearModelNode::get_learning_rate);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_batch_size", "batch_size"), &LinearModelNode::set_batch_size);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_batch_size"), &LinearModelNode::get_batch_size);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_shuffle", "enabled"), &LinearModelNode::set_shuffle);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_shuffle"), &LinearModelNode::get_shuffle);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_seed", "seed"), &LinearModelNode::set_seed);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_optimizer", "optimizer"), &LinearModelNode::set_optimizer);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_optimizer"), &LinearModelNode::get_optimizer);
+    godot::ClassDB::bind_method(godot::D_METHOD("set_momentum", "momentum"), &LinearModelNode::set_momentum);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_momentum"), &LinearModelNode::get_momentum);
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "learning_rate",
+        godot::PROPERTY_HINT_RANGE, "0.0,1.0,0.0001,precision:6"),
+        "set_learning_rate", "get_learning_rate");
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "batch_size",
+        godot::PROPERTY_HINT_RANGE, "0,4096,1"),
+        "set_batch_size", "get_batch_size");
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::BOOL, "shuffle"),
+        "set_shuffle", "get_shuffle");
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::INT, "optimizer",
+        godot::PROPERTY_HINT_ENUM, "SGD,Momentum,Adam"),
+        "set_optimizer", "get_optimizer");
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "momentum",
+        godot::PROPERTY_HINT_RANGE, "0.0,0.999,0.001"),
+        "set_momentum", "get_momentum");
+
+    BIND_ENUM_CONSTANT(OPTIMIZER_SGD);
+    BIND_ENUM_CONSTANT(OPTIMIZER_MOMENTUM);
+    BIND_ENUM_CONSTANT(OPTIMIZER_ADAM);
 }
 
 void LinearModelNode::initialize(int input_size) {
     num_features = input_size;
     weights = Eigen::VectorXf::Random(input_size);
     bias = 0.0;
+    grad_w.resize(input_size);
+    reset_optimizer();
+}
+
+void LinearModelNode::reset_optimizer() {
+    vW = Eigen::VectorXf::Zero(num_features);
+    mW = Eigen::VectorXf::Zero(num_features);
+    vb = 0.0f;
+    mb = 0.0f;
+    step_count = 0;
 }
 
 godot::Array LinearModelNode::predict(godot::Array input) {
@@ -23,18 +71,117 @@ godot::Array LinearModelNode::predict(godot::Array input) {
     return Utils::eigen_to_godot(predictions);
 }
 
+template <typename XT, typename YT>
+void LinearModelNode::step(const XT &X, const YT &y) {
+    const int n = X.rows();
+    if (n == 0)
+        return;
+
+    // residual = Xw + b - y, all into preallocated buffers (run_epoch sizes
+    // residual for the largest batch, so a short last batch uses its head)
+    auto r = residual.head(n);
+    r.noalias() = X * weights;
+    r.array() += static_cast<float>(bias) - y.array();
+
+    grad_w.noalias() = (2.0f / n) * (X.transpose() * r);
+    const float grad_b = r.mean();
+    const float lr = static_cast<float>(learning_rate);
+
+    switch (optimizer) {
+        case OPTIMIZER_MOMENTUM:
+            vW = momentum * vW + grad_w;
+            vb = momentum * vb + grad_b;
+            weights -= lr * vW;
+            bias -= lr * vb;
+            break;
+
+        case OPTIMIZER_ADAM: {
+            ++step_count;
+            mW = momentum * mW + (1.0f - momentum) * grad_w;
+            vW = beta2 * vW + (1.0f - beta2) * grad_w.cwiseAbs2();
+            mb = momentum * mb + (1.0f - momentum) * grad_b;
+            vb = beta2 * vb + (1.0f - beta2) * grad_b * grad_b;
+
+            const float c1 = 1.0f - std::pow(momentum, static_cast<float>(step_count));
+            const float c2 = 1.0f - std::pow(beta2, static_cast<float>(step_count));
+            const float eps = 1e-8f;
+            weights.array() -= lr * (mW.array() / c1) / ((vW.array() / c2).sqrt() + eps);
+            bias -= lr * (mb / c1) / (std::sqrt(vb / c2) + eps);
+            break;
+        }
+
+        case OPTIMIZER_SGD:
+        default:
+            // Gradient descent update
+            weights -= lr * grad_w;
+            bias -= lr * grad_b;
+            break;
+    }
+}
+
+template <typename XT, typename YT>
+void LinearModelNode::run_epoch(const XT &X, const YT &y) {
+    const int n = X.rows();
+    const int bs = (batch_size <= 0 || batch_size >= n) ? n : batch_size;
+    // Only ever grows, so epochs and same-sized partial fits never allocate
+    if (residual.size() < bs)
+        residual.resize(bs);
+
+    // Full batch: order does not matter, no gathering needed
+    if (bs == n) {
+        step(X, y);
+        return;
+    }
+
+    if ((int)order.size() != n) {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+    }
+    if (shuffle)
+        std::shuffle(order.begin(), order.end(), rng);
+
+    X_batch.resize(bs, X.cols());
+    y_batch.resize(bs);
+    for (int start = 0; start < n; start += bs) {
+        const int m = std::min(bs, n - start);
+        for (int i = 0; i < m; ++i) {
+            X_batch.row(i) = X.row(order[start + i]);
+            y_batch(i) = y(order[start + i]);
+        }
+        step(X_batch.topRows(m), y_batch.head(m));
+    }
+}
+
+template <typename XT, typename YT>
+void LinearModelNode::fit_increment(const XT &X, const YT &y) {
+    if (weights.size() == 0)
+        initialize(X.cols());
+
+    ERR_FAIL_COND_MSG(X.cols() != num_features, "Input feature count does not match the model");
+    ERR_FAIL_COND_MSG(X.rows() != y.size(), "Inputs and targets row mismatch");
+
+    // One pass over the new data; optimizer state carries over between calls
+    run_epoch(X, y);
+}
+
 void LinearModelNode::train(godot::Array inputs, godot::Array targets, int epochs) {
     Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
     Eigen::VectorXf y = Utils::godot_to_eigen(targets);
 
-    for (int epoch = 0; epoch < epochs; epoch++) {
-        Eigen::VectorXf predictions = (X * weights).array() + bias;
-        Eigen::VectorXf gradients = compute_gradient(predictions, y, X);
+    for (int epoch = 0; epoch < epochs; epoch++)
+        run_epoch(X, y);
+}
 
-        // Gradient descent update
-        weights -= learning_rate * gradients;
-        bias -= learning_rate * (predictions - y).mean();
-    }
+void LinearModelNode::partial_fit(godot::Array inputs, godot::Array targets) {
+    Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    Eigen::VectorXf y = Utils::godot_to_eigen(targets);
+    fit_increment(X, y);
+}
+
+void LinearModelNode::partial_fit_matrix(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets) {
+    ERR_FAIL_COND_MSG(inputs.is_null() || targets.is_null(), "LinearModelNode::partial_fit_matrix - null matrix");
+    ERR_FAIL_COND_MSG(targets->cols() != 1, "LinearModelNode::partial_fit_matrix - targets must be one column");
+    fit_increment(inputs->eigen(), targets->eigen().col(0));
 }
 
 double LinearModelNode::compute_loss(const Eigen::VectorXf &predictions, const Eigen::VectorXf &targets) {
@@ -49,3 +196,13 @@ Eigen::VectorXf LinearModelNode::compute_gradient(const Eigen::VectorXf &predict
 void LinearModelNode::set_learning_rate(double lr) {
     learning_rate = lr;
 }
+
+void LinearModelNode::set_batch_size(int size) {
+    batch_size = std::max(0, size);
+}
+
+void LinearModelNode::set_optimizer(int opt) {
+    ERR_FAIL_COND_MSG(opt < OPTIMIZER_SGD || opt > OPTIMIZER_ADAM, "Unknown optimizer");
+    optimizer = static_cast<Optimizer>(opt);
+    reset_optimizer();
+}
@@ -5,17 +5,56 @@
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include "utility/utils.h"
+#include "matrix/matrix.h"
 #include <Eigen/Dense>
+#include <random>
 #include <vector>
 
 class LinearModelNode : public godot::Node {
 	GDCLASS(LinearModelNode, godot::Node);
 
+public:
+    enum Optimizer {
+        OPTIMIZER_SGD,
+        OPTIMIZER_MOMENTUM,
+        OPTIMIZER_ADAM,
+    };
+
 private:
     Eigen::VectorXf weights;
     double bias;
     double learning_rate;
-    int num_features;
+    int num_features = 0;
+
+    // Minibatching (batch_size 0 = full batch)
+    int batch_size = 0;
+    bool shuffle = true;
+    std::mt19937 rng{42};
+
+    // Optimizer state
+    Optimizer optimizer = OPTIMIZER_SGD;
+    float momentum = 0.9f;
+    float beta2 = 0.999f;
+    Eigen::VectorXf vW, mW;
+    float vb = 0.0f, mb = 0.0f;
+    int step_count = 0;
+
+    // Scratch reused across epochs and batches
+    std::vector<int> order;
+    Eigen::MatrixXf X_batch;
+    Eigen::VectorXf y_batch;
+    Eigen::VectorXf residual;
+    Eigen::VectorXf grad_w;
+
+    // Templated on the matrix types so row-major Matrix data and column
+    // blocks are read in place instead of being copied to MatrixXf
+    template <typename XT, typename YT>
+    void run_epoch(const XT &X, const YT &y);
+    template <typename XT, typename YT>
+    void fit_increment(const XT &X, const YT &y);
+    template <typename XT, typename YT>
+    void step(const XT &X, const YT &y);
+    void reset_optimizer();
 
 protected:
     static void _bind_methods();
@@ -27,10 +66,25 @@ public:
     void initialize(int input_size);
     godot::Array predict(godot::Array input);
     void train(godot::Array inputs, godot::Array targets, int epochs);
+    void partial_fit(godot::Array inputs, godot::Array targets);
+    // Same as partial_fit() for contiguous batches, e.g. from a Dataset
+    void partial_fit_matrix(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets);
     double compute_loss(const Eigen::VectorXf &predictions, const Eigen::VectorXf &targets);
     Eigen::VectorXf compute_gradient(const Eigen::VectorXf &predictions, const Eigen::VectorXf &targets, const Eigen::MatrixXf &inputs);
 
     void set_learning_rate(double lr);
+    double get_learning_rate() const { return learning_rate; }
+    void set_batch_size(int size);
+    int get_batch_size() const { return batch_size; }
+    void set_shuffle(bool enabled) { shuffle = enabled; }
+    bool get_shuffle() const { return shuffle; }
+    void set_seed(int seed) { rng.seed(seed); }
+    void set_optimizer(int opt);
+    int get_optimizer() const { return optimizer; }
+    void set_momentum(float m) { momentum = m; }
+    float get_momentum() const { return momentum; }
 };
 
-#endif // LINEAR_MODEL_NODE_H
\ No newline at end of file
+VARIANT_ENUM_CAST(LinearModelNode::Optimizer);
+
+#endif // LINEAR_MODEL_NODE_H
@@ -1,4 +1,10 @@
 #include "linear_regression_node.h"
+#include "utility/logger.h"
+#include "utility/thread_pool.h"
+#include <godot_cpp/classes/file_access.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 void LinearRegressionNode::_bind_methods() {
     godot::ClassDB::bind_method(
@@ -10,6 +16,22 @@ void LinearRegressionNode::_bind_methods() {
         godot::D_METHOD("predict", "inputs"),
         &LinearRegressionNode::predict
     );
+
+    godot::ClassDB::bind_method(godot::D_METHOD("reset_accumulator"), &LinearRegressionNode::reset_accumulator);
+    godot::ClassDB::bind_method(godot::D_METHOD("accumulate", "X", "y", "n_features"), &LinearRegressionNode::accumulate);
+    godot::ClassDB::bind_method(godot::D_METHOD("accumulate_matrix", "X", "y"), &LinearRegressionNode::accumulate_matrix);
+    godot::ClassDB::bind_method(godot::D_METHOD("fit_file", "path", "n_features", "chunk_rows", "n_targets"), &LinearRegressionNode::fit_file, godot::DEFVAL(65536), godot::DEFVAL(1));
+    godot::ClassDB::bind_method(godot::D_METHOD("solve_accumulated"), &LinearRegressionNode::solve_accumulated);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_accumulated_rows"), &LinearRegressionNode::get_accumulated_rows);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("get_weights"), &LinearRegressionNode::get_weights);
+
+    godot::ClassDB::bind_method(godot::D_METHOD("set_ridge", "alpha"), &LinearRegressionNode::set_ridge);
+    godot::ClassDB::bind_method(godot::D_METHOD("get_ridge"), &LinearRegressionNode::get_ridge);
+
+    ADD_PROPERTY(godot::PropertyInfo(godot::Variant::FLOAT, "ridge",
+        godot::PROPERTY_HINT_RANGE, "0.0,1000.0,0.0001,or_greater"),
+        "set_ridge", "get_ridge");
 }
 
 void LinearRegressionNode::fit(godot::Array inputs, godot::Array targets) {
@@ -17,25 +39,194 @@ void LinearRegressionNode::fit(godot::Array inputs, godot::Array targets) {
     Eigen::MatrixXf y = Utils::godot_to_eigen(targets);
 
     ERR_FAIL_COND_MSG(X.rows() != y.rows(), "Inputs and targets row mismatch");
-    ERR_FAIL_COND_MSG(y.cols() != 1, "Targets must be a column vector");
+    ERR_FAIL_COND_MSG(y.cols() < 1, "Targets must have at least one column");
 
     // Add bias column (ones)
-    Eigen::MatrixXf Xb(X.rows(), X.cols() + 1);
+    const int d = X.cols() + 1;
+    Eigen::MatrixXf Xb(X.rows(), d);
     Xb << X, Eigen::VectorXf::Ones(X.rows());
 
-    // Closed-form using pseudoinverse for stability
-    weights = Xb.completeOrthogonalDecomposition().pseudoInverse() * y;
+    // Fast path: LDLT on the (d x d) Gram matrix, shared by every output column
+    Eigen::MatrixXf G = Eigen::MatrixXf::Zero(d, d);
+    G.selfadjointView<Eigen::Lower>().rankUpdate(Xb.transpose());
+    G.diagonal().head(d - 1).array() += static_cast<float>(ridge);
+
+    Eigen::LDLT<Eigen::MatrixXf> ldlt(G.selfadjointView<Eigen::Lower>());
+    if (ldlt.info() == Eigen::Success && ldlt.isPositive()) {
+        // The Gram matrix squares the condition number of Xb; only trust it
+        // when the pivots are comfortably above float round-off
+        const Eigen::VectorXf D = ldlt.vectorD().cwiseAbs();
+        if (D.minCoeff() > CONDITION_LIMIT * D.maxCoeff()) {
+            weights = ldlt.solve(Xb.transpose() * y);
+            if (weights.allFinite())
+                return;
+        }
+    }
+
+    Logger::debug(1, "LinearRegressionNode::fit - ill-conditioned, using orthogonal decomposition");
+
+    // Closed-form using complete orthogonal decomposition for stability.
+    // Ridge is folded in by appending sqrt(alpha) * I rows for the feature weights.
+    if (ridge > 0.0) {
+        Eigen::MatrixXf Xa = Eigen::MatrixXf::Zero(Xb.rows() + d - 1, d);
+        Eigen::MatrixXf ya = Eigen::MatrixXf::Zero(Xb.rows() + d - 1, y.cols());
+        Xa.topRows(Xb.rows()) = Xb;
+        Xa.bottomLeftCorner(d - 1, d - 1).diagonal().setConstant(std::sqrt(static_cast<float>(ridge)));
+        ya.topRows(y.rows()) = y;
+        weights = Xa.completeOrthogonalDecomposition().solve(ya);
+    } else {
+        weights = Xb.completeOrthogonalDecomposition().solve(y);
+    }
 }
 
 godot::Array LinearRegressionNode::predict(godot::Array inputs) {
     ERR_FAIL_COND_V(weights.size() == 0, godot::Array());
 
     Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    ERR_FAIL_COND_V_MSG(X.cols() + 1 != weights.rows(), godot::Array(), "Input feature count does not match the model");
 
-    // Add bias column
-    Eigen::MatrixXf Xb(X.rows(), X.cols() + 1);
-    Xb << X, Eigen::VectorXf::Ones(X.rows());
-
-    Eigen::VectorXf preds = Xb * weights;
+    // Bias row added separately instead of building [X 1]
+    Eigen::MatrixXf preds = X * weights.topRows(X.cols());
+    preds.rowwise() += weights.row(X.cols());
     return Utils::eigen_to_godot(preds);
 }
+
+godot::Array LinearRegressionNode::get_weights() const {
+    return Utils::eigen_to_godot(weights);
+}
+
+// --- Streaming fit ---
+
+void LinearRegressionNode::reset_accumulator() {
+    gram.resize(0, 0);
+    xty.resize(0, 0);
+    accumulated_rows = 0;
+    accumulated_features = 0;
+    accumulated_targets = 0;
+}
+
+void LinearRegressionNode::accumulate_rows(const float *X, const float *y, int rows, int n_features, int n_targets) {
+    if (rows <= 0)
+        return;
+
+    const int d = n_features + 1;
+    if (accumulated_features == 0) {
+        accumulated_features = n_features;
+        accumulated_targets = n_targets;
+        gram = Eigen::MatrixXd::Zero(d, d);
+        xty = Eigen::MatrixXd::Zero(d, n_targets);
+    }
+    ERR_FAIL_COND_MSG(n_features != accumulated_features || n_targets != accumulated_targets,
+        "Feature or target count changed between chunks; call reset_accumulator() first");
+
+    using RowMatF = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    Eigen::Map<const RowMatF> mX(X, rows, n_features);
+    Eigen::Map<const RowMatF> my(y, rows, n_targets);
+
+    // Each chunk builds its own partial sums; they are reduced in chunk order
+    // so the result only depends on the thread count, not on scheduling.
+    const int chunks = ThreadPool::chunk_count(rows, 1024);
+    std::vector<Eigen::MatrixXd> partial_gram(chunks, Eigen::MatrixXd::Zero(d, d));
+    std::vector<Eigen::MatrixXd> partial_xty(chunks, Eigen::MatrixXd::Zero(d, n_targets));
+
+    ThreadPool::parallel_for_chunks(rows, chunks, [&](int c, int begin, int end) {
+        // Promote in small blocks so the scratch stays cache-sized
+        const int block = 256;
+        Eigen::MatrixXd Xb(block, d);
+        for (int r = begin; r < end; r += block) {
+            const int n = std::min(block, end - r);
+            Xb.topLeftCorner(n, n_features) = mX.middleRows(r, n).cast<double>();
+            Xb.block(0, n_features, n, 1).setOnes();
+            partial_gram[c].selfadjointView<Eigen::Lower>().rankUpdate(Xb.topRows(n).transpose());
+            partial_xty[c].noalias() += Xb.topRows(n).transpose() * my.middleRows(r, n).cast<double>();
+        }
+    });
+
+    for (int c = 0; c < chunks; ++c) {
+        gram.triangularView<Eigen::Lower>() += partial_gram[c];
+        xty += partial_xty[c];
+    }
+    accumulated_rows += rows;
+}
+
+void LinearRegressionNode::accumulate(const godot::PackedFloat32Array &X, const godot::PackedFloat32Array &y, int n_features) {
+    ERR_FAIL_COND_MSG(n_features < 1, "n_features must be positive");
+    ERR_FAIL_COND_MSG(X.size() % n_features != 0, "X size must be a multiple of n_features");
+    const int rows = X.size() / n_features;
+    ERR_FAIL_COND_MSG(rows == 0 || y.size() % rows != 0, "y must hold the same number of targets for every row");
+    accumulate_rows(X.ptr(), y.ptr(), rows, n_features, y.size() / rows);
+}
+
+void LinearRegressionNode::accumulate_matrix(const godot::Ref<godot::Matrix> &X, const godot::Ref<godot::Matrix> &y) {
+    ERR_FAIL_COND_MSG(X.is_null() || y.is_null(), "Null input");
+    ERR_FAIL_COND_MSG(X->rows() != y->rows(), "Inputs and targets row mismatch");
+    accumulate_rows(X->eigen().data(), y->eigen().data(), X->rows(), X->cols(), y->cols());
+}
+
+godot::Error LinearRegressionNode::fit_file(const godot::String &path, int n_features, int chunk_rows, int n_targets) {
+    ERR_FAIL_COND_V_MSG(n_features < 1 || chunk_rows < 1 || n_targets < 1, godot::ERR_INVALID_PARAMETER, "n_features, chunk_rows and n_targets must be positive");
+
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(path, godot::FileAccess::READ);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "Could not open training file");
+
+    // Raw little-endian float32 rows laid out as [x_0 .. x_{d-1}, y_0 .. y_{k-1}]
+    const int stride = n_features + n_targets;
+    const uint64_t row_bytes = uint64_t(stride) * sizeof(float);
+    ERR_FAIL_COND_V_MSG(file->get_length() % row_bytes != 0, godot::ERR_FILE_CORRUPT, "File size is not a whole number of rows");
+
+    reset_accumulator();
+
+    std::vector<float> buffer(size_t(chunk_rows) * stride);
+    std::vector<float> X(size_t(chunk_rows) * n_features);
+    std::vector<float> y(size_t(chunk_rows) * n_targets);
+
+    while (true) {
+        const uint64_t got = file->get_buffer(reinterpret_cast<uint8_t *>(buffer.data()), buffer.size() * sizeof(float));
+        const int rows = int(got / row_bytes);
+        if (rows == 0)
+            break;
+
+        for (int i = 0; i < rows; ++i) {
+            const float *src = buffer.data() + size_t(i) * stride;
+            std::copy(src, src + n_features, X.data() + size_t(i) * n_features);
+            std::copy(src + n_features, src + stride, y.data() + size_t(i) * n_targets);
+        }
+        accumulate_rows(X.data(), y.data(), rows, n_features, n_targets);
+
+        if (rows < chunk_rows)
+            break;
+    }
+
+    return solve_accumulated() ? godot::OK : godot::FAILED;
+}
+
+bool LinearRegressionNode::solve_normal_equations() {
+    const int d = accumulated_features + 1;
+
+    Eigen::MatrixXd A = gram.selfadjointView<Eigen::Lower>();
+    // Bias (last row/col) is not penalized
+    A.diagonal().head(d - 1).array() += ridge;
+
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(A);
+    if (ldlt.info() == Eigen::Success && ldlt.isPositive()) {
+        Eigen::MatrixXd w = ldlt.solve(xty);
+        if (w.allFinite()) {
+            weights = w.cast<float>();
+            return true;
+        }
+    }
+
+    // Rank-deficient Gram matrix: fall back to the minimum-norm solution
+    Logger::debug(1, "LinearRegressionNode - Gram matrix singular, using pseudoinverse");
+    weights = A.completeOrthogonalDecomposition().solve(xty).cast<float>();
+    return weights.allFinite();
+}
+
+bool LinearRegressionNode::solve_accumulated() {
+    ERR_FAIL_COND_V_MSG(accumulated_rows == 0, false, "No rows accumulated");
+    return solve_normal_equations();
+}
+
+void LinearRegressionNode::set_ridge(double alpha) {
+    ridge = alpha < 0.0 ? 0.0 : alpha;
+}
@@ -4,15 +4,34 @@
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
 #include <Eigen/Dense>
 #include "utility/utils.h"
+#include "matrix/matrix.h"
 
 class LinearRegressionNode : public godot::Node {
     GDCLASS(LinearRegressionNode, godot::Node);
 
 private:
-    // Includes bias as last element
-    Eigen::VectorXf weights;
+    // (d + 1) x k, one column per output; bias is the last row
+    Eigen::MatrixXf weights;
+
+    // L2 penalty on the non-bias weights
+    double ridge = 0.0;
+
+    // Smallest LDLT pivot ratio accepted by the Gram-matrix fast path
+    static constexpr float CONDITION_LIMIT = 1e-5f;
+
+    // Streaming normal equations over [X 1]: G = Xb^T Xb, r = Xb^T y.
+    // Accumulated in double so tens of millions of rows do not lose precision.
+    Eigen::MatrixXd gram;
+    Eigen::MatrixXd xty;
+    int64_t accumulated_rows = 0;
+    int accumulated_features = 0;
+    int accumulated_targets = 0;
+
+    void accumulate_rows(const float *X, const float *y, int rows, int n_features, int n_targets);
+    bool solve_normal_equations();
 
 protected:
     static void _bind_methods();
@@ -22,6 +41,19 @@ public:
 
     void fit(godot::Array inputs, godot::Array targets);
     godot::Array predict(godot::Array inputs);
+
+    // Chunked / out-of-core fitting
+    void reset_accumulator();
+    void accumulate(const godot::PackedFloat32Array &X, const godot::PackedFloat32Array &y, int n_features);
+    void accumulate_matrix(const godot::Ref<godot::Matrix> &X, const godot::Ref<godot::Matrix> &y);
+    godot::Error fit_file(const godot::String &path, int n_features, int chunk_rows = 65536, int n_targets = 1);
+    bool solve_accumulated();
+    int64_t get_accumulated_rows() const { return accumulated_rows; }
+
+    godot::Array get_weights() const;
+
+    void set_ridge(double alpha);
+    double get_ridge() const { return ridge; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,266 @@
+#include "logistic_regression_node.h"
+#include "optimizers/lbfgs/lbfgs.h"
+#include "utility/logger.h"
+#include "utility/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    // Rows per chunk below which threading overhead dominates the matmul
+    int min_chunk_rows(int d, int k) {
+        return std::max(64, 65536 / std::max(1, (d + 1) * k));
+    }
+
+    // log(1 + e^z) without overflow
+    inline double softplus(double z) {
+        return std::max(z, 0.0) + std::log1p(std::exp(-std::abs(z)));
+    }
+
+    inline float sigmoid(float z) {
+        if (z >= 0.0f)
+            return 1.0f / (1.0f + std::exp(-z));
+        const float e = std::exp(z);
+        return e / (1.0f + e);
+    }
+
+} // namespace
+
+void LogisticRegressionNode::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_method(D_METHOD("fit", "inputs", "labels"), &LogisticRegressionNode::fit);
+    ClassDB::bind_method(D_METHOD("fit_matrix", "X", "labels"), &LogisticRegressionNode::fit_matrix);
+    ClassDB::bind_method(D_METHOD("predict", "inputs"), &LogisticRegressionNode::predict);
+    ClassDB::bind_method(D_METHOD("predict_proba", "inputs"), &LogisticRegressionNode::predict_proba);
+
+    ClassDB::bind_method(D_METHOD("get_weights"), &LogisticRegressionNode::get_weights);
+    ClassDB::bind_method(D_METHOD("get_num_classes"), &LogisticRegressionNode::get_num_classes);
+    ClassDB::bind_method(D_METHOD("get_iterations"), &LogisticRegressionNode::get_iterations);
+    ClassDB::bind_method(D_METHOD("get_loss"), &LogisticRegressionNode::get_loss);
+
+    ClassDB::bind_method(D_METHOD("set_l2_penalty", "alpha"), &LogisticRegressionNode::set_l2_penalty);
+    ClassDB::bind_method(D_METHOD("get_l2_penalty"), &LogisticRegressionNode::get_l2_penalty);
+    ClassDB::bind_method(D_METHOD("set_max_iterations", "iterations"), &LogisticRegressionNode::set_max_iterations);
+    ClassDB::bind_method(D_METHOD("get_max_iterations"), &LogisticRegressionNode::get_max_iterations);
+    ClassDB::bind_method(D_METHOD("set_tolerance", "tol"), &LogisticRegressionNode::set_tolerance);
+    ClassDB::bind_method(D_METHOD("get_tolerance"), &LogisticRegressionNode::get_tolerance);
+    ClassDB::bind_method(D_METHOD("set_history_size", "size"), &LogisticRegressionNode::set_history_size);
+    ClassDB::bind_method(D_METHOD("get_history_size"), &LogisticRegressionNode::get_history_size);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "l2_penalty",
+        PROPERTY_HINT_RANGE, "0.0,10.0,0.00001,or_greater"),
+        "set_l2_penalty", "get_l2_penalty");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_iterations",
+        PROPERTY_HINT_RANGE, "1,10000,1,or_greater"),
+        "set_max_iterations", "get_max_iterations");
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tolerance",
+        PROPERTY_HINT_RANGE, "0.0,0.1,0.0000001"),
+        "set_tolerance", "get_tolerance");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "history_size",
+        PROPERTY_HINT_RANGE, "1,50,1"),
+        "set_history_size", "get_history_size");
+}
+
+double LogisticRegressionNode::loss_and_gradient(const float *X, int rows, const std::vector<int> &labels,
+                                                 const Eigen::VectorXd &theta, Eigen::VectorXd &grad) {
+    const int d = num_features;
+    const int k = num_classes == 2 ? 1 : num_classes;
+
+    Eigen::Map<const Eigen::MatrixXd> Wd(theta.data(), d + 1, k);
+    const Eigen::MatrixXf W = Wd.cast<float>();
+
+    const int min_chunk = min_chunk_rows(d, k);
+    const int chunks = ThreadPool::chunk_count(rows, min_chunk);
+    if (static_cast<int>(scratch.size()) < chunks)
+        scratch.resize(chunks);
+
+    ThreadPool::parallel_for_chunks(rows, chunks, [&](int c, int begin, int end) {
+        ChunkScratch &s = scratch[c];
+        const int m = end - begin;
+        Eigen::Map<const RowMat> Xc(X + static_cast<size_t>(begin) * d, m, d);
+
+        // Logits are overwritten in place with dL/dz = p - onehot(y)
+        s.logits.noalias() = Xc * W.topRows(d);
+        s.logits.rowwise() += W.row(d);
+
+        double loss = 0.0;
+        if (k == 1) {
+            for (int i = 0; i < m; ++i) {
+                const float z = s.logits(i, 0);
+                const int y = labels[begin + i];
+                loss += softplus(z) - y * static_cast<double>(z);
+                s.logits(i, 0) = sigmoid(z) - static_cast<float>(y);
+            }
+        } else {
+            for (int i = 0; i < m; ++i) {
+                auto z = s.logits.row(i);
+                const int y = labels[begin + i];
+                const float zmax = z.maxCoeff();
+                const float zy = z(y);
+                z.array() = (z.array() - zmax).exp();
+                const float sum = z.sum();
+                loss += std::log(static_cast<double>(sum)) + zmax - zy;
+                z /= sum;
+                z(y) -= 1.0f;
+            }
+        }
+
+        s.grad.resize(d + 1, k);
+        s.grad.topRows(d) = (Xc.transpose() * s.logits).cast<double>();
+        s.grad.row(d) = s.logits.colwise().sum().cast<double>();
+        s.loss = loss;
+    });
+
+    // Fixed-order reduction keeps the result independent of scheduling
+    Eigen::Map<Eigen::MatrixXd> G(grad.data(), d + 1, k);
+    G.setZero();
+    double loss = 0.0;
+    for (int c = 0; c < chunks; ++c) {
+        G += scratch[c].grad;
+        loss += scratch[c].loss;
+    }
+
+    const double inv_n = 1.0 / rows;
+    G *= inv_n;
+    loss *= inv_n;
+
+    // L2 on the feature weights only; the bias row is left unpenalized
+    if (l2_penalty > 0.0) {
+        loss += 0.5 * l2_penalty * Wd.topRows(d).squaredNorm();
+        G.topRows(d) += l2_penalty * Wd.topRows(d);
+    }
+    return loss;
+}
+
+bool LogisticRegressionNode::fit_rows(const float *X, int rows, int n_features, const std::vector<int> &labels) {
+    ERR_FAIL_COND_V_MSG(rows < 1 || n_features < 1, false, "LogisticRegressionNode: empty training set");
+
+    int max_label = 0;
+    for (int y : labels) {
+        ERR_FAIL_COND_V_MSG(y < 0, false, "LogisticRegressionNode: labels must be non-negative class indices");
+        max_label = std::max(max_label, y);
+    }
+    ERR_FAIL_COND_V_MSG(max_label < 1, false, "LogisticRegressionNode: need at least two classes");
+
+    num_features = n_features;
+    num_classes = max_label + 1;
+    const int k = num_classes == 2 ? 1 : num_classes;
+
+    LBFGS::Options options;
+    options.history_size = history_size;
+    options.max_iterations = max_iterations;
+    options.gradient_tolerance = tolerance;
+    options.function_tolerance = tolerance * 1e-3;
+
+    // The objective is convex, so a zero start is as good as any
+    Eigen::VectorXd theta = Eigen::VectorXd::Zero(static_cast<Eigen::Index>(n_features + 1) * k);
+    LBFGS solver(options);
+    const LBFGS::Result result = solver.minimize(
+        [&](const Eigen::VectorXd &x, Eigen::VectorXd &g) {
+            g.resize(x.size());
+            return loss_and_gradient(X, rows, labels, x, g);
+        },
+        theta);
+
+    weights = Eigen::Map<const Eigen::MatrixXd>(theta.data(), n_features + 1, k).cast<float>();
+    last_iterations = result.iterations;
+    last_loss = result.value;
+
+    // Chunk buffers scale with the data; do not keep them around between fits
+    scratch.clear();
+    scratch.shrink_to_fit();
+
+    if (!result.converged)
+        Logger::debug(1, "LogisticRegressionNode::fit - stopped after " + std::to_string(result.iterations) +
+                         " iterations without converging");
+    return true;
+}
+
+void LogisticRegressionNode::fit(godot::Array inputs, godot::Array labels) {
+    ERR_FAIL_COND_MSG(inputs.size() != labels.size(), "Inputs and labels row mismatch");
+
+    // Row-major copy so each sample chunk is one contiguous block
+    const RowMat X = Utils::godot_to_eigen(inputs);
+    std::vector<int> y(labels.size());
+    for (int i = 0; i < labels.size(); ++i)
+        y[i] = static_cast<int>(labels[i]);
+
+    fit_rows(X.data(), X.rows(), X.cols(), y);
+}
+
+void LogisticRegressionNode::fit_matrix(const godot::Ref<godot::Matrix> &X, const godot::PackedInt32Array &labels) {
+    ERR_FAIL_COND_MSG(X.is_null(), "LogisticRegressionNode: null input matrix");
+    ERR_FAIL_COND_MSG(X->rows() != labels.size(), "Inputs and labels row mismatch");
+
+    // Matrix storage is already row-major, so it is read in place
+    std::vector<int> y(labels.ptr(), labels.ptr() + labels.size());
+    const godot::Matrix *Xp = X.ptr();
+    fit_rows(Xp->eigen().data(), Xp->rows(), Xp->cols(), y);
+}
+
+Eigen::MatrixXf LogisticRegressionNode::probabilities(const Eigen::MatrixXf &X) const {
+    Eigen::MatrixXf Z = X * weights.topRows(num_features);
+    Z.rowwise() += weights.row(num_features);
+
+    if (num_classes == 2) {
+        Eigen::MatrixXf P(Z.rows(), 2);
+        for (int i = 0; i < Z.rows(); ++i) {
+            P(i, 1) = sigmoid(Z(i, 0));
+            P(i, 0) = 1.0f - P(i, 1);
+        }
+        return P;
+    }
+
+    Z.colwise() -= Z.rowwise().maxCoeff();
+    Z = Z.array().exp();
+    Z.array().colwise() /= Z.rowwise().sum().array();
+    return Z;
+}
+
+godot::PackedInt32Array LogisticRegressionNode::predict(godot::Array inputs) {
+    ERR_FAIL_COND_V_MSG(weights.size() == 0, godot::PackedInt32Array(), "LogisticRegressionNode: model is not fitted");
+
+    Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    ERR_FAIL_COND_V_MSG(X.cols() != num_features, godot::PackedInt32Array(), "Input feature count does not match the model");
+
+    const Eigen::MatrixXf P = probabilities(X);
+    godot::PackedInt32Array out;
+    out.resize(P.rows());
+    for (int i = 0; i < P.rows(); ++i) {
+        Eigen::Index best;
+        P.row(i).maxCoeff(&best);
+        out.set(i, static_cast<int32_t>(best));
+    }
+    return out;
+}
+
+godot::Array LogisticRegressionNode::predict_proba(godot::Array inputs) {
+    ERR_FAIL_COND_V_MSG(weights.size() == 0, godot::Array(), "LogisticRegressionNode: model is not fitted");
+
+    Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    ERR_FAIL_COND_V_MSG(X.cols() != num_features, godot::Array(), "Input feature count does not match the model");
+    return Utils::eigen_to_godot(probabilities(X));
+}
+
+godot::Array LogisticRegressionNode::get_weights() const {
+    return Utils::eigen_to_godot(weights);
+}
+
+void LogisticRegressionNode::set_l2_penalty(double alpha) {
+    l2_penalty = alpha >= 0.0 ? alpha : 0.0;
+}
+
+void LogisticRegressionNode::set_max_iterations(int iterations) {
+    max_iterations = std::max(1, iterations);
+}
+
+void LogisticRegressionNode::set_tolerance(double tol) {
+    tolerance = tol >= 0.0 ? tol : 0.0;
+}
+
+void LogisticRegressionNode::set_history_size(int size) {
+    history_size = std::clamp(size, 1, 50);
+}
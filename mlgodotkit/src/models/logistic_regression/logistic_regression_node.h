@@ -0,0 +1,74 @@
+#ifndef LOGISTIC_REGRESSION_NODE_H
+#define LOGISTIC_REGRESSION_NODE_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <Eigen/Dense>
+#include <vector>
+#include "utility/utils.h"
+#include "matrix/matrix.h"
+
+// Binary logistic / multinomial softmax classifier trained with L-BFGS.
+// Two classes use a single sigmoid output; more use a softmax over k outputs.
+class LogisticRegressionNode : public godot::Node {
+    GDCLASS(LogisticRegressionNode, godot::Node);
+
+private:
+    using RowMat = godot::Matrix::EigenMat;
+
+    // (d + 1) x k, bias is the last row; k = 1 for binary problems
+    Eigen::MatrixXf weights;
+    int num_features = 0;
+    int num_classes = 0;
+
+    double l2_penalty = 1e-4;
+    int max_iterations = 100;
+    double tolerance = 1e-6;
+    int history_size = 10;
+
+    int last_iterations = 0;
+    double last_loss = 0.0;
+
+    // Per-chunk partials for the parallel loss/gradient, reduced in chunk order
+    struct ChunkScratch {
+        RowMat logits;
+        Eigen::MatrixXd grad;
+        double loss = 0.0;
+    };
+    std::vector<ChunkScratch> scratch;
+
+    bool fit_rows(const float *X, int rows, int n_features, const std::vector<int> &labels);
+    double loss_and_gradient(const float *X, int rows, const std::vector<int> &labels,
+                             const Eigen::VectorXd &theta, Eigen::VectorXd &grad);
+    Eigen::MatrixXf probabilities(const Eigen::MatrixXf &X) const;
+
+protected:
+    static void _bind_methods();
+
+public:
+    LogisticRegressionNode() = default;
+
+    void fit(godot::Array inputs, godot::Array labels);
+    void fit_matrix(const godot::Ref<godot::Matrix> &X, const godot::PackedInt32Array &labels);
+
+    godot::PackedInt32Array predict(godot::Array inputs);
+    godot::Array predict_proba(godot::Array inputs);
+
+    godot::Array get_weights() const;
+    int get_num_classes() const { return num_classes; }
+    int get_iterations() const { return last_iterations; }
+    double get_loss() const { return last_loss; }
+
+    void set_l2_penalty(double alpha);
+    double get_l2_penalty() const { return l2_penalty; }
+    void set_max_iterations(int iterations);
+    int get_max_iterations() const { return max_iterations; }
+    void set_tolerance(double tol);
+    double get_tolerance() const { return tolerance; }
+    void set_history_size(int size);
+    int get_history_size() const { return history_size; }
+};
+
+#endif // LOGISTIC_REGRESSION_NODE_H
@@ -0,0 +1,182 @@
+#include "checkpoint.h"
+#include <cstring>
+
+namespace {
+
+constexpr char MAGIC[8] = { 'M', 'L', 'G', 'K', 'C', 'K', 'P', 'T' };
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+constexpr uint32_t FLAG_OPTIMIZER = 1u;
+constexpr uint32_t LAYER_FLAG_SQUASH = 1u;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint32_t layer_count;
+    uint32_t flags;
+    uint32_t reserved0;
+    uint64_t training_steps;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(FileHeader) == 64, "checkpoint header must stay 64 bytes");
+
+struct LayerRecord {
+    uint32_t input_size;
+    uint32_t output_size;
+    uint32_t activation;
+    uint32_t flags;
+    float squash_in;
+    float squash_out;
+    uint32_t reserved[2];
+    uint64_t weights_offset;
+    uint64_t biases_offset;
+    uint64_t momentum_weights_offset;   // 0 when absent
+    uint64_t momentum_biases_offset;
+};
+static_assert(sizeof(LayerRecord) == 64, "checkpoint layer record must stay 64 bytes");
+
+uint64_t align_up(uint64_t v) {
+    return (v + Checkpoint::ALIGNMENT - 1) & ~(Checkpoint::ALIGNMENT - 1);
+}
+
+const char *activation_name(uint32_t id) {
+    switch (id) {
+        case InplaceActivation::RELU: return "relu";
+        case InplaceActivation::LEAKY_RELU: return "leaky_relu";
+        case InplaceActivation::SIGMOID: return "sigmoid";
+        default: return "linear";
+    }
+}
+
+// Appends a matrix at the next aligned offset and returns that offset
+uint64_t put_blob(std::vector<uint8_t> &out, const Eigen::Ref<const Eigen::MatrixXf> &m) {
+    const uint64_t offset = align_up(out.size());
+    const uint64_t bytes = uint64_t(m.size()) * sizeof(float);
+    out.resize(offset + bytes, 0);
+    if (bytes > 0)
+        std::memcpy(out.data() + offset, m.data(), bytes);
+    return offset;
+}
+
+bool blob_fits(uint64_t offset, uint64_t count, size_t file_size) {
+    const uint64_t bytes = count * sizeof(float);
+    return offset % Checkpoint::ALIGNMENT == 0 && offset <= file_size && bytes <= file_size - offset;
+}
+
+} // namespace
+
+namespace Checkpoint {
+
+std::vector<uint8_t> serialize(const std::vector<Layer> &layers, uint64_t training_steps, bool include_optimizer) {
+    std::vector<LayerRecord> records(layers.size());
+    std::vector<uint8_t> out(sizeof(FileHeader) + records.size() * sizeof(LayerRecord), 0);
+
+    bool any_optimizer = false;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        const Layer &layer = layers[i];
+        const InplaceActivation act = layer.get_inplace_activation();
+        LayerRecord &r = records[i];
+        std::memset(&r, 0, sizeof(r));
+        r.input_size = layer.get_input_size();
+        r.output_size = layer.get_output_size();
+        r.activation = act.kind;
+        r.flags = act.squash ? LAYER_FLAG_SQUASH : 0u;
+        r.squash_in = act.scale_in;
+        r.squash_out = act.scale_out;
+        const std::shared_ptr<const LayerParams> params = layer.share_params();
+        r.weights_offset = put_blob(out, params->weights_view());
+        r.biases_offset = put_blob(out, params->biases_view());
+
+        const Eigen::MatrixXf &mW = layer.get_momentum_weights();
+        if (include_optimizer && mW.size() > 0) {
+            r.momentum_weights_offset = put_blob(out, mW);
+            r.momentum_biases_offset = put_blob(out, layer.get_momentum_biases());
+            any_optimizer = true;
+        }
+    }
+
+    FileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = VERSION;
+    h.byte_order = BYTE_ORDER_MARK;
+    h.header_size = sizeof(FileHeader);
+    h.layer_count = static_cast<uint32_t>(layers.size());
+    h.flags = any_optimizer ? FLAG_OPTIMIZER : 0u;
+    h.training_steps = training_steps;
+
+    std::memcpy(out.data(), &h, sizeof(h));
+    if (!records.empty())
+        std::memcpy(out.data() + sizeof(h), records.data(), records.size() * sizeof(LayerRecord));
+    return out;
+}
+
+std::string parse(const std::shared_ptr<const MappedFile> &file, std::vector<Layer> &layers, Info &info) {
+    if (!file || file->size() < sizeof(FileHeader))
+        return "file too small";
+
+    FileHeader h;
+    std::memcpy(&h, file->data(), sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0)
+        return "not a checkpoint";
+    if (h.byte_order != BYTE_ORDER_MARK)
+        return "byte order mismatch";
+    if (h.version == 0 || h.version > VERSION)
+        return "unsupported version " + std::to_string(h.version);
+    if (h.header_size < sizeof(FileHeader) || h.layer_count == 0)
+        return "malformed header";
+
+    const uint64_t table_end = uint64_t(h.header_size) + uint64_t(h.layer_count) * sizeof(LayerRecord);
+    if (table_end > file->size())
+        return "truncated layer table";
+
+    std::vector<Layer> parsed;
+    parsed.reserve(h.layer_count);
+    const uint8_t *base = file->data();
+
+    for (uint32_t i = 0; i < h.layer_count; ++i) {
+        LayerRecord r;
+        std::memcpy(&r, base + h.header_size + uint64_t(i) * sizeof(LayerRecord), sizeof(r));
+
+        const uint64_t n_weights = uint64_t(r.input_size) * r.output_size;
+        if (r.input_size == 0 || r.output_size == 0 || r.activation > InplaceActivation::SIGMOID)
+            return "malformed layer " + std::to_string(i);
+        if (!parsed.empty() && parsed.back().get_output_size() != int(r.input_size))
+            return "layer " + std::to_string(i) + " input size mismatch";
+        if (!blob_fits(r.weights_offset, n_weights, file->size()) ||
+            !blob_fits(r.biases_offset, r.output_size, file->size()))
+            return "layer " + std::to_string(i) + " data out of bounds";
+
+        // Parameters stay in the file; the first update copies them out
+        auto p = std::make_shared<LayerParams>();
+        p->backing = file;
+        p->mapped_weights = reinterpret_cast<const float *>(base + r.weights_offset);
+        p->mapped_biases = reinterpret_cast<const float *>(base + r.biases_offset);
+        p->mapped_rows = static_cast<int>(r.input_size);
+        p->mapped_cols = static_cast<int>(r.output_size);
+
+        Layer layer(std::move(p), 0.0f, activation_name(r.activation));
+        if (r.flags & LAYER_FLAG_SQUASH)
+            layer.set_output_squash(true, r.squash_in, r.squash_out);
+
+        if (r.momentum_weights_offset != 0) {
+            if (!blob_fits(r.momentum_weights_offset, n_weights, file->size()) ||
+                !blob_fits(r.momentum_biases_offset, r.output_size, file->size()))
+                return "layer " + std::to_string(i) + " optimizer state out of bounds";
+            layer.set_momentum(
+                Eigen::Map<const Eigen::MatrixXf>(reinterpret_cast<const float *>(base + r.momentum_weights_offset),
+                                                  r.input_size, r.output_size),
+                Eigen::Map<const Eigen::MatrixXf>(reinterpret_cast<const float *>(base + r.momentum_biases_offset),
+                                                  1, r.output_size));
+        }
+        parsed.push_back(std::move(layer));
+    }
+
+    info.training_steps = h.training_steps;
+    info.has_optimizer = (h.flags & FLAG_OPTIMIZER) != 0;
+    layers = std::move(parsed);
+    return std::string();
+}
+
+} // namespace Checkpoint
@@ -0,0 +1,43 @@
+#ifndef NN_CHECKPOINT_H
+#define NN_CHECKPOINT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "models/neural_network/layer/layer.h"
+#include "utility/mapped_file.h"
+
+// Binary checkpoint format for NeuralNetworkNode (little-endian):
+//
+//   Header        64 bytes   magic "MLGKCKPT", version, byte-order mark,
+//                            layer count, flags, training step
+//   Layer table   64 bytes   per layer: sizes, activation id, output squash,
+//                            offsets of its blobs
+//   Blobs                    float32, column-major (Eigen's layout), each
+//                            starting on a 64-byte boundary: weights (in x out),
+//                            biases (1 x out), then the optional momentum pair
+//
+// Because the blobs are aligned and already in Eigen's layout, a mapped file
+// is used in place: parse() points the layer parameters into the mapping.
+namespace Checkpoint {
+
+    constexpr uint32_t VERSION = 1;
+    constexpr uint64_t ALIGNMENT = 64;
+
+    struct Info {
+        uint64_t training_steps = 0;
+        bool has_optimizer = false;
+    };
+
+    // Optimizer momentum is written for layers that have it when requested
+    std::vector<uint8_t> serialize(const std::vector<Layer> &layers, uint64_t training_steps, bool include_optimizer);
+
+    // Builds layers whose parameters reference `file` (no copy). Momentum, if
+    // present, is copied since it is only needed for training. Returns an
+    // empty string on success, otherwise why the file was rejected.
+    std::string parse(const std::shared_ptr<const MappedFile> &file, std::vector<Layer> &layers, Info &info);
+
+} // namespace Checkpoint
+
+#endif // NN_CHECKPOINT_H
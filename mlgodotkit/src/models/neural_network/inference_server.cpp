@@ -0,0 +1,248 @@
+#include "inference_server.h"
+#include "utility/logger.h"
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/core/object.hpp>
+
+using namespace godot;
+
+void InferenceServer::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("submit", "network", "observation"), &InferenceServer::submit);
+    ClassDB::bind_method(D_METHOD("flush"), &InferenceServer::flush);
+    ClassDB::bind_method(D_METHOD("wait"), &InferenceServer::wait);
+    ClassDB::bind_method(D_METHOD("is_ready", "handle"), &InferenceServer::is_ready);
+    ClassDB::bind_method(D_METHOD("get_result", "handle"), &InferenceServer::get_result);
+    ClassDB::bind_method(D_METHOD("get_pending_count"), &InferenceServer::get_pending_count);
+
+    ClassDB::bind_method(D_METHOD("set_flush_mode", "mode"), &InferenceServer::set_flush_mode);
+    ClassDB::bind_method(D_METHOD("get_flush_mode"), &InferenceServer::get_flush_mode);
+    ClassDB::bind_method(D_METHOD("set_use_worker_thread", "enabled"), &InferenceServer::set_use_worker_thread);
+    ClassDB::bind_method(D_METHOD("get_use_worker_thread"), &InferenceServer::get_use_worker_thread);
+    ClassDB::bind_method(D_METHOD("set_max_batch_size", "size"), &InferenceServer::set_max_batch_size);
+    ClassDB::bind_method(D_METHOD("get_max_batch_size"), &InferenceServer::get_max_batch_size);
+    ClassDB::bind_method(D_METHOD("set_max_latency_ms", "ms"), &InferenceServer::set_max_latency_ms);
+    ClassDB::bind_method(D_METHOD("get_max_latency_ms"), &InferenceServer::get_max_latency_ms);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "flush_mode",
+        PROPERTY_HINT_ENUM, "Physics,Process,Manual"),
+        "set_flush_mode", "get_flush_mode");
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_worker_thread"),
+        "set_use_worker_thread", "get_use_worker_thread");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_batch_size",
+        PROPERTY_HINT_RANGE, "0,4096,1,or_greater"),
+        "set_max_batch_size", "get_max_batch_size");
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_latency_ms",
+        PROPERTY_HINT_RANGE, "0.0,100.0,0.1,or_greater"),
+        "set_max_latency_ms", "get_max_latency_ms");
+
+    ADD_SIGNAL(MethodInfo("batch_completed", PropertyInfo(Variant::PACKED_INT64_ARRAY, "handles")));
+
+    BIND_ENUM_CONSTANT(FLUSH_PHYSICS);
+    BIND_ENUM_CONSTANT(FLUSH_PROCESS);
+    BIND_ENUM_CONSTANT(FLUSH_MANUAL);
+}
+
+InferenceServer::~InferenceServer() {
+    // The worker task references this object; never let it outlive us
+    if (task_id >= 0)
+        WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+}
+
+void InferenceServer::_notification(int p_what) {
+    switch (p_what) {
+        case NOTIFICATION_READY:
+            // Run after the agents that submit during the same frame
+            if (get_physics_process_priority() == 0)
+                set_physics_process_priority(100);
+            if (get_process_priority() == 0)
+                set_process_priority(100);
+            update_processing();
+            break;
+        case NOTIFICATION_INTERNAL_PHYSICS_PROCESS:
+            if (flush_mode == FLUSH_PHYSICS)
+                flush();
+            break;
+        case NOTIFICATION_INTERNAL_PROCESS:
+            if (flush_mode == FLUSH_PROCESS)
+                flush();
+            break;
+        case NOTIFICATION_EXIT_TREE:
+            wait();
+            break;
+    }
+}
+
+void InferenceServer::update_processing() {
+    set_physics_process_internal(flush_mode == FLUSH_PHYSICS);
+    set_process_internal(flush_mode == FLUSH_PROCESS);
+}
+
+int64_t InferenceServer::submit(NeuralNetworkNode *network, const PackedFloat32Array &observation) {
+    ERR_FAIL_NULL_V_MSG(network, -1, "InferenceServer::submit - null network");
+    const int input_size = network->get_input_size();
+    ERR_FAIL_COND_V_MSG(input_size == 0, -1, "InferenceServer::submit - network has no layers");
+    ERR_FAIL_COND_V_MSG(observation.size() != input_size, -1,
+        "InferenceServer::submit - observation size does not match the network input");
+
+    Queue &q = queues[network->get_instance_id()];
+    const uint64_t now = Time::get_singleton()->get_ticks_usec();
+    if (q.handles.empty() || q.input_size != input_size) {
+        // A network rebuilt with a new input size invalidates what was queued
+        q.inputs.clear();
+        q.handles.clear();
+        q.input_size = input_size;
+        q.first_submit_usec = now;
+    }
+
+    const int64_t handle = next_handle++;
+    q.inputs.insert(q.inputs.end(), observation.ptr(), observation.ptr() + input_size);
+    q.handles.push_back(handle);
+
+    const bool full = max_batch_size > 0 && static_cast<int>(q.handles.size()) >= max_batch_size;
+    const bool late = max_latency_ms > 0.0 && (now - q.first_submit_usec) >= max_latency_ms * 1000.0;
+    if (full || late)
+        flush();
+
+    return handle;
+}
+
+void InferenceServer::flush() {
+    // Publish the previous asynchronous batch first, so results arrive in order
+    collect();
+    flushed_upto = next_handle - 1;
+    if (queues.empty())
+        return;
+
+    using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    for (auto &entry : queues) {
+        Queue &q = entry.second;
+        if (q.handles.empty())
+            continue;
+
+        NeuralNetworkNode *network = Object::cast_to<NeuralNetworkNode>(ObjectDB::get_instance(entry.first));
+        if (network == nullptr || network->get_input_size() != q.input_size) {
+            Logger::warn("InferenceServer::flush - network freed or rebuilt, dropping " +
+                         std::to_string(q.handles.size()) + " requests");
+            continue;
+        }
+
+        Batch batch;
+        batch.stack = network->snapshot_inference_stack();
+        batch.X = Eigen::Map<const RowMat>(q.inputs.data(), q.handles.size(), q.input_size);
+        batch.handles = std::move(q.handles);
+        running.push_back(std::move(batch));
+    }
+    queues.clear();
+
+    if (running.empty())
+        return;
+
+    if (use_worker_thread) {
+        task_id = WorkerThreadPool::get_singleton()->add_task(
+            callable_mp(this, &InferenceServer::run_batches), false, "InferenceServer");
+    } else {
+        run_batches();
+        publish();
+    }
+}
+
+void InferenceServer::run_batches() {
+    // Only reads the layer snapshots, which no other thread writes
+    InferenceScratch scratch;
+    for (Batch &batch : running)
+        batch.Y = batch.stack.infer(batch.X, scratch);
+}
+
+void InferenceServer::collect() {
+    if (task_id < 0)
+        return;
+    WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+    task_id = -1;
+    publish();
+}
+
+void InferenceServer::publish() {
+    ++generation;
+    PackedInt64Array done;
+
+    for (Batch &batch : running) {
+        const int cols = batch.Y.cols();
+        for (size_t i = 0; i < batch.handles.size(); ++i) {
+            Result r;
+            r.generation = generation;
+            r.values.resize(cols);
+            float *dst = r.values.ptrw();
+            for (int j = 0; j < cols; ++j)
+                dst[j] = batch.Y(i, j);
+            results[batch.handles[i]] = std::move(r);
+            done.push_back(batch.handles[i]);
+        }
+    }
+    // Dropping the snapshots releases their references to the weights
+    running.clear();
+
+    for (auto it = results.begin(); it != results.end();) {
+        if (it->second.generation + RESULT_LIFETIME < generation)
+            it = results.erase(it);
+        else
+            ++it;
+    }
+
+    if (!done.is_empty())
+        emit_signal("batch_completed", done);
+}
+
+void InferenceServer::wait() {
+    collect();
+}
+
+bool InferenceServer::is_ready(int64_t handle) const {
+    return results.count(handle) > 0;
+}
+
+PackedFloat32Array InferenceServer::get_result(int64_t handle) {
+    auto it = results.find(handle);
+    if (it == results.end()) {
+        // Still queued or in flight: finish it now instead of failing
+        if (handle > flushed_upto && handle < next_handle)
+            flush();
+        collect();
+        it = results.find(handle);
+    }
+    ERR_FAIL_COND_V_MSG(it == results.end(), PackedFloat32Array(),
+        "InferenceServer::get_result - unknown or expired handle");
+
+    PackedFloat32Array out = it->second.values;
+    results.erase(it);
+    return out;
+}
+
+int InferenceServer::get_pending_count() const {
+    int count = 0;
+    for (const auto &entry : queues)
+        count += static_cast<int>(entry.second.handles.size());
+    return count;
+}
+
+void InferenceServer::set_flush_mode(FlushMode mode) {
+    flush_mode = mode;
+    if (is_inside_tree())
+        update_processing();
+}
+
+void InferenceServer::set_use_worker_thread(bool enabled) {
+    if (!enabled)
+        collect();
+    use_worker_thread = enabled;
+}
+
+void InferenceServer::set_max_batch_size(int size) {
+    max_batch_size = size > 0 ? size : 0;
+}
+
+void InferenceServer::set_max_latency_ms(double ms) {
+    max_latency_ms = ms > 0.0 ? ms : 0.0;
+}
@@ -0,0 +1,99 @@
+#ifndef INFERENCE_SERVER_H
+#define INFERENCE_SERVER_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int64_array.hpp>
+#include <Eigen/Dense>
+#include <unordered_map>
+#include <vector>
+#include "models/neural_network/neural_network_node.h"
+
+// Collects single-sample predict requests from many agents and runs one
+// batched forward pass per network at a flush point, optionally on a
+// WorkerThreadPool task. Results are looked up by the handle submit() returns.
+class InferenceServer : public godot::Node {
+    GDCLASS(InferenceServer, godot::Node);
+
+public:
+    enum FlushMode {
+        FLUSH_PHYSICS,
+        FLUSH_PROCESS,
+        FLUSH_MANUAL,
+    };
+
+private:
+    struct Queue {
+        int input_size = 0;
+        std::vector<float> inputs;      // row-major, one observation per row
+        std::vector<int64_t> handles;
+        uint64_t first_submit_usec = 0;
+    };
+
+    struct Batch {
+        NeuralNetworkNode::InferenceStack stack;   // shares the network's parameters
+        Eigen::MatrixXf X;
+        Eigen::MatrixXf Y;
+        std::vector<int64_t> handles;
+    };
+
+    struct Result {
+        uint64_t generation = 0;
+        godot::PackedFloat32Array values;
+    };
+
+    // Pending requests per network instance id
+    std::unordered_map<uint64_t, Queue> queues;
+
+    // Batches owned by the worker task while task_id >= 0
+    std::vector<Batch> running;
+    int64_t task_id = -1;
+
+    std::unordered_map<int64_t, Result> results;
+    uint64_t generation = 0;
+    int64_t next_handle = 1;
+    int64_t flushed_upto = 0;
+
+    FlushMode flush_mode = FLUSH_PHYSICS;
+    bool use_worker_thread = false;
+    int max_batch_size = 0;
+    double max_latency_ms = 0.0;
+
+    // Unclaimed results are dropped after this many publishes
+    static constexpr uint64_t RESULT_LIFETIME = 8;
+
+    void run_batches();
+    void collect();
+    void publish();
+    void update_processing();
+
+protected:
+    static void _bind_methods();
+    void _notification(int p_what);
+
+public:
+    InferenceServer() = default;
+    ~InferenceServer();
+
+    int64_t submit(NeuralNetworkNode *network, const godot::PackedFloat32Array &observation);
+    void flush();
+    void wait();
+
+    bool is_ready(int64_t handle) const;
+    godot::PackedFloat32Array get_result(int64_t handle);
+    int get_pending_count() const;
+
+    void set_flush_mode(FlushMode mode);
+    FlushMode get_flush_mode() const { return flush_mode; }
+    void set_use_worker_thread(bool enabled);
+    bool get_use_worker_thread() const { return use_worker_thread; }
+    void set_max_batch_size(int size);
+    int get_max_batch_size() const { return max_batch_size; }
+    void set_max_latency_ms(double ms);
+    double get_max_latency_ms() const { return max_latency_ms; }
+};
+
+VARIANT_ENUM_CAST(InferenceServer::FlushMode);
+
+#endif // INFERENCE_SERVER_H
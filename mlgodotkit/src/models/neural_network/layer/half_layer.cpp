@@ -0,0 +1,65 @@
+#include "half_layer.h"
+#include <algorithm>
+
+namespace {
+
+std::shared_ptr<const HalfWeights> shared_weights(const LayerParams &params, HalfPrecision::Format format) {
+    std::lock_guard<std::mutex> lock(params.encodings.mutex);
+    std::shared_ptr<const HalfWeights> &slot = params.encodings.half[format == HalfPrecision::BFLOAT16 ? 1 : 0];
+    if (!slot) {
+        const LayerParams::ConstMap W = params.weights_view();   // in x out, column-major
+        auto h = std::make_shared<HalfWeights>();
+        h->format = format;
+        h->values.resize(W.size());
+        HalfPrecision::encode(W.data(), W.size(), format, reinterpret_cast<uint8_t *>(h->values.data()));
+        slot = std::move(h);
+    }
+    return slot;
+}
+
+} // namespace
+
+HalfLayer HalfLayer::from_layer(const Layer& layer, HalfPrecision::Format format) {
+    const std::shared_ptr<const LayerParams> params = layer.share_params();
+    HalfLayer h;
+    h.rows = layer.get_input_size();
+    h.cols = layer.get_output_size();
+    h.weights = shared_weights(*params, format);
+    h.biases = layer.get_biases().row(0);
+    h.activation = layer.get_inplace_activation();
+    return h;
+}
+
+void HalfLayer::infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out, InferenceScratch& scratch) const {
+    out.resize(X.rows(), cols);
+
+    for (int c0 = 0; c0 < cols; c0 += PANEL_COLS) {
+        const int width = std::min(PANEL_COLS, cols - c0);
+        // Widen one contiguous block of columns, then run the fp32 GEMM on it
+        scratch.panel.resize(rows, width);
+        const uint16_t *src = weights->values.data() + static_cast<size_t>(c0) * rows;
+        HalfPrecision::decode(reinterpret_cast<const uint8_t *>(src), static_cast<int64_t>(rows) * width,
+                              weights->format, scratch.panel.data());
+        out.middleCols(c0, width).noalias() = X * scratch.panel;
+    }
+
+    out.rowwise() += biases;
+    activation.apply(out);
+}
+
+const Eigen::MatrixXf& HalfLayer::infer_stack(const std::vector<HalfLayer>& layers, const Eigen::MatrixXf& X,
+                                              InferenceScratch& scratch) {
+    const Eigen::MatrixXf *in = &X;
+    Eigen::MatrixXf *out = &scratch.a;
+    for (const HalfLayer &layer : layers) {
+        layer.infer_into(*in, *out, scratch);
+        in = out;
+        out = (out == &scratch.a) ? &scratch.b : &scratch.a;
+    }
+    return *in;
+}
+
+int64_t HalfLayer::get_byte_size() const {
+    return static_cast<int64_t>(weights->values.size()) * sizeof(uint16_t)
+         + static_cast<int64_t>(biases.size()) * sizeof(float);
+}
@@ -0,0 +1,47 @@
+#ifndef HALF_LAYER_H
+#define HALF_LAYER_H
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "models/neural_network/layer/layer.h"
+#include "utility/half_precision.h"
+
+// 16-bit encoding of one layer's weights, in the Layer's (in x out)
+// column-major layout. Cached in LayerParams::encodings.
+struct HalfWeights {
+    HalfPrecision::Format format = HalfPrecision::FLOAT16;
+    std::vector<uint16_t> values;
+};
+
+// Inference-only view of a Layer with fp16 or bf16 weights.
+// Weights keep the Layer's (in x out) column-major layout, so a block of
+// output columns is contiguous. It is widened to fp32 one panel at a time
+// right before the GEMM, which keeps the fp32 working set to a single panel.
+// The 16-bit weights are shared with every other HalfLayer built from the
+// same LayerParams in the same format.
+class HalfLayer {
+public:
+    static constexpr int PANEL_COLS = 64;
+
+    static HalfLayer from_layer(const Layer& layer, HalfPrecision::Format format);
+
+    void infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out, InferenceScratch& scratch) const;
+    static const Eigen::MatrixXf& infer_stack(const std::vector<HalfLayer>& layers, const Eigen::MatrixXf& X,
+                                              InferenceScratch& scratch);
+
+    int get_input_size() const { return rows; }
+    int get_output_size() const { return cols; }
+    // Bytes held by the parameters, counting the shared 16-bit weights
+    int64_t get_byte_size() const;
+
+private:
+    int rows = 0;
+    int cols = 0;
+    std::shared_ptr<const HalfWeights> weights;   // rows x cols
+    Eigen::RowVectorXf biases;       // tiny, kept in fp32
+    InplaceActivation activation;
+};
+
+#endif // HALF_LAYER_H
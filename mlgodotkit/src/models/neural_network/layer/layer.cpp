@@ -1,4 +1,5 @@
 #include "layer.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace Activations;
@@ -6,29 +7,66 @@ using namespace Activations;
 Layer::Layer(int input_size, int out_features, float learning_rate, const std::string& activation)
     : lr(learning_rate), activation_type(activation) {
 
-    std::tie(weights, biases) = init_weights(input_size, out_features, activation);
+    auto p = std::make_shared<LayerParams>();
+    std::tie(p->weights, p->biases) = init_weights(input_size, out_features, activation);
+    params = std::move(p);
 
-    // Initialize momentum buffers
-    mW = Eigen::MatrixXf::Zero(input_size, out_features);
-    mb = Eigen::MatrixXf::Zero(1, out_features);
+    select_activation(activation);
 
-    // Select activation
+    Logger::debug(2, "Layer initialized (" + activation +
+        ") weights=" + std::to_string(input_size) + "x" + std::to_string(out_features));
+}
+
+Layer::Layer(std::shared_ptr<const LayerParams> shared, float learning_rate, const std::string& activation)
+    : params(std::move(shared)), lr(learning_rate), activation_type(activation) {
+    select_activation(activation);
+}
+
+void Layer::select_activation(const std::string& activation) {
     if (activation == "sigmoid") {
         activation_func = sigmoid;
         derivative_func = sigmoid_derivative;
+        activation_kind = InplaceActivation::SIGMOID;
     } else if (activation == "relu") {
         activation_func = relu;
         derivative_func = relu_derivative;
+        activation_kind = InplaceActivation::RELU;
     } else if (activation == "leaky_relu") {
         activation_func = [](const Eigen::MatrixXf& x){ return leaky_relu(x, 0.01f); };
         derivative_func = [](const Eigen::MatrixXf& z){ return leaky_relu_derivative(z, 0.01f); };
+        activation_kind = InplaceActivation::LEAKY_RELU;
     } else {
         activation_func = linear;
         derivative_func = linear_derivative;
+        activation_kind = InplaceActivation::LINEAR;
     }
+}
 
-    Logger::debug(2, "Layer initialized (" + activation +
-        ") weights=" + std::to_string(input_size) + "x" + std::to_string(out_features));
+void LayerParams::materialize() {
+    if (!is_mapped())
+        return;
+    weights = weights_view();
+    biases = biases_view();
+    mapped_weights = nullptr;
+    mapped_biases = nullptr;
+    backing.reset();
+}
+
+void LayerParams::Encodings::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    half[0].reset();
+    half[1].reset();
+    int8.reset();
+}
+
+LayerParams &Layer::mutable_params() {
+    if (params.use_count() > 1)
+        params = std::make_shared<LayerParams>(*params);
+    // Sole owner at this point, so writing through the pointer is safe
+    LayerParams &p = const_cast<LayerParams &>(*params);
+    p.materialize();
+    p.encodings.clear();
+    return p;
 }
 
 Layer::~Layer() {}
@@ -51,7 +89,7 @@ Eigen::MatrixXf Layer::forward(const Eigen::MatrixXf& X) {
     input = X;
 
     // z = XW + b (bias broadcast)
-	Eigen::MatrixXf z = (X * weights).rowwise() + biases.row(0);
+	Eigen::MatrixXf z = (X * params->weights_view()).rowwise() + params->biases_view().row(0);
 
 
     // Apply activation
@@ -70,10 +108,69 @@ Eigen::MatrixXf Layer::forward(const Eigen::MatrixXf& X) {
     return output;
 }
 
+Eigen::MatrixXf Layer::infer(const Eigen::MatrixXf& X) const {
+    Eigen::MatrixXf out;
+    infer_into(X, out);
+    return out;
+}
+
+void Layer::infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out) const {
+    out.noalias() = X * params->weights_view();
+    out.rowwise() += params->biases_view().row(0);
+    get_inplace_activation().apply(out);
+}
+
+InplaceActivation Layer::get_inplace_activation() const {
+    InplaceActivation act;
+    act.kind = activation_kind;
+    act.squash = squash_enabled;
+    act.scale_in = squash_scale_in;
+    act.scale_out = squash_scale_out;
+    return act;
+}
+
+void InplaceActivation::apply(Eigen::Ref<Eigen::MatrixXf> z) const {
+    if (squash) {
+        z.array() = (z.array() / scale_in).tanh() * scale_out;
+        return;
+    }
+
+    // In-place equivalents of the Activations functions used by forward()
+    switch (kind) {
+        case RELU:
+            z = z.cwiseMax(0.0f);
+            break;
+        case LEAKY_RELU:
+            z = z.unaryExpr([](float v) { return v > 0.0f ? v : 0.01f * v; });
+            break;
+        case SIGMOID:
+            z = z.unaryExpr([](float v) {
+                const float e = std::exp(-std::abs(v));
+                const float s = v >= 0.0f ? 1.0f / (1.0f + e) : e / (1.0f + e);
+                return std::min(std::max(s, 1e-6f), 1.0f - 1e-6f);
+            });
+            break;
+        case LINEAR:
+            break;
+    }
+}
+
+const Eigen::MatrixXf& Layer::infer_stack(const std::vector<Layer>& layers, const Eigen::MatrixXf& X,
+                                          InferenceScratch& scratch) {
+    const Eigen::MatrixXf *in = &X;
+    Eigen::MatrixXf *out = &scratch.a;
+    for (const Layer &layer : layers) {
+        layer.infer_into(*in, *out);
+        in = out;
+        out = (out == &scratch.a) ? &scratch.b : &scratch.a;
+    }
+    return *in;
+}
+
 Eigen::MatrixXf Layer::backward_compute(const Eigen::MatrixXf& loss_grad) {
     if (loss_grad.size() == 0 || !loss_grad.allFinite()) {
         Logger::warn("Layer::backward_compute - invalid gradient input");
-        return Eigen::MatrixXf::Zero(input.rows(), weights.rows());
+        return Eigen::MatrixXf::Zero(input.rows(), get_input_size());
     }
 
     // Activation derivative
@@ -99,7 +196,7 @@ Eigen::MatrixXf Layer::backward_compute(const Eigen::MatrixXf& loss_grad) {
 	db /= static_cast<float>(input.rows());
 
     // Return for chain rule
-    return delta * weights.transpose();
+    return delta * params->weights_view().transpose();
 }
 
 void Layer::normalize_gradients(float scale) {
@@ -107,21 +204,57 @@ void Layer::normalize_gradients(float scale) {
     db *= scale;
 }
 
+void Layer::accumulate_gradients(const Layer& other) {
+    dW += other.dW;
+    db += other.db;
+}
+
+void Layer::take_gradients(Layer& other) {
+    dW = std::move(other.dW);
+    db = std::move(other.db);
+}
+
 void Layer::apply_update() {
     const float beta = 0.9f;           // momentum
     const float weight_decay = 1e-4f;  // L2 regularization
 
+    if (mW.size() == 0) {
+        mW = Eigen::MatrixXf::Zero(dW.rows(), dW.cols());
+        mb = Eigen::MatrixXf::Zero(db.rows(), db.cols());
+    }
+
     // Momentum update (per layer)
     mW = beta * mW + (1.0f - beta) * dW;
     mb = beta * mb + (1.0f - beta) * db;
 
-    weights -= lr * (mW + weight_decay * weights);
-    biases  -= lr * (mb + 1e-6f * biases);
+    LayerParams &p = mutable_params();
+    p.weights -= lr * (mW + weight_decay * p.weights);
+    p.biases  -= lr * (mb + 1e-6f * p.biases);
+}
+
+void Layer::set_momentum(const Eigen::MatrixXf& weights, const Eigen::MatrixXf& biases) {
+    mW = weights;
+    mb = biases;
 }
 
 void Layer::copy_weights(const Layer& src) {
-    weights = src.weights;
-    biases  = src.biases;
+    // Shares the source's parameters; the next update of either side copies
+    params = src.params;
+}
+
+void Layer::set_params(std::shared_ptr<const LayerParams> p) {
+    params = std::move(p);
+    mW.resize(0, 0);
+    mb.resize(0, 0);
+}
+
+Layer Layer::shallow_copy() const {
+    Layer out(params, lr, activation_type);
+    out.squash_enabled = squash_enabled;
+    out.squash_scale_in = squash_scale_in;
+    out.squash_scale_out = squash_scale_out;
+    out.verbosity = verbosity;
+    return out;
 }
 
 void Layer::set_learning_rate(float learning_rate) { lr = learning_rate; }
@@ -132,5 +265,5 @@ void Layer::set_output_squash(bool enabled, float scale_in, float scale_out) {
     squash_scale_out = (scale_out <= 0.0f ? 10.0f : scale_out);
 }
 
-int Layer::get_input_size() const { return weights.rows(); }
-int Layer::get_output_size() const { return weights.cols(); }
\ No newline at end of file
+int Layer::get_input_size() const { return params->weights_view().rows(); }
+int Layer::get_output_size() const { return params->weights_view().cols(); }
\ No newline at end of file
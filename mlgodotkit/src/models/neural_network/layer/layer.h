@@ -2,18 +2,99 @@
 #define LAYER_H
 
 #include <Eigen/Dense>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <vector>
 #include "utility/logger.h"
 #include <models/neural_network/activations/activations.h>
 
-class Layer {
-private:
-    // Parameters
+struct HalfWeights;   // half_layer.h
+struct Int8Weights;   // quantized_layer.h
+
+// Trainable parameters of one layer. Held through a shared pointer so many
+// layers (nodes, NeuralModel resources) can share one copy until one of them
+// writes to it.
+struct LayerParams {
+    using ConstMap = Eigen::Map<const Eigen::MatrixXf>;
+
     Eigen::MatrixXf weights;
     Eigen::MatrixXf biases;
 
+    // Set when the parameters are read in place from a memory-mapped
+    // checkpoint. The matrices above stay empty until the first write, when
+    // Layer::mutable_params() copies the data out (materialize()).
+    std::shared_ptr<const void> backing;
+    const float *mapped_weights = nullptr;
+    const float *mapped_biases = nullptr;
+    int mapped_rows = 0;
+    int mapped_cols = 0;
+
+    bool is_mapped() const { return mapped_weights != nullptr; }
+    // Read access that works for both owned and mapped storage
+    ConstMap weights_view() const {
+        return is_mapped() ? ConstMap(mapped_weights, mapped_rows, mapped_cols)
+                           : ConstMap(weights.data(), weights.rows(), weights.cols());
+    }
+    ConstMap biases_view() const {
+        return is_mapped() ? ConstMap(mapped_biases, 1, mapped_cols)
+                           : ConstMap(biases.data(), biases.rows(), biases.cols());
+    }
+    void materialize();
+
+    // Inference-only encodings of the weights (HalfLayer, QuantizedLayer).
+    // Built on first use and shared by every layer that references these
+    // parameters, so nodes sharing a model also share one 16-bit or int8
+    // copy. They come on top of the fp32 weights above, which stay for
+    // training, export and fp32 inference. Copies start without them, and
+    // Layer::mutable_params() drops them before a write.
+    struct Encodings {
+        std::mutex mutex;
+        std::shared_ptr<const HalfWeights> half[2];   // FLOAT16, BFLOAT16
+        std::shared_ptr<const Int8Weights> int8;
+
+        Encodings() = default;
+        Encodings(const Encodings &) {}
+        Encodings &operator=(const Encodings &) { clear(); return *this; }
+        void clear();
+    };
+    mutable Encodings encodings;
+};
+
+// Element-wise activation applied in place by the allocation-free inference
+// paths; mirrors what Layer::forward() computes.
+struct InplaceActivation {
+    enum Kind { LINEAR, RELU, LEAKY_RELU, SIGMOID };
+    Kind kind = LINEAR;
+    bool squash = false;
+    float scale_in = 10.0f;
+    float scale_out = 10.0f;
+
+    // Also takes a block of contiguous columns (QuantizedLayer's epilogue)
+    void apply(Eigen::Ref<Eigen::MatrixXf> z) const;
+};
+
+// Ping-pong activation buffers for Layer::infer_stack(). Owned by the caller
+// (or thread-local) so inference never writes to the layers themselves.
+struct InferenceScratch {
+    Eigen::MatrixXf a;
+    Eigen::MatrixXf b;
+    // Quantized input rows and their scales (QuantizedLayer); int8 values
+    // held as int16 so the kernel can feed them straight to pmaddwd
+    std::vector<int16_t> q;
+    std::vector<float> q_scales;   // scales, then their reciprocals
+    // fp32 copy of one 16-bit weight panel (HalfLayer)
+    Eigen::MatrixXf panel;
+};
+
+class Layer {
+private:
+    // Parameters, shared copy-on-write
+    std::shared_ptr<const LayerParams> params;
+
     // Cached forward data
     Eigen::MatrixXf input;
     Eigen::MatrixXf output;
@@ -23,7 +104,7 @@ private:
     Eigen::MatrixXf dW;
     Eigen::MatrixXf db;
 
-    // Momentum buffers (per layer)
+    // Momentum buffers (per layer), allocated on the first update
     Eigen::MatrixXf mW;
     Eigen::MatrixXf mb;
 
@@ -34,6 +115,9 @@ private:
     float squash_scale_out = 10.0f;
     std::string activation_type;
 
+    // Activation kind for the allocation-free inference path
+    InplaceActivation::Kind activation_kind = InplaceActivation::LINEAR;
+
     // Activation functions
     std::function<Eigen::MatrixXf(const Eigen::MatrixXf&)> activation_func;
     std::function<Eigen::MatrixXf(const Eigen::MatrixXf&)> derivative_func;
@@ -42,16 +126,34 @@ public:
     int verbosity = 0;
 
     Layer(int input_size, int out_features, float learning_rate, const std::string& activation);
+    Layer(std::shared_ptr<const LayerParams> shared, float learning_rate, const std::string& activation);
     ~Layer();
 
     // Core
     Eigen::MatrixXf forward(const Eigen::MatrixXf& X);
+    // Forward pass without caching anything in the layer; safe to call concurrently
+    Eigen::MatrixXf infer(const Eigen::MatrixXf& X) const;
+    // Same, writing into out (which must not alias X); reuses out's storage
+    void infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out) const;
+    // Runs a whole stack; the result lives in one of the scratch buffers
+    static const Eigen::MatrixXf& infer_stack(const std::vector<Layer>& layers, const Eigen::MatrixXf& X,
+                                              InferenceScratch& scratch);
     Eigen::MatrixXf backward_compute(const Eigen::MatrixXf& loss_grad);
     void apply_update();
     void normalize_gradients(float scale);
+    // Gradient reduction across data-parallel replicas
+    void accumulate_gradients(const Layer& other);
+    void take_gradients(Layer& other);
 
     // Utilities
     void copy_weights(const Layer& source);
+    std::shared_ptr<const LayerParams> share_params() const { return params; }
+    // Replaces the parameters (same shape) and drops the optimizer state
+    void set_params(std::shared_ptr<const LayerParams> p);
+    // Layer with the same configuration that shares this layer's parameters
+    // but none of its caches, gradients or optimizer state
+    Layer shallow_copy() const;
+    bool is_shared() const { return params.use_count() > 1 || params->is_mapped(); }
     void set_learning_rate(float lr);
     void set_verbosity(int v);
     void set_output_squash(bool enabled, float scale_in, float scale_out);
@@ -60,13 +162,22 @@ public:
     int get_input_size() const;
     int get_output_size() const;
     std::string get_activation_type() const { return activation_type; }
-    Eigen::MatrixXf get_weights() const { return weights; }
-    Eigen::MatrixXf get_biases() const { return biases; }
+    InplaceActivation get_inplace_activation() const;
+    Eigen::MatrixXf get_weights() const { return params->weights_view(); }
+    Eigen::MatrixXf get_biases() const { return params->biases_view(); }
     Eigen::MatrixXf get_dW() const { return dW; }
     Eigen::MatrixXf get_db() const { return db; }
+    // Optimizer state (momentum); empty until the first update
+    const Eigen::MatrixXf& get_momentum_weights() const { return mW; }
+    const Eigen::MatrixXf& get_momentum_biases() const { return mb; }
+    void set_momentum(const Eigen::MatrixXf& weights, const Eigen::MatrixXf& biases);
 
 private:
     std::tuple<Eigen::MatrixXf, Eigen::MatrixXf> init_weights(int in, int out, const std::string& activation);
+    void select_activation(const std::string& activation);
+
+    // Detaches from other holders of the parameters before they are written
+    LayerParams &mutable_params();
 };
 
 #endif // LAYER_H
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "quantized_layer.h"
+#include "utility/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QUANTIZED_LAYER_SSE2
+#endif
+
+namespace {
+
+// Kernel block: BLOCK_ROWS input rows against BLOCK_OUT weight rows. The
+// weights are widened once per step and reused for every row, and each
+// output channel's BLOCK_ROWS sums come out as one contiguous column segment.
+constexpr int BLOCK_ROWS = 4;
+constexpr int BLOCK_OUT = 2;
+
+// Round to nearest even without a libm call: adding 1.5 * 2^23 pushes the
+// fraction out of the mantissa (exact for the clamped range)
+inline int8_t quantize_value(float v, float inv_scale) {
+    const float clamped = std::min(127.0f, std::max(-127.0f, v * inv_scale));
+    constexpr float ROUNDER = 12582912.0f;
+    return static_cast<int8_t>((clamped + ROUNDER) - ROUNDER);
+}
+
+inline int32_t dot(const int16_t *x, const int8_t *w, int begin, int end) {
+    int32_t acc = 0;
+    for (int i = begin; i < end; ++i)
+        acc += static_cast<int32_t>(x[i]) * static_cast<int32_t>(w[i]);
+    return acc;
+}
+
+#ifdef QUANTIZED_LAYER_SSE2
+// Eight int8 weights sign-extended to int16
+inline __m128i load_weights(const int8_t *w) {
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(w));
+    return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+}
+
+inline __m128i madd(__m128i acc, const int16_t *x, __m128i w) {
+    return _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x)), w));
+}
+
+// Horizontal sums of four accumulators, as one vector
+inline __m128i reduce4(__m128i a0, __m128i a1, __m128i a2, __m128i a3) {
+    const __m128i s0 = _mm_add_epi32(_mm_unpacklo_epi32(a0, a1), _mm_unpackhi_epi32(a0, a1));
+    const __m128i s1 = _mm_add_epi32(_mm_unpacklo_epi32(a2, a3), _mm_unpackhi_epi32(a2, a3));
+    return _mm_add_epi32(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+}
+#endif
+
+// Quantizes X (column-major) into row-major int8 values held as int16:
+// q[r * in + i] = round(X(r, i) / scale[r]), clamped to [-127, 127]
+void quantize_rows(const Eigen::MatrixXf &X, const float *inv_scales, int16_t *q) {
+    const int rows = X.rows();
+    const int in = X.cols();
+    int r0 = 0;
+#ifdef QUANTIZED_LAYER_SSE2
+    // Four rows by eight columns at a time: 4x4 transposes turn column
+    // segments into row segments, and cvtps rounds to nearest even
+    const __m128 lo = _mm_set1_ps(-127.0f);
+    const __m128 hi = _mm_set1_ps(127.0f);
+    for (; r0 + 4 <= rows; r0 += 4) {
+        const __m128 inv = _mm_loadu_ps(inv_scales + r0);
+        int i = 0;
+        for (; i + 8 <= in; i += 8) {
+            __m128i half[2][4];
+            for (int h = 0; h < 2; ++h) {
+                __m128 c0 = _mm_mul_ps(_mm_loadu_ps(&X(r0, i + 4 * h + 0)), inv);
+                __m128 c1 = _mm_mul_ps(_mm_loadu_ps(&X(r0, i + 4 * h + 1)), inv);
+                __m128 c2 = _mm_mul_ps(_mm_loadu_ps(&X(r0, i + 4 * h + 2)), inv);
+                __m128 c3 = _mm_mul_ps(_mm_loadu_ps(&X(r0, i + 4 * h + 3)), inv);
+                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+                half[h][0] = _mm_cvtps_epi32(_mm_min_ps(hi, _mm_max_ps(lo, c0)));
+                half[h][1] = _mm_cvtps_epi32(_mm_min_ps(hi, _mm_max_ps(lo, c1)));
+                half[h][2] = _mm_cvtps_epi32(_mm_min_ps(hi, _mm_max_ps(lo, c2)));
+                half[h][3] = _mm_cvtps_epi32(_mm_min_ps(hi, _mm_max_ps(lo, c3)));
+            }
+            for (int k = 0; k < 4; ++k)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(q + static_cast<size_t>(r0 + k) * in + i),
+                                 _mm_packs_epi32(half[0][k], half[1][k]));
+        }
+        for (; i < in; ++i)
+            for (int k = 0; k < 4; ++k)
+                q[static_cast<size_t>(r0 + k) * in + i] = quantize_value(X(r0 + k, i), inv_scales[r0 + k]);
+    }
+#endif
+    for (int r = r0; r < rows; ++r) {
+        int16_t *dst = q + static_cast<size_t>(r) * in;
+        for (int i = 0; i < in; ++i)
+            dst[i] = quantize_value(X(r, i), inv_scales[r]);
+    }
+}
+
+// acc[o][r] = dot(x row r, weight row o) for one full block. Inputs are in
+// [-127, 127], so the int16 pair sums (pmaddwd) cannot overflow int32.
+inline void dot_block(const int16_t *x, const int8_t *w, int in, int32_t acc[BLOCK_OUT][BLOCK_ROWS]) {
+    const int8_t *w0 = w;
+    const int8_t *w1 = w0 + in;
+    int i = 0;
+#ifdef QUANTIZED_LAYER_SSE2
+    const int16_t *x0 = x;
+    const int16_t *x1 = x0 + in;
+    const int16_t *x2 = x1 + in;
+    const int16_t *x3 = x2 + in;
+    __m128i a00 = _mm_setzero_si128(), a01 = a00, a02 = a00, a03 = a00;
+    __m128i a10 = a00, a11 = a00, a12 = a00, a13 = a00;
+    for (; i + 8 <= in; i += 8) {
+        const __m128i v0 = load_weights(w0 + i);
+        const __m128i v1 = load_weights(w1 + i);
+        a00 = madd(a00, x0 + i, v0);
+        a10 = madd(a10, x0 + i, v1);
+        a01 = madd(a01, x1 + i, v0);
+        a11 = madd(a11, x1 + i, v1);
+        a02 = madd(a02, x2 + i, v0);
+        a12 = madd(a12, x2 + i, v1);
+        a03 = madd(a03, x3 + i, v0);
+        a13 = madd(a13, x3 + i, v1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc[0]), reduce4(a00, a01, a02, a03));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc[1]), reduce4(a10, a11, a12, a13));
+#else
+    for (int o = 0; o < BLOCK_OUT; ++o)
+        for (int r = 0; r < BLOCK_ROWS; ++r)
+            acc[o][r] = 0;
+#endif
+    // Tail (or everything, without SSE2)
+    for (int r = 0; r < BLOCK_ROWS; ++r) {
+        const int16_t *xr = x + static_cast<size_t>(r) * in;
+        acc[0][r] += dot(xr, w0, i, in);
+        acc[1][r] += dot(xr, w1, i, in);
+    }
+}
+
+std::shared_ptr<const Int8Weights> shared_weights(const LayerParams &params) {
+    std::lock_guard<std::mutex> lock(params.encodings.mutex);
+    std::shared_ptr<const Int8Weights> &slot = params.encodings.int8;
+    if (slot)
+        return slot;
+
+    const LayerParams::ConstMap W = params.weights_view();   // in x out
+    auto q = std::make_shared<Int8Weights>();
+    q->values.resize(W.cols(), W.rows());
+    q->scales.resize(W.cols());
+    for (int o = 0; o < W.cols(); ++o) {
+        const float max_abs = W.col(o).cwiseAbs().maxCoeff();
+        const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+        const float inv = 1.0f / scale;
+        for (int i = 0; i < W.rows(); ++i)
+            q->values(o, i) = quantize_value(W(i, o), inv);
+        q->scales(o) = scale;
+    }
+    slot = std::move(q);
+    return slot;
+}
+
+} // namespace
+
+QuantizedLayer QuantizedLayer::from_layer(const Layer& layer, float input_range) {
+    const std::shared_ptr<const LayerParams> params = layer.share_params();
+    QuantizedLayer q;
+    q.weights = shared_weights(*params);
+    q.biases = layer.get_biases().row(0);
+    q.input_scale = input_range > 0.0f ? input_range / 127.0f : 0.0f;
+    q.activation = layer.get_inplace_activation();
+    return q;
+}
+
+void QuantizedLayer::infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out, InferenceScratch& scratch) const {
+    const int rows = X.rows();
+    const int in = weights->values.cols();
+    const int n_out = weights->values.rows();
+    const Eigen::VectorXf &weight_scales = weights->scales;
+
+    // Per-row input scales, then one contiguous quantized row per sample
+    scratch.q.resize(static_cast<size_t>(rows) * in);
+    scratch.q_scales.resize(static_cast<size_t>(rows) * 2);
+    float *scales = scratch.q_scales.data();
+    float *inv_scales = scales + rows;
+    if (input_scale > 0.0f) {
+        std::fill(scales, scales + rows, input_scale);
+    } else {
+        const Eigen::VectorXf max_abs = X.cwiseAbs().rowwise().maxCoeff();
+        for (int r = 0; r < rows; ++r)
+            scales[r] = max_abs(r) > 0.0f ? max_abs(r) / 127.0f : 1.0f;
+    }
+    for (int r = 0; r < rows; ++r)
+        inv_scales[r] = 1.0f / scales[r];
+    quantize_rows(X, inv_scales, scratch.q.data());
+
+    out.resize(rows, n_out);
+    const int16_t *xq = scratch.q.data();
+    const float *x_scales = scales;
+    const int full_rows = rows - rows % BLOCK_ROWS;
+    const int blocks = (n_out + BLOCK_OUT - 1) / BLOCK_OUT;
+
+    // Fused epilogue: each value is dequantized and biased as it is written
+    // to its (contiguous) output column; a finished block of columns then
+    // gets the activation while it is still in cache
+    auto finish = [&](int o, int r, int32_t acc) {
+        out(r, o) = static_cast<float>(acc) * (x_scales[r] * weight_scales(o)) + biases(o);
+    };
+
+    // Work is split over output channels; each block's weight rows stay in
+    // cache while all input rows stream past. Aim for roughly 32k
+    // multiply-adds per chunk before paying for a thread.
+    const int min_chunk = std::max(1, 32768 / (rows * in * BLOCK_OUT + 1));
+    ThreadPool::parallel_for(blocks, min_chunk, [&](int begin, int end) {
+        int32_t acc[BLOCK_OUT][BLOCK_ROWS];
+        for (int b = begin; b < end; ++b) {
+            const int o0 = b * BLOCK_OUT;
+            const int8_t *w = weights->values.data() + static_cast<size_t>(o0) * in;
+            const int width = std::min(BLOCK_OUT, n_out - o0);
+            if (width == BLOCK_OUT) {
+                for (int r = 0; r < full_rows; r += BLOCK_ROWS) {
+                    dot_block(xq + static_cast<size_t>(r) * in, w, in, acc);
+                    for (int o = 0; o < BLOCK_OUT; ++o)
+                        for (int k = 0; k < BLOCK_ROWS; ++k)
+                            finish(o0 + o, r + k, acc[o][k]);
+                }
+            }
+            // Leftover rows, or the last partial block
+            for (int o = 0; o < width; ++o)
+                for (int r = width == BLOCK_OUT ? full_rows : 0; r < rows; ++r)
+                    finish(o0 + o, r, dot(xq + static_cast<size_t>(r) * in, w + static_cast<size_t>(o) * in, 0, in));
+            activation.apply(out.middleCols(o0, width));
+        }
+    });
+}
+
+const Eigen::MatrixXf& QuantizedLayer::infer_stack(const std::vector<QuantizedLayer>& layers, const Eigen::MatrixXf& X,
+                                                   InferenceScratch& scratch) {
+    const Eigen::MatrixXf *in = &X;
+    Eigen::MatrixXf *out = &scratch.a;
+    for (const QuantizedLayer &layer : layers) {
+        layer.infer_into(*in, *out, scratch);
+        in = out;
+        out = (out == &scratch.a) ? &scratch.b : &scratch.a;
+    }
+    return *in;
+}
+
+int64_t QuantizedLayer::get_byte_size() const {
+    return static_cast<int64_t>(weights->values.size()) * sizeof(int8_t)
+         + static_cast<int64_t>(weights->scales.size() + biases.size()) * sizeof(float);
+}
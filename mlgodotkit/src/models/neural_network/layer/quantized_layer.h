@@ -0,0 +1,47 @@
+#ifndef QUANTIZED_LAYER_H
+#define QUANTIZED_LAYER_H
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "models/neural_network/layer/layer.h"
+
+// Symmetric per-output-channel int8 encoding of one layer's weights,
+// transposed to (out x in). Cached in LayerParams::encodings.
+struct Int8Weights {
+    using Matrix = Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    Matrix values;
+    Eigen::VectorXf scales;   // one per output channel
+};
+
+// Post-training int8 view of a Layer for inference only.
+// Weights are symmetric per output channel and stored transposed, so each
+// channel is one contiguous int8 row. Inputs are quantized per row (or with
+// a calibrated per-tensor range), products accumulate in int32 and the
+// dequantize is fused with the bias and activation. The int8 weights are
+// shared with every other QuantizedLayer built from the same LayerParams;
+// the calibrated input range stays per layer.
+class QuantizedLayer {
+public:
+    // input_range <= 0 selects dynamic per-row input scaling
+    static QuantizedLayer from_layer(const Layer& layer, float input_range);
+
+    void infer_into(const Eigen::MatrixXf& X, Eigen::MatrixXf& out, InferenceScratch& scratch) const;
+    static const Eigen::MatrixXf& infer_stack(const std::vector<QuantizedLayer>& layers, const Eigen::MatrixXf& X,
+                                              InferenceScratch& scratch);
+
+    int get_input_size() const { return weights->values.cols(); }
+    int get_output_size() const { return weights->values.rows(); }
+    // Bytes held by the quantized parameters, counting the shared weights
+    int64_t get_byte_size() const;
+
+private:
+    std::shared_ptr<const Int8Weights> weights;
+    Eigen::RowVectorXf biases;
+    float input_scale = 0.0f;        // 0 = dynamic per row
+    InplaceActivation activation;
+};
+
+#endif // QUANTIZED_LAYER_H
@@ -0,0 +1,148 @@
+#include "neural_model.h"
+#include "utility/logger.h"
+#include "utility/half_precision.h"
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+
+void NeuralModel::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_method(D_METHOD("get_layer_count"), &NeuralModel::get_layer_count);
+    ClassDB::bind_method(D_METHOD("get_input_size"), &NeuralModel::get_input_size);
+    ClassDB::bind_method(D_METHOD("get_output_size"), &NeuralModel::get_output_size);
+    ClassDB::bind_method(D_METHOD("get_parameter_count"), &NeuralModel::get_parameter_count);
+    ClassDB::bind_method(D_METHOD("set_layer_data", "data"), &NeuralModel::set_layer_data);
+    ClassDB::bind_method(D_METHOD("get_layer_data"), &NeuralModel::get_layer_data);
+    ClassDB::bind_method(D_METHOD("set_storage_format", "format"), &NeuralModel::set_storage_format);
+    ClassDB::bind_method(D_METHOD("get_storage_format"), &NeuralModel::get_storage_format);
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "storage_format",
+        PROPERTY_HINT_ENUM, "Float32,Float16,BFloat16"),
+        "set_storage_format", "get_storage_format");
+
+    ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "layer_data",
+        PROPERTY_HINT_NONE, "",
+        PROPERTY_USAGE_STORAGE),
+        "set_layer_data", "get_layer_data");
+
+    BIND_ENUM_CONSTANT(WEIGHTS_FLOAT32);
+    BIND_ENUM_CONSTANT(WEIGHTS_FLOAT16);
+    BIND_ENUM_CONSTANT(WEIGHTS_BFLOAT16);
+}
+
+void NeuralModel::set_storage_format(WeightFormat format) {
+    ERR_FAIL_COND_MSG(format < WEIGHTS_FLOAT32 || format > WEIGHTS_BFLOAT16, "NeuralModel - unknown storage format");
+    storage_format = format;
+}
+
+godot::Ref<NeuralModel> NeuralModel::from_layers(const std::vector<Layer> &layers) {
+    godot::Ref<NeuralModel> out;
+    out.instantiate();
+    out->specs.reserve(layers.size());
+    for (const Layer &layer : layers)
+        out->specs.push_back({ layer.get_activation_type(), layer.share_params() });
+    return out;
+}
+
+int NeuralModel::get_input_size() const {
+    return specs.empty() ? 0 : specs.front().params->weights_view().rows();
+}
+
+int NeuralModel::get_output_size() const {
+    return specs.empty() ? 0 : specs.back().params->weights_view().cols();
+}
+
+int NeuralModel::get_parameter_count() const {
+    int count = 0;
+    for (const LayerSpec &s : specs)
+        count += s.params->weights_view().size() + s.params->biases_view().size();
+    return count;
+}
+
+void NeuralModel::set_layer_data(const godot::Array &data) {
+    using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    std::vector<LayerSpec> parsed;
+    parsed.reserve(data.size());
+    WeightFormat format = WEIGHTS_FLOAT32;
+
+    for (int i = 0; i < data.size(); ++i) {
+        godot::Dictionary d = data[i];
+        const int in = (int)d.get("input_size", 0);
+        const int out = (int)d.get("output_size", 0);
+        const godot::PackedFloat32Array b = d.get("biases", godot::PackedFloat32Array());
+        format = static_cast<WeightFormat>((int)d.get("format", WEIGHTS_FLOAT32));
+
+        if (in < 1 || out < 1 || b.size() != out || format < WEIGHTS_FLOAT32 || format > WEIGHTS_BFLOAT16) {
+            Logger::error_raise("NeuralModel::set_layer_data - malformed layer " + std::to_string(i));
+            return;
+        }
+        if (!parsed.empty() && parsed.back().params->weights_view().cols() != in) {
+            Logger::error_raise("NeuralModel::set_layer_data - layer " + std::to_string(i) + " input size mismatch");
+            return;
+        }
+
+        // Weights are stored row-major (input_size x output_size)
+        auto p = std::make_shared<LayerParams>();
+        if (format == WEIGHTS_FLOAT32) {
+            const godot::PackedFloat32Array w = d.get("weights", godot::PackedFloat32Array());
+            if (w.size() != in * out) {
+                Logger::error_raise("NeuralModel::set_layer_data - malformed layer " + std::to_string(i));
+                return;
+            }
+            p->weights = Eigen::Map<const RowMat>(w.ptr(), in, out);
+        } else {
+            const godot::PackedByteArray w = d.get("weights", godot::PackedByteArray());
+            if (w.size() != int64_t(in) * out * HalfPrecision::value_size(HalfPrecision::Format(format))) {
+                Logger::error_raise("NeuralModel::set_layer_data - malformed layer " + std::to_string(i));
+                return;
+            }
+            RowMat W(in, out);
+            HalfPrecision::decode(w.ptr(), W.size(), HalfPrecision::Format(format), W.data());
+            p->weights = W;
+        }
+        p->biases = Eigen::Map<const Eigen::MatrixXf>(b.ptr(), 1, out);
+
+        godot::String act = d.get("activation", "linear");
+        parsed.push_back({ act.utf8().get_data(), std::move(p) });
+    }
+
+    specs = std::move(parsed);
+    // Re-saving keeps the encoding the data came in
+    storage_format = format;
+    emit_changed();
+}
+
+godot::Array NeuralModel::get_layer_data() const {
+    using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    godot::Array out;
+    for (const LayerSpec &s : specs) {
+        const LayerParams::ConstMap W = s.params->weights_view();
+        const LayerParams::ConstMap b = s.params->biases_view();
+
+        godot::PackedFloat32Array bias;
+        bias.resize(b.size());
+        Eigen::Map<Eigen::MatrixXf>(bias.ptrw(), 1, b.cols()) = b;
+
+        godot::Dictionary d;
+        d["activation"] = godot::String(s.activation.c_str());
+        d["input_size"] = static_cast<int>(W.rows());
+        d["output_size"] = static_cast<int>(W.cols());
+        d["biases"] = bias;
+
+        if (storage_format == WEIGHTS_FLOAT32) {
+            godot::PackedFloat32Array w;
+            w.resize(W.size());
+            Eigen::Map<RowMat>(w.ptrw(), W.rows(), W.cols()) = W;
+            d["weights"] = w;
+        } else {
+            const RowMat rm = W;
+            godot::PackedByteArray w;
+            w.resize(rm.size() * HalfPrecision::value_size(HalfPrecision::Format(storage_format)));
+            HalfPrecision::encode(rm.data(), rm.size(), HalfPrecision::Format(storage_format), w.ptrw());
+            d["weights"] = w;
+            d["format"] = static_cast<int>(storage_format);
+        }
+        out.push_back(d);
+    }
+    return out;
+}
@@ -0,0 +1,67 @@
+#ifndef NEURAL_MODEL_H
+#define NEURAL_MODEL_H
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "models/neural_network/layer/layer.h"
+
+// Immutable network weights that can be shared by any number of
+// NeuralNetworkNodes. Nodes reference the parameters instead of copying them;
+// a node that starts training copies only the layers it writes to.
+class NeuralModel : public godot::Resource {
+    GDCLASS(NeuralModel, godot::Resource);
+
+public:
+    // Values match HalfPrecision::Format
+    enum WeightFormat {
+        WEIGHTS_FLOAT32 = 0,
+        WEIGHTS_FLOAT16 = 1,
+        WEIGHTS_BFLOAT16 = 2,
+    };
+
+    struct LayerSpec {
+        std::string activation;
+        std::shared_ptr<const LayerParams> params;
+    };
+
+private:
+    std::vector<LayerSpec> specs;
+    WeightFormat storage_format = WEIGHTS_FLOAT32;
+
+protected:
+    static void _bind_methods();
+
+public:
+    NeuralModel() = default;
+
+    // Snapshot of a layer stack; shares the parameters, no copy is made
+    static godot::Ref<NeuralModel> from_layers(const std::vector<Layer> &layers);
+
+    const std::vector<LayerSpec> &get_specs() const { return specs; }
+
+    int get_layer_count() const { return static_cast<int>(specs.size()); }
+    int get_input_size() const;
+    int get_output_size() const;
+    int get_parameter_count() const;
+
+    // Encoding of the weights in layer_data. Parameters in memory stay fp32
+    // (training and export need them); 16-bit inference copies are built
+    // and shared through LayerParams::encodings.
+    void set_storage_format(WeightFormat format);
+    WeightFormat get_storage_format() const { return storage_format; }
+
+    // Serialized form, one Dictionary per layer:
+    // { activation, input_size, output_size, weights, biases }
+    // With a 16-bit storage_format, weights is a PackedByteArray of
+    // 16-bit values and the layer carries a "format" key.
+    void set_layer_data(const godot::Array &data);
+    godot::Array get_layer_data() const;
+};
+
+VARIANT_ENUM_CAST(NeuralModel::WeightFormat);
+
+#endif // NEURAL_MODEL_H
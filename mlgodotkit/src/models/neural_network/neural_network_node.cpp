@@ -1,6 +1,14 @@
 #include "neural_network_node.h"
 #include "utility/logger.h"
 #include "utility/utils.h"
+#include "utility/thread_pool.h"
+#include "models/neural_network/checkpoint.h"
+#include "utility/npy.h"
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
@@ -8,7 +16,21 @@
 using namespace Utils;
 
 NeuralNetworkNode::NeuralNetworkNode() {}
-NeuralNetworkNode::~NeuralNetworkNode() {}
+NeuralNetworkNode::~NeuralNetworkNode() {
+    // The training task references this node
+    if (task_id >= 0)
+        godot::WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+
+    // Let the writer finish what is queued, then stop it
+    if (checkpoint_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(checkpoint_mutex);
+            checkpoint_stop = true;
+        }
+        checkpoint_cv.notify_all();
+        checkpoint_thread.join();
+    }
+}
 
 void NeuralNetworkNode::_bind_methods() {
     using namespace godot;
@@ -16,8 +38,18 @@ void NeuralNetworkNode::_bind_methods() {
     ClassDB::bind_method(D_METHOD("forward", "input"), &NeuralNetworkNode::forward);
     ClassDB::bind_method(D_METHOD("backward", "error"), &NeuralNetworkNode::backward);
     ClassDB::bind_method(D_METHOD("predict", "input"), &NeuralNetworkNode::predict);
+    ClassDB::bind_method(D_METHOD("predict_matrix", "input"), &NeuralNetworkNode::predict_matrix);
+    ClassDB::bind_method(D_METHOD("predict_packed", "input"), &NeuralNetworkNode::predict_packed);
     ClassDB::bind_method(D_METHOD("model_summary"), &NeuralNetworkNode::model_summary);
+    ClassDB::bind_method(D_METHOD("get_profile"), &NeuralNetworkNode::get_profile);
+    ClassDB::bind_method(D_METHOD("reset_profile"), &NeuralNetworkNode::reset_profile);
     ClassDB::bind_method(D_METHOD("copy_weights", "source"), &NeuralNetworkNode::copy_weights);
+    ClassDB::bind_method(D_METHOD("set_model", "model"), &NeuralNetworkNode::set_model);
+    ClassDB::bind_method(D_METHOD("get_model"), &NeuralNetworkNode::get_model);
+    ClassDB::bind_method(D_METHOD("export_model"), &NeuralNetworkNode::export_model);
+    ClassDB::bind_method(D_METHOD("is_sharing_weights"), &NeuralNetworkNode::is_sharing_weights);
+    ClassDB::bind_method(D_METHOD("get_input_size"), &NeuralNetworkNode::get_input_size);
+    ClassDB::bind_method(D_METHOD("get_output_size"), &NeuralNetworkNode::get_output_size);
     ClassDB::bind_method(D_METHOD("set_learning_rate", "lr"), &NeuralNetworkNode::set_learning_rate);
     ClassDB::bind_method(D_METHOD("get_learning_rate"), &NeuralNetworkNode::get_learning_rate);
     ClassDB::bind_method(D_METHOD("set_verbosity", "level"), &NeuralNetworkNode::set_verbosity);
@@ -28,12 +60,52 @@ void NeuralNetworkNode::_bind_methods() {
     ClassDB::bind_method(D_METHOD("get_batch_size"), &NeuralNetworkNode::get_batch_size);
     ClassDB::bind_method(D_METHOD("build_model"), &NeuralNetworkNode::build_model);
 
+    ClassDB::bind_method(D_METHOD("train_step", "inputs", "targets", "loss", "weights"), &NeuralNetworkNode::train_step, DEFVAL(PackedFloat32Array()));
+    ClassDB::bind_method(D_METHOD("train_step_matrix", "inputs", "targets", "loss", "weights"), &NeuralNetworkNode::train_step_matrix, DEFVAL(PackedFloat32Array()));
+    ClassDB::bind_method(D_METHOD("train_async", "inputs", "targets", "loss", "weights"), &NeuralNetworkNode::train_async, DEFVAL(PackedFloat32Array()));
+    ClassDB::bind_method(D_METHOD("wait_for_training"), &NeuralNetworkNode::wait_for_training);
+    ClassDB::bind_method(D_METHOD("set_async_training", "enabled"), &NeuralNetworkNode::set_async_training);
+    ClassDB::bind_method(D_METHOD("get_async_training"), &NeuralNetworkNode::get_async_training);
+    ClassDB::bind_method(D_METHOD("set_publish_interval", "steps"), &NeuralNetworkNode::set_publish_interval);
+    ClassDB::bind_method(D_METHOD("get_publish_interval"), &NeuralNetworkNode::get_publish_interval);
+    ClassDB::bind_method(D_METHOD("set_max_queued_steps", "steps"), &NeuralNetworkNode::set_max_queued_steps);
+    ClassDB::bind_method(D_METHOD("get_max_queued_steps"), &NeuralNetworkNode::get_max_queued_steps);
+    ClassDB::bind_method(D_METHOD("get_training_steps"), &NeuralNetworkNode::get_training_steps);
+    ClassDB::bind_method(D_METHOD("get_published_step"), &NeuralNetworkNode::get_published_step);
+    ClassDB::bind_method(D_METHOD("get_last_loss"), &NeuralNetworkNode::get_last_loss);
+    ClassDB::bind_method(D_METHOD("calibrate", "inputs"), &NeuralNetworkNode::calibrate);
+    ClassDB::bind_method(D_METHOD("clear_calibration"), &NeuralNetworkNode::clear_calibration);
+    ClassDB::bind_method(D_METHOD("quantize"), &NeuralNetworkNode::quantize);
+    ClassDB::bind_method(D_METHOD("dequantize"), &NeuralNetworkNode::dequantize);
+    ClassDB::bind_method(D_METHOD("is_quantized"), &NeuralNetworkNode::is_quantized);
+    ClassDB::bind_method(D_METHOD("get_quantization_report", "inputs"), &NeuralNetworkNode::get_quantization_report);
+    ClassDB::bind_method(D_METHOD("set_weight_storage", "format"), &NeuralNetworkNode::set_weight_storage);
+    ClassDB::bind_method(D_METHOD("get_weight_storage"), &NeuralNetworkNode::get_weight_storage);
+    ClassDB::bind_method(D_METHOD("save_model", "path", "include_optimizer"), &NeuralNetworkNode::save_model, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("load_model", "path"), &NeuralNetworkNode::load_model);
+    ClassDB::bind_method(D_METHOD("load_weights_npz", "path", "mapping"), &NeuralNetworkNode::load_weights_npz);
+    ClassDB::bind_method(D_METHOD("checkpoint_async", "path", "include_optimizer"), &NeuralNetworkNode::checkpoint_async, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("wait_for_checkpoints"), &NeuralNetworkNode::wait_for_checkpoints);
+    ClassDB::bind_method(D_METHOD("set_checkpoint_keep_last", "count"), &NeuralNetworkNode::set_checkpoint_keep_last);
+    ClassDB::bind_method(D_METHOD("get_checkpoint_keep_last"), &NeuralNetworkNode::get_checkpoint_keep_last);
+    ClassDB::bind_method(D_METHOD("set_training_threads", "threads"), &NeuralNetworkNode::set_training_threads);
+    ClassDB::bind_method(D_METHOD("get_training_threads"), &NeuralNetworkNode::get_training_threads);
+
     // Inspector-visible properties
     ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "layers",
         PROPERTY_HINT_NONE, "",
         PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_EDITOR),
         "set_layers", "get_layers");
 
+    // After "layers" so a stored model replaces the randomly initialized stack
+    ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "model",
+        PROPERTY_HINT_RESOURCE_TYPE, "NeuralModel"),
+        "set_model", "get_model");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "weight_storage",
+        PROPERTY_HINT_ENUM, "Float32,Float16,BFloat16"),
+        "set_weight_storage", "get_weight_storage");
+
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "learning_rate",
         PROPERTY_HINT_RANGE, "0.0,1.0,0.0001,precision:6"),
         "set_learning_rate", "get_learning_rate");
@@ -45,13 +117,40 @@ void NeuralNetworkNode::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::INT, "verbosity",
         PROPERTY_HINT_RANGE, "0,3,1"),
         "set_verbosity", "get_verbosity");
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "async_training"),
+        "set_async_training", "get_async_training");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "publish_interval",
+        PROPERTY_HINT_RANGE, "1,1000,1,or_greater"),
+        "set_publish_interval", "get_publish_interval");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "max_queued_steps",
+        PROPERTY_HINT_RANGE, "1,256,1"),
+        "set_max_queued_steps", "get_max_queued_steps");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "training_threads",
+        PROPERTY_HINT_RANGE, "0,64,1"),
+        "set_training_threads", "get_training_threads");
+
+    ADD_PROPERTY(PropertyInfo(Variant::INT, "checkpoint_keep_last",
+        PROPERTY_HINT_RANGE, "0,100,1,or_greater"),
+        "set_checkpoint_keep_last", "get_checkpoint_keep_last");
+
+    ADD_SIGNAL(MethodInfo("weights_published", PropertyInfo(Variant::INT, "step")));
+    ADD_SIGNAL(MethodInfo("checkpoint_saved", PropertyInfo(Variant::STRING, "path"),
+        PropertyInfo(Variant::INT, "step"), PropertyInfo(Variant::INT, "error")));
 }
 
 void NeuralNetworkNode::add_layer(int input_size, int output_size, godot::String activation) {
+    wait_for_training();
     std::string act_type = activation.utf8().get_data();
     Layer layer(input_size, output_size, learning_rate, act_type);
     layer.set_verbosity(verbosity);
     layers.push_back(layer);
+    refresh_inference_copies();
+    if (async_training)
+        publish_snapshot();
 }
 
 godot::Array NeuralNetworkNode::forward(godot::Array input) {
@@ -63,6 +162,14 @@ godot::Array NeuralNetworkNode::forward(godot::Array input) {
         Logger::error_raise("NeuralNetworkNode::forward() - empty input");
         return godot::Array();
     }
+    if (async_training) {
+        Logger::error_raise("NeuralNetworkNode::forward() - async training is on, use predict() or train_async()");
+        return godot::Array();
+    }
+    if (is_inference_only()) {
+        Logger::error_raise("NeuralNetworkNode::forward() - inference-only weights are active, use predict()");
+        return godot::Array();
+    }
 
     // Validate dimensions
     const int expected_dim = layers.front().get_input_size();
@@ -80,25 +187,122 @@ godot::Array NeuralNetworkNode::forward(godot::Array input) {
     // Convert to Eigen
     Eigen::MatrixXf x = godot_to_eigen(input, batch_size);
 
-    // Forward pass
-    for (auto &layer : layers)
-        x = layer.forward(x);
-
     // Output: no artificial squashing
-    return eigen_to_godot(x);
+    return eigen_to_godot(forward_pass(x));
+}
+
+namespace {
+
+// Work estimates for one dense layer on `rows` samples. The GEMMs dominate,
+// so activations are ignored; backward computes both dW and dX.
+struct DenseWork {
+    uint64_t flops = 0;
+    uint64_t bytes = 0;
+};
+
+DenseWork forward_work(int64_t rows, int64_t in, int64_t out) {
+    return { uint64_t(2 * rows * in * out), sizeof(float) * uint64_t(rows * in + in * out + rows * out) };
+}
+
+DenseWork backward_work(int64_t rows, int64_t in, int64_t out) {
+    return { uint64_t(4 * rows * in * out), 2 * sizeof(float) * uint64_t(rows * in + in * out + rows * out) };
+}
+
+} // namespace
+
+bool NeuralNetworkNode::prepare_layer_profile() {
+    if (!Profiler::is_enabled())
+        return false;
+    if (layer_profile.size() != layers.size()) {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        layer_profile.resize(layers.size());
+    }
+    return true;
+}
+
+godot::Dictionary NeuralNetworkNode::get_profile() const {
+    godot::Array per_layer;
+    {
+        std::lock_guard<std::mutex> lock(profile_mutex);
+        for (const LayerProfile &p : layer_profile) {
+            godot::Dictionary d;
+            d["forward"] = p.forward.to_dictionary();
+            d["backward"] = p.backward.to_dictionary();
+            per_layer.push_back(d);
+        }
+    }
+    godot::Dictionary out;
+    out["layers"] = per_layer;
+    out["training_steps"] = get_training_steps();
+    return out;
+}
+
+void NeuralNetworkNode::reset_profile() {
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    for (LayerProfile &p : layer_profile) {
+        p.forward.reset();
+        p.backward.reset();
+    }
+}
+
+Eigen::MatrixXf NeuralNetworkNode::forward_pass(const Eigen::MatrixXf &input) {
+    const bool profiling = prepare_layer_profile();
+    Profiler::Scope total(profiling ? &Profiler::section(Profiler::NN_FORWARD) : nullptr, 0, 0);
+    Eigen::MatrixXf x = input;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        DenseWork work;
+        if (profiling) {
+            work = forward_work(x.rows(), layers[i].get_input_size(), layers[i].get_output_size());
+            total.add_work(work.flops, work.bytes);
+            // forward() returns a fresh activation matrix
+            Profiler::count_allocation(sizeof(float) * uint64_t(x.rows()) * layers[i].get_output_size());
+        }
+        Profiler::Scope scope(profiling ? &layer_profile[i].forward : nullptr, work.flops, work.bytes);
+        x = layers[i].forward(x);
+    }
+    return x;
 }
 
 void NeuralNetworkNode::backward(godot::Array error) {
+    if (async_training) {
+        Logger::error_raise("NeuralNetworkNode::backward() - async training is on, use train_async()");
+        return;
+    }
+    if (is_inference_only()) {
+        Logger::error_raise("NeuralNetworkNode::backward() - inference-only weights are active, call dequantize() or use Float32 weight_storage");
+        return;
+    }
+
     Eigen::MatrixXf grad = godot_to_eigen(error, batch_size);
     if (grad.size() == 0 || !grad.allFinite()) {
         Logger::warn("NeuralNetworkNode::backward() - invalid gradient input");
         return;
     }
+    backward_pass(std::move(grad));
+}
 
-    // 1. Backprop through layers
-    for (int i = static_cast<int>(layers.size()) - 1; i >= 0; --i)
-        grad = layers[i].backward_compute(grad);
+void NeuralNetworkNode::backward_pass(Eigen::MatrixXf grad) {
+    const bool profiling = prepare_layer_profile();
+    {
+        Profiler::Scope total(profiling ? &Profiler::section(Profiler::NN_BACKWARD) : nullptr, 0, 0);
+        // 1. Backprop through layers
+        for (int i = static_cast<int>(layers.size()) - 1; i >= 0; --i) {
+            DenseWork work;
+            if (profiling) {
+                work = backward_work(grad.rows(), layers[i].get_input_size(), layers[i].get_output_size());
+                total.add_work(work.flops, work.bytes);
+                Profiler::count_allocation(sizeof(float) * uint64_t(grad.rows()) * layers[i].get_input_size());
+            }
+            Profiler::Scope scope(profiling ? &layer_profile[i].backward : nullptr, work.flops, work.bytes);
+            grad = layers[i].backward_compute(grad);
+        }
+    }
+
+    apply_gradients();
+}
 
+void NeuralNetworkNode::apply_gradients() {
+    Profiler::Scope scope(Profiler::section(Profiler::NN_UPDATE));
     // 2. Compute global gradient norm (for clipping)
     float global_norm = 0.0f;
     for (auto &layer : layers)
@@ -121,7 +325,40 @@ void NeuralNetworkNode::backward(godot::Array error) {
         layer.apply_update();
 }
 
-godot::Array NeuralNetworkNode::predict(godot::Array input) {
+namespace {
+// Per-thread activation buffers, so concurrent predict calls share nothing
+thread_local InferenceScratch predict_scratch;
+
+// Runs any of the layer stacks, timed into Profiler::NN_PREDICT when enabled
+template <class L>
+const Eigen::MatrixXf &infer_profiled(const std::vector<L> &stack, const Eigen::MatrixXf &X, InferenceScratch &scratch) {
+    if (!Profiler::is_enabled())
+        return L::infer_stack(stack, X, scratch);
+    DenseWork total;
+    for (const L &layer : stack) {
+        const DenseWork work = forward_work(X.rows(), layer.get_input_size(), layer.get_output_size());
+        total.flops += work.flops;
+        total.bytes += work.bytes;
+    }
+    Profiler::Scope scope(Profiler::section(Profiler::NN_PREDICT), total.flops, total.bytes);
+    return L::infer_stack(stack, X, scratch);
+}
+}
+
+const Eigen::MatrixXf &NeuralNetworkNode::predict_into(const Eigen::MatrixXf &X, InferenceScratch &scratch) const {
+    if (!quantized_layers.empty())
+        return infer_profiled(quantized_layers, X, scratch);
+    if (!half_layers.empty())
+        return infer_profiled(half_layers, X, scratch);
+    if (async_training) {
+        // The worker owns `layers`; read the last published weights instead
+        const std::shared_ptr<const Snapshot> snap = load_snapshot();
+        return infer_profiled(snap->layers, X, scratch);
+    }
+    return infer_profiled(layers, X, scratch);
+}
+
+godot::Array NeuralNetworkNode::predict(godot::Array input) const {
 
     if (layers.empty()) {
         Logger::error_raise("NeuralNetworkNode::predict() - no layers defined");
@@ -137,20 +374,746 @@ godot::Array NeuralNetworkNode::predict(godot::Array input) {
     int actual_batch = input.size();
 
     Eigen::MatrixXf x = godot_to_eigen(input, actual_batch);
+    if (x.cols() != get_input_size()) {
+        Logger::error_raise("NeuralNetworkNode::predict() - input size does not match the network");
+        return godot::Array();
+    }
 
-    for (auto &layer : layers)
-        x = layer.forward(x);
+    return eigen_to_godot(predict_into(x, predict_scratch));
+}
+
+godot::Ref<godot::Matrix> NeuralNetworkNode::predict_matrix(const godot::Ref<godot::Matrix> &input) const {
+    if (layers.empty() || input.is_null()) {
+        Logger::error_raise("NeuralNetworkNode::predict_matrix() - no layers or null input");
+        return godot::Ref<godot::Matrix>();
+    }
+    if (input->cols() != get_input_size()) {
+        Logger::error_raise("NeuralNetworkNode::predict_matrix() - input size does not match the network");
+        return godot::Ref<godot::Matrix>();
+    }
 
-    return eigen_to_godot(x);
+    const Eigen::MatrixXf x = input->eigen();
+    godot::Ref<godot::Matrix> out = memnew(godot::Matrix());
+    out->eigen() = predict_into(x, predict_scratch);
+    return out;
+}
+
+godot::PackedFloat32Array NeuralNetworkNode::predict_packed(const godot::PackedFloat32Array &input) const {
+    if (layers.empty()) {
+        Logger::error_raise("NeuralNetworkNode::predict_packed() - no layers defined");
+        return godot::PackedFloat32Array();
+    }
+    const int in = get_input_size();
+    if (input.is_empty() || input.size() % in != 0) {
+        Logger::error_raise("NeuralNetworkNode::predict_packed() - size must be a multiple of the input size");
+        return godot::PackedFloat32Array();
+    }
+
+    // Rows are packed back to back, one sample per row
+    const Eigen::MatrixXf x = Eigen::Map<const RowMat>(input.ptr(), input.size() / in, in);
+    const Eigen::MatrixXf &y = predict_into(x, predict_scratch);
+
+    godot::PackedFloat32Array out;
+    out.resize(y.size());
+    Eigen::Map<RowMat>(out.ptrw(), y.rows(), y.cols()) = y;
+    return out;
+}
+
+bool NeuralNetworkNode::make_job(const godot::Array &inputs, const godot::Array &targets, const godot::Ref<LossNode> &loss,
+                                 const godot::PackedFloat32Array &weights, TrainJob &job) const {
+    ERR_FAIL_COND_V_MSG(inputs.is_empty() || inputs.size() != targets.size(), false,
+        "NeuralNetworkNode::train - inputs and targets row mismatch");
+    job.X = godot_to_eigen(inputs);
+    job.Y = godot_to_eigen(targets);
+    return finish_job(loss, weights, job);
+}
+
+bool NeuralNetworkNode::make_job(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets,
+                                 const godot::Ref<LossNode> &loss, const godot::PackedFloat32Array &weights,
+                                 TrainJob &job) const {
+    ERR_FAIL_COND_V_MSG(inputs.is_null() || targets.is_null(), false, "NeuralNetworkNode::train - null matrix");
+    ERR_FAIL_COND_V_MSG(inputs->rows() == 0 || inputs->rows() != targets->rows(), false,
+        "NeuralNetworkNode::train - inputs and targets row mismatch");
+    // Targets are row-major on both sides; inputs switch to the layers' layout
+    job.X = inputs->eigen();
+    job.Y = targets->eigen();
+    return finish_job(loss, weights, job);
+}
+
+bool NeuralNetworkNode::finish_job(const godot::Ref<LossNode> &loss, const godot::PackedFloat32Array &weights,
+                                   TrainJob &job) const {
+    ERR_FAIL_COND_V_MSG(layers.empty(), false, "NeuralNetworkNode::train - no layers defined");
+    ERR_FAIL_COND_V_MSG(loss.is_null(), false, "NeuralNetworkNode::train - null loss");
+    ERR_FAIL_COND_V_MSG(job.X.cols() != layers.front().get_input_size(), false,
+        "NeuralNetworkNode::train - input size does not match the network");
+    ERR_FAIL_COND_V_MSG(job.Y.cols() != layers.back().get_output_size(), false,
+        "NeuralNetworkNode::train - target size does not match the network");
+    ERR_FAIL_COND_V_MSG(!weights.is_empty() && weights.size() != job.X.rows(), false,
+        "NeuralNetworkNode::train - need one weight per row");
+
+    job.weights.assign(weights.ptr(), weights.ptr() + weights.size());
+    job.loss = loss;
+    return true;
+}
+
+int NeuralNetworkNode::shard_count(int rows) const {
+    const int threads = training_threads > 0 ? training_threads : ThreadPool::get_thread_count();
+    // Depends only on the batch size and the knob, never on scheduling
+    return std::max(1, std::min(threads, rows / MIN_SHARD_ROWS));
+}
+
+double NeuralNetworkNode::train_batch(const Eigen::MatrixXf &X, const RowMat &Y, LossNode *loss, const float *weights) {
+    const int shards = shard_count(X.rows());
+    if (shards > 1)
+        return train_batch_sharded(X, Y, loss, weights, shards);
+
+    const RowMat out = forward_pass(X);
+    RowMat grad(out.rows(), out.cols());
+    const double value = loss->evaluate(out.data(), Y.data(), out.rows(), out.cols(), weights, grad.data());
+
+    if (!std::isfinite(value) || !grad.allFinite()) {
+        Logger::warn("NeuralNetworkNode::train - non-finite loss, step skipped");
+        return value;
+    }
+    backward_pass(grad);
+    return value;
+}
+
+double NeuralNetworkNode::train_batch_sharded(const Eigen::MatrixXf &X, const RowMat &Y, LossNode *loss,
+                                              const float *weights, int shards) {
+    const int rows = X.rows();
+
+    // Replicas share the parameters but keep their own caches and gradients
+    std::vector<std::vector<Layer>> replicas(shards);
+    for (auto &replica : replicas) {
+        replica.reserve(layers.size());
+        for (const Layer &layer : layers)
+            replica.push_back(layer.shallow_copy());
+    }
+
+    // Per-layer times are summed over the shards, i.e. CPU time
+    const bool profiling = prepare_layer_profile();
+    DenseWork forward_total, backward_total;
+    if (profiling) {
+        for (const Layer &layer : layers) {
+            const DenseWork f = forward_work(rows, layer.get_input_size(), layer.get_output_size());
+            const DenseWork b = backward_work(rows, layer.get_input_size(), layer.get_output_size());
+            forward_total.flops += f.flops;
+            forward_total.bytes += f.bytes;
+            backward_total.flops += b.flops;
+            backward_total.bytes += b.bytes;
+        }
+    }
+
+    RowMat out(rows, layers.back().get_output_size());
+    {
+        Profiler::Scope total(profiling ? &Profiler::section(Profiler::NN_FORWARD) : nullptr,
+                              forward_total.flops, forward_total.bytes);
+        ThreadPool::parallel_for(shards, 1, [&](int first, int last) {
+            for (int s = first; s < last; ++s) {
+                int begin, end;
+                ThreadPool::chunk_range(rows, shards, s, begin, end);
+                Eigen::MatrixXf x = X.middleRows(begin, end - begin);
+                for (size_t i = 0; i < replicas[s].size(); ++i) {
+                    Layer &layer = replicas[s][i];
+                    const DenseWork work = profiling
+                        ? forward_work(x.rows(), layer.get_input_size(), layer.get_output_size()) : DenseWork();
+                    Profiler::Scope scope(profiling ? &layer_profile[i].forward : nullptr, work.flops, work.bytes);
+                    if (profiling)
+                        Profiler::count_allocation(sizeof(float) * uint64_t(x.rows()) * layer.get_output_size());
+                    x = layer.forward(x);
+                }
+                out.middleRows(begin, end - begin) = x;
+            }
+        });
+    }
+
+    // The loss sees the whole batch so its mean and weighting match train_batch()
+    RowMat grad(out.rows(), out.cols());
+    const double value = loss->evaluate(out.data(), Y.data(), out.rows(), out.cols(), weights, grad.data());
+    if (!std::isfinite(value) || !grad.allFinite()) {
+        Logger::warn("NeuralNetworkNode::train - non-finite loss, step skipped");
+        return value;
+    }
+
+    {
+        // Backward includes the gradient reduction, not the update
+        Profiler::Scope total(profiling ? &Profiler::section(Profiler::NN_BACKWARD) : nullptr,
+                              backward_total.flops, backward_total.bytes);
+        ThreadPool::parallel_for(shards, 1, [&](int first, int last) {
+            for (int s = first; s < last; ++s) {
+                int begin, end;
+                ThreadPool::chunk_range(rows, shards, s, begin, end);
+                Eigen::MatrixXf g = grad.middleRows(begin, end - begin);
+                std::vector<Layer> &replica = replicas[s];
+                for (int i = static_cast<int>(replica.size()) - 1; i >= 0; --i) {
+                    const DenseWork work = profiling
+                        ? backward_work(g.rows(), replica[i].get_input_size(), replica[i].get_output_size()) : DenseWork();
+                    Profiler::Scope scope(profiling ? &layer_profile[i].backward : nullptr, work.flops, work.bytes);
+                    if (profiling)
+                        Profiler::count_allocation(sizeof(float) * uint64_t(g.rows()) * replica[i].get_input_size());
+                    g = replica[i].backward_compute(g);
+                }
+                // backward_compute() averages over the shard; reweight to the batch mean
+                const float share = static_cast<float>(end - begin) / static_cast<float>(rows);
+                for (Layer &layer : replica)
+                    layer.normalize_gradients(share);
+            }
+        });
+
+        // Pairwise tree reduction with a fixed shape: the sum only depends on the
+        // shard count, so results are bitwise reproducible for a given thread count
+        for (int stride = 1; stride < shards; stride *= 2) {
+            const int pairs = (shards - stride + 2 * stride - 1) / (2 * stride);
+            ThreadPool::parallel_for(pairs, 1, [&](int first, int last) {
+                for (int p = first; p < last; ++p) {
+                    const int dst = p * 2 * stride;
+                    for (size_t l = 0; l < layers.size(); ++l)
+                        replicas[dst][l].accumulate_gradients(replicas[dst + stride][l]);
+                }
+            });
+        }
+
+        for (size_t l = 0; l < layers.size(); ++l)
+            layers[l].take_gradients(replicas[0][l]);
+        // Drop the replicas' references so the update does not copy the weights
+        replicas.clear();
+    }
+
+    apply_gradients();
+    return value;
+}
+
+float NeuralNetworkNode::train_step(godot::Array inputs, godot::Array targets, const godot::Ref<LossNode> &loss,
+                                    const godot::PackedFloat32Array &weights) {
+    TrainJob job;
+    if (!can_train_sync("train_step") || !make_job(inputs, targets, loss, weights, job))
+        return 0.0f;
+    run_job(job);
+    return last_loss.load();
+}
+
+float NeuralNetworkNode::train_step_matrix(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets,
+                                           const godot::Ref<LossNode> &loss, const godot::PackedFloat32Array &weights) {
+    TrainJob job;
+    if (!can_train_sync("train_step_matrix") || !make_job(inputs, targets, loss, weights, job))
+        return 0.0f;
+    run_job(job);
+    return last_loss.load();
+}
+
+bool NeuralNetworkNode::can_train_sync(const char *caller) const {
+    if (async_training) {
+        Logger::error_raise(std::string("NeuralNetworkNode::") + caller + "() - async training is on, use train_async()");
+        return false;
+    }
+    if (is_inference_only()) {
+        Logger::error_raise(std::string("NeuralNetworkNode::") + caller + "() - inference-only weights are active, call dequantize() or use Float32 weight_storage");
+        return false;
+    }
+    return true;
+}
+
+uint64_t NeuralNetworkNode::run_job(const TrainJob &job) {
+    const double value = train_batch(job.X, job.Y, job.loss.ptr(),
+                                     job.weights.empty() ? nullptr : job.weights.data());
+    last_loss.store(static_cast<float>(value));
+    return training_steps.fetch_add(1) + 1;
+}
+
+bool NeuralNetworkNode::train_async(godot::Array inputs, godot::Array targets, const godot::Ref<LossNode> &loss,
+                                    const godot::PackedFloat32Array &weights) {
+    if (is_inference_only()) {
+        Logger::error_raise("NeuralNetworkNode::train_async() - inference-only weights are active, call dequantize() or use Float32 weight_storage");
+        return false;
+    }
+    if (!async_training) {
+        // Same contract as train_step(), just without the return value
+        TrainJob job;
+        if (!make_job(inputs, targets, loss, weights, job))
+            return false;
+        run_job(job);
+        return true;
+    }
+
+    TrainJob job;
+    if (!make_job(inputs, targets, loss, weights, job))
+        return false;
+
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        if (static_cast<int>(jobs.size()) >= max_queued_steps)
+            return false;   // training is behind; the caller may retry next frame
+        jobs.push_back(std::move(job));
+        if (!worker_active)
+            start = worker_active = true;
+    }
+
+    if (start) {
+        godot::WorkerThreadPool *pool = godot::WorkerThreadPool::get_singleton();
+        // Reap the previous task; it has already left its loop
+        if (task_id >= 0)
+            pool->wait_for_task_completion(task_id);
+        task_id = pool->add_task(callable_mp(this, &NeuralNetworkNode::train_worker), false, "NeuralNetworkNode training");
+    }
+    return true;
+}
+
+void NeuralNetworkNode::train_worker() {
+    for (;;) {
+        TrainJob job;
+        std::vector<CheckpointRequest> requests;
+        bool has_job = false;
+        {
+            std::lock_guard<std::mutex> lock(job_mutex);
+            requests.swap(checkpoint_requests);
+            if (!jobs.empty()) {
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                has_job = true;
+            } else if (requests.empty()) {
+                worker_active = false;
+                break;
+            }
+        }
+
+        // Between steps the layers are consistent, so capture here
+        for (const CheckpointRequest &request : requests)
+            enqueue_checkpoint(capture_checkpoint(request));
+        if (!has_job)
+            continue;
+
+        const uint64_t step = run_job(job);
+        if (step % publish_interval == 0)
+            publish_snapshot();
+    }
+}
+
+void NeuralNetworkNode::publish_snapshot() {
+    auto snap = std::make_shared<Snapshot>();
+
+    // Decided here, on the thread that owns `layers`. The snapshot being
+    // replaced holds a reference of its own, which is not sharing.
+    const std::shared_ptr<const Snapshot> prev = load_snapshot();
+    for (size_t i = 0; i < layers.size() && !snap->sharing_weights; ++i) {
+        const auto params = layers[i].share_params();
+        long owners = params.use_count() - 1;
+        if (prev && i < prev->layers.size() && prev->layers[i].share_params() == params)
+            --owners;
+        snap->sharing_weights = owners > 1 || params->is_mapped();
+    }
+
+    snap->layers.reserve(layers.size());
+    for (const auto &layer : layers)
+        snap->layers.push_back(layer.shallow_copy());
+    snap->step = training_steps.load();
+
+    const int64_t step = static_cast<int64_t>(snap->step);
+    std::atomic_store(&published, std::shared_ptr<const Snapshot>(std::move(snap)));
+    call_deferred("emit_signal", "weights_published", step);
+}
+
+std::shared_ptr<const NeuralNetworkNode::Snapshot> NeuralNetworkNode::load_snapshot() const {
+    return std::atomic_load(&published);
+}
+
+int64_t NeuralNetworkNode::get_published_step() const {
+    const std::shared_ptr<const Snapshot> snap = load_snapshot();
+    return snap ? static_cast<int64_t>(snap->step) : 0;
+}
+
+void NeuralNetworkNode::wait_for_training() {
+    if (task_id < 0)
+        return;
+    // The worker drains the whole queue before it exits
+    godot::WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+    task_id = -1;
+    if (async_training)
+        publish_snapshot();
+}
+
+void NeuralNetworkNode::refresh_inference_copies() {
+    // The int8 copy and the calibration describe weights that are gone
+    if (!quantized_layers.empty())
+        Logger::debug(1, "NeuralNetworkNode - weights replaced, quantization dropped");
+    quantized_layers.clear();
+    activation_ranges.clear();
+    rebuild_half_layers();
+}
+
+void NeuralNetworkNode::rebuild_half_layers() {
+    half_layers.clear();
+    if (weight_storage == NeuralModel::WEIGHTS_FLOAT32)
+        return;
+    half_layers.reserve(layers.size());
+    for (const Layer &layer : layers)
+        half_layers.push_back(HalfLayer::from_layer(layer, static_cast<HalfPrecision::Format>(weight_storage)));
+}
+
+void NeuralNetworkNode::set_weight_storage(int format) {
+    ERR_FAIL_COND_MSG(format < NeuralModel::WEIGHTS_FLOAT32 || format > NeuralModel::WEIGHTS_BFLOAT16,
+        "NeuralNetworkNode - unknown weight storage");
+    ERR_FAIL_COND_MSG(format != NeuralModel::WEIGHTS_FLOAT32 && async_training,
+        "NeuralNetworkNode - turn async training off before using 16-bit weights");
+    weight_storage = format;
+    rebuild_half_layers();
+}
+
+void NeuralNetworkNode::calibrate(godot::Array inputs) {
+    ERR_FAIL_COND_MSG(layers.empty() || inputs.is_empty(), "NeuralNetworkNode::calibrate - no layers or empty input");
+    ERR_FAIL_COND_MSG(async_training, "NeuralNetworkNode::calibrate - async training is on");
+
+    Eigen::MatrixXf x = godot_to_eigen(inputs, inputs.size());
+    ERR_FAIL_COND_MSG(x.cols() != layers.front().get_input_size(), "NeuralNetworkNode::calibrate - input size does not match the network");
+
+    // Running max over every calibration batch of each layer's float input
+    activation_ranges.resize(layers.size(), 0.0f);
+    for (size_t i = 0; i < layers.size(); ++i) {
+        activation_ranges[i] = std::max(activation_ranges[i], x.cwiseAbs().maxCoeff());
+        x = layers[i].infer(x);
+    }
+}
+
+bool NeuralNetworkNode::quantize() {
+    ERR_FAIL_COND_V_MSG(layers.empty(), false, "NeuralNetworkNode::quantize - no layers defined");
+    ERR_FAIL_COND_V_MSG(async_training, false, "NeuralNetworkNode::quantize - turn async training off first");
+
+    // Without calibration, inputs are scaled per row at inference time
+    const bool calibrated = activation_ranges.size() == layers.size();
+    quantized_layers.clear();
+    quantized_layers.reserve(layers.size());
+    for (size_t i = 0; i < layers.size(); ++i)
+        quantized_layers.push_back(QuantizedLayer::from_layer(layers[i], calibrated ? activation_ranges[i] : 0.0f));
+
+    Logger::debug(1, std::string("NeuralNetworkNode::quantize - int8, ") +
+                     (calibrated ? "calibrated ranges" : "dynamic ranges"));
+    return true;
+}
+
+godot::Dictionary NeuralNetworkNode::get_quantization_report(godot::Array inputs) const {
+    godot::Dictionary report;
+    ERR_FAIL_COND_V_MSG(!is_quantized(), report, "NeuralNetworkNode::get_quantization_report - call quantize() first");
+    ERR_FAIL_COND_V_MSG(inputs.is_empty(), report, "NeuralNetworkNode::get_quantization_report - empty input");
+
+    const Eigen::MatrixXf x = godot_to_eigen(inputs, inputs.size());
+    ERR_FAIL_COND_V_MSG(x.cols() != layers.front().get_input_size(), report,
+        "NeuralNetworkNode::get_quantization_report - input size does not match the network");
+
+    InferenceScratch scratch;
+    const Eigen::MatrixXf reference = Layer::infer_stack(layers, x, scratch);
+    const Eigen::MatrixXf quantized = QuantizedLayer::infer_stack(quantized_layers, x, scratch);
+    const Eigen::ArrayXXf err = (quantized - reference).array().abs();
+
+    // Share of rows whose largest output (the greedy action) is unchanged
+    int agree = 0;
+    for (int r = 0; r < reference.rows(); ++r) {
+        Eigen::Index a, b;
+        reference.row(r).maxCoeff(&a);
+        quantized.row(r).maxCoeff(&b);
+        agree += (a == b) ? 1 : 0;
+    }
+
+    int64_t float_bytes = 0;
+    int64_t int8_bytes = 0;
+    for (size_t i = 0; i < layers.size(); ++i) {
+        float_bytes += static_cast<int64_t>(layers[i].get_input_size() + 1) * layers[i].get_output_size() * sizeof(float);
+        int8_bytes += quantized_layers[i].get_byte_size();
+    }
+
+    report["max_abs_error"] = err.maxCoeff();
+    report["mean_abs_error"] = err.mean();
+    report["argmax_agreement"] = static_cast<double>(agree) / static_cast<double>(reference.rows());
+    report["float_bytes"] = float_bytes;
+    report["quantized_bytes"] = int8_bytes;
+    return report;
+}
+
+godot::Error NeuralNetworkNode::write_checkpoint_file(const godot::String &path, const std::vector<uint8_t> &bytes) {
+    // Write next to the target and rename, so a crash never leaves a torn file
+    const godot::String tmp = path + ".tmp";
+    godot::Ref<godot::FileAccess> file = godot::FileAccess::open(tmp, godot::FileAccess::WRITE);
+    ERR_FAIL_COND_V_MSG(file.is_null(), godot::FileAccess::get_open_error(), "NeuralNetworkNode - could not open " + tmp);
+    file->store_buffer(bytes.data(), bytes.size());
+    const godot::Error err = file->get_error();
+    file->close();
+    ERR_FAIL_COND_V_MSG(err != godot::OK, err, "NeuralNetworkNode - checkpoint write failed");
+
+    return godot::DirAccess::rename_absolute(tmp, path);
+}
+
+godot::Error NeuralNetworkNode::save_model(const godot::String &path, bool include_optimizer) {
+    ERR_FAIL_COND_V_MSG(layers.empty(), godot::ERR_UNCONFIGURED, "NeuralNetworkNode::save_model - no layers defined");
+    // Queued steps finish first so the file matches get_training_steps()
+    wait_for_training();
+    return write_checkpoint_file(path, Checkpoint::serialize(layers, training_steps.load(), include_optimizer));
+}
+
+godot::Error NeuralNetworkNode::checkpoint_async(const godot::String &path, bool include_optimizer) {
+    ERR_FAIL_COND_V_MSG(layers.empty(), godot::ERR_UNCONFIGURED, "NeuralNetworkNode::checkpoint_async - no layers defined");
+    ERR_FAIL_COND_V_MSG(path.is_empty(), godot::ERR_INVALID_PARAMETER, "NeuralNetworkNode::checkpoint_async - empty path");
+
+    const CheckpointRequest request{ path, include_optimizer };
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        if (worker_active) {
+            // The trainer owns the layers; it captures before its next step
+            checkpoint_requests.push_back(request);
+            return godot::OK;
+        }
+    }
+    // No trainer running (and only this thread starts one): capture now
+    enqueue_checkpoint(capture_checkpoint(request));
+    return godot::OK;
+}
+
+NeuralNetworkNode::CheckpointJob NeuralNetworkNode::capture_checkpoint(const CheckpointRequest &request) const {
+    CheckpointJob job;
+    job.request = request;
+    job.step = training_steps.load();
+    job.layers.reserve(layers.size());
+    for (const Layer &layer : layers) {
+        // Shared params: the trainer copies a layer before its next write.
+        // Momentum is updated in place, so it is copied now.
+        Layer copy = layer.shallow_copy();
+        if (request.include_optimizer)
+            copy.set_momentum(layer.get_momentum_weights(), layer.get_momentum_biases());
+        job.layers.push_back(std::move(copy));
+    }
+    return job;
+}
+
+void NeuralNetworkNode::enqueue_checkpoint(CheckpointJob job) {
+    {
+        std::lock_guard<std::mutex> lock(checkpoint_mutex);
+        checkpoint_jobs.push_back(std::move(job));
+        ++checkpoints_in_flight;
+        if (!checkpoint_thread.joinable())
+            checkpoint_thread = std::thread(&NeuralNetworkNode::checkpoint_writer, this);
+    }
+    checkpoint_cv.notify_all();
+}
+
+void NeuralNetworkNode::checkpoint_writer() {
+    for (;;) {
+        CheckpointJob job;
+        {
+            std::unique_lock<std::mutex> lock(checkpoint_mutex);
+            checkpoint_cv.wait(lock, [this] { return checkpoint_stop || !checkpoint_jobs.empty(); });
+            if (checkpoint_jobs.empty())
+                return;   // stopping with nothing left to write
+            job = std::move(checkpoint_jobs.front());
+            checkpoint_jobs.pop_front();
+        }
+
+        const godot::String path = job.request.path.replace("{step}", godot::String::num_uint64(job.step));
+        const godot::Error err = write_checkpoint_file(path,
+            Checkpoint::serialize(job.layers, job.step, job.request.include_optimizer));
+        // Release the shared params before anyone waits on us
+        job.layers.clear();
+
+        if (err == godot::OK) {
+            // Rolling window over the distinct files this node has written
+            if (checkpoint_history.empty() || checkpoint_history.back() != path)
+                checkpoint_history.push_back(path);
+            const int keep = checkpoint_keep_last.load();
+            while (keep > 0 && static_cast<int>(checkpoint_history.size()) > keep) {
+                godot::DirAccess::remove_absolute(checkpoint_history.front());
+                checkpoint_history.pop_front();
+            }
+        }
+
+        call_deferred("emit_signal", "checkpoint_saved", path, static_cast<int64_t>(job.step), static_cast<int64_t>(err));
+        {
+            std::lock_guard<std::mutex> lock(checkpoint_mutex);
+            --checkpoints_in_flight;
+        }
+        checkpoint_cv.notify_all();
+    }
+}
+
+void NeuralNetworkNode::wait_for_checkpoints() {
+    // Requests still held by the trainer are captured once it drains
+    wait_for_training();
+    std::unique_lock<std::mutex> lock(checkpoint_mutex);
+    checkpoint_cv.wait(lock, [this] { return checkpoints_in_flight == 0; });
+}
+
+godot::Error NeuralNetworkNode::load_model(const godot::String &path) {
+    const std::shared_ptr<const MappedFile> file = Utils::map_file(path);
+    ERR_FAIL_COND_V_MSG(!file, godot::ERR_FILE_CANT_OPEN, "NeuralNetworkNode::load_model - could not open " + path);
+
+    std::vector<Layer> loaded;
+    Checkpoint::Info info;
+    const std::string problem = Checkpoint::parse(file, loaded, info);
+    ERR_FAIL_COND_V_MSG(!problem.empty(), godot::ERR_FILE_CORRUPT,
+        godot::String("NeuralNetworkNode::load_model - ") + problem.c_str());
+
+    wait_for_training();
+    model.unref();
+    layers = std::move(loaded);
+    layers_config.clear();
+    for (Layer &layer : layers) {
+        layer.set_learning_rate(learning_rate);
+        layer.set_verbosity(verbosity);
+
+        godot::Dictionary d;
+        d["input_size"] = layer.get_input_size();
+        d["output_size"] = layer.get_output_size();
+        d["activation"] = godot::String(layer.get_activation_type().c_str());
+        layers_config.push_back(d);
+    }
+    training_steps.store(info.training_steps);
+    refresh_inference_copies();
+    if (async_training)
+        publish_snapshot();
+
+    Logger::debug(1, std::string("NeuralNetworkNode::load_model - ") + std::to_string(layers.size()) + " layers, " +
+                     (file->is_mapped() ? "memory-mapped" : "read into memory"));
+    return godot::OK;
+}
+
+namespace {
+
+const Npy::ArrayView *find_member(const Npy::Archive &archive, const std::string &name) {
+    for (const auto &member : archive)
+        if (member.first == name)
+            return &member.second;
+    return nullptr;
+}
+
+// Builds in x out parameters from NumPy arrays. Weights may be (in, out) or
+// PyTorch's (out, in); when the data is already column-major in x out
+// (out_in in C order, or in_out in Fortran order) the parameters point into
+// the file instead of copying it.
+std::string params_from_npz(const std::shared_ptr<const MappedFile> &file, const Npy::ArrayView &w,
+                            const Npy::ArrayView &b, int in, int out, const std::string &layout,
+                            std::shared_ptr<LayerParams> &p) {
+    if (w.dims() != 2)
+        return "weights must be 2-D, got shape " + w.shape_string();
+    const bool in_out = w.shape[0] == in && w.shape[1] == out;
+    const bool out_in = w.shape[0] == out && w.shape[1] == in;
+    bool transposed;
+    if (layout == "in_out" && in_out)
+        transposed = false;
+    else if (layout == "out_in" && out_in)
+        transposed = true;
+    else if (layout == "auto" && (in_out || out_in))
+        transposed = !in_out;   // square weights are read as (in, out)
+    else if (layout != "auto" && layout != "in_out" && layout != "out_in")
+        return "unknown layout '" + layout + "'";
+    else
+        return "weights shape " + w.shape_string() + " does not match layer " +
+               std::to_string(in) + " -> " + std::to_string(out);
+
+    if (b.dims() > 2 || b.count != size_t(out) || (b.dims() == 2 && b.shape[0] != 1 && b.shape[1] != 1))
+        return "biases shape " + b.shape_string() + " does not match " + std::to_string(out) + " outputs";
+
+    p = std::make_shared<LayerParams>();
+    if (transposed != w.fortran_order && w.is_aligned() && b.is_aligned()) {
+        p->backing = file;
+        p->mapped_weights = reinterpret_cast<const float *>(w.data);
+        p->mapped_biases = reinterpret_cast<const float *>(b.data);
+        p->mapped_rows = in;
+        p->mapped_cols = out;
+        return "";
+    }
+    p->weights.resize(in, out);
+    if (transposed)
+        Npy::copy_row_major(w, out, in, p->weights.data());
+    else
+        Npy::copy_col_major(w, in, out, p->weights.data());
+    p->biases.resize(1, out);
+    Npy::copy_row_major(b, 1, out, p->biases.data());
+    return "";
+}
+
+} // namespace
+
+godot::Error NeuralNetworkNode::load_weights_npz(const godot::String &path, const godot::Dictionary &mapping) {
+    ERR_FAIL_COND_V_MSG(layers.empty(), godot::ERR_UNCONFIGURED, "NeuralNetworkNode::load_weights_npz - build the network first");
+    const std::shared_ptr<const MappedFile> file = Utils::map_file(path);
+    ERR_FAIL_COND_V_MSG(!file, godot::ERR_FILE_CANT_OPEN, "NeuralNetworkNode::load_weights_npz - could not open " + path);
+
+    Npy::Archive archive;
+    const std::string problem = Npy::parse_npz(file->data(), file->size(), archive);
+    ERR_FAIL_COND_V_MSG(!problem.empty(), godot::ERR_FILE_CORRUPT,
+        godot::String("NeuralNetworkNode::load_weights_npz - ") + problem.c_str());
+
+    // Everything is validated before the first layer changes
+    std::vector<std::pair<int, std::shared_ptr<LayerParams>>> updates;
+    const godot::Array keys = mapping.keys();
+    for (int k = 0; k < keys.size(); ++k) {
+        const int index = keys[k];
+        ERR_FAIL_COND_V_MSG(index < 0 || index >= (int)layers.size(), godot::ERR_INVALID_PARAMETER,
+            "NeuralNetworkNode::load_weights_npz - no layer " + godot::String::num_int64(index));
+        const godot::Dictionary entry = mapping[keys[k]];
+        const std::string weights_name = godot::String(entry.get("weights", "")).utf8().get_data();
+        const std::string biases_name = godot::String(entry.get("biases", "")).utf8().get_data();
+        const std::string layout = godot::String(entry.get("layout", "auto")).utf8().get_data();
+
+        const Npy::ArrayView *w = find_member(archive, weights_name);
+        const Npy::ArrayView *b = find_member(archive, biases_name);
+        ERR_FAIL_COND_V_MSG(!w || !b, godot::ERR_DOES_NOT_EXIST,
+            "NeuralNetworkNode::load_weights_npz - layer " + godot::String::num_int64(index) + ": array '" +
+            godot::String((w ? biases_name : weights_name).c_str()) + "' not found in " + path);
+
+        std::shared_ptr<LayerParams> p;
+        const std::string mismatch = params_from_npz(file, *w, *b, layers[index].get_input_size(),
+                                                     layers[index].get_output_size(), layout, p);
+        ERR_FAIL_COND_V_MSG(!mismatch.empty(), godot::ERR_INVALID_DATA,
+            "NeuralNetworkNode::load_weights_npz - layer " + godot::String::num_int64(index) + ": " + mismatch.c_str());
+        updates.emplace_back(index, std::move(p));
+    }
+
+    wait_for_training();
+    model.unref();
+    int mapped = 0;
+    for (auto &update : updates) {
+        mapped += update.second->is_mapped() ? 1 : 0;
+        layers[update.first].set_params(std::move(update.second));
+    }
+    refresh_inference_copies();
+    if (async_training)
+        publish_snapshot();
+
+    Logger::debug(1, "NeuralNetworkNode::load_weights_npz - " + std::to_string(updates.size()) + " layers loaded, " +
+                     std::to_string(mapped) + " used in place");
+    return godot::OK;
+}
+
+void NeuralNetworkNode::set_training_threads(int threads) {
+    // The background trainer reads it between steps
+    wait_for_training();
+    training_threads = std::max(0, threads);
+}
+
+void NeuralNetworkNode::set_publish_interval(int steps) {
+    wait_for_training();
+    publish_interval = steps > 0 ? steps : 1;
+}
+
+void NeuralNetworkNode::set_async_training(bool enabled) {
+    if (enabled == async_training)
+        return;
+    ERR_FAIL_COND_MSG(enabled && is_inference_only(), "NeuralNetworkNode - async training needs float weights (dequantize, Float32 weight_storage)");
+    wait_for_training();
+    async_training = enabled;
+    if (enabled)
+        publish_snapshot();
+    else
+        std::atomic_store(&published, std::shared_ptr<const Snapshot>());
 }
 
 void NeuralNetworkNode::set_learning_rate(double lr) {
+    wait_for_training();
     learning_rate = lr;
     for (auto &layer : layers)
         layer.set_learning_rate(lr);
 }
 
 void NeuralNetworkNode::set_verbosity(int level) {
+    wait_for_training();
     verbosity = level;
     Logger::set_verbosity(level);
     for (auto &layer : layers)
@@ -158,15 +1121,121 @@ void NeuralNetworkNode::set_verbosity(int level) {
 }
 
 void NeuralNetworkNode::copy_weights(const NeuralNetworkNode* source) {
-    if (!source || source->layers.size() != layers.size()) {
+    if (!source) {
+        Logger::error("NeuralNetworkNode::copy_weights - incompatible network sizes");
+        return;
+    }
+    // Published weights when the source trains asynchronously
+    const std::vector<Layer> src = source->snapshot_layers();
+    if (src.size() != layers.size()) {
         Logger::error("NeuralNetworkNode::copy_weights - incompatible network sizes");
         return;
     }
+    wait_for_training();
     for (size_t i = 0; i < layers.size(); ++i)
-        layers[i].copy_weights(source->layers[i]);
+        layers[i].copy_weights(src[i]);
+    refresh_inference_copies();
+    if (async_training)
+        publish_snapshot();
     Logger::debug(1, "NeuralNetworkNode::copy_weights - success");
 }
 
+void NeuralNetworkNode::set_model(const godot::Ref<NeuralModel> &p_model) {
+    model = p_model;
+    if (model.is_null())
+        return;
+    wait_for_training();
+
+    // Reference the model's parameters; a later backward() copies a layer
+    // before updating it, so the model itself is never modified
+    layers.clear();
+    layers_config.clear();
+    for (const NeuralModel::LayerSpec &spec : model->get_specs()) {
+        Layer layer(spec.params, learning_rate, spec.activation);
+        layer.set_verbosity(verbosity);
+        layers.push_back(layer);
+
+        godot::Dictionary d;
+        d["input_size"] = layer.get_input_size();
+        d["output_size"] = layer.get_output_size();
+        d["activation"] = godot::String(spec.activation.c_str());
+        layers_config.push_back(d);
+    }
+    refresh_inference_copies();
+    if (async_training)
+        publish_snapshot();
+    Logger::debug(1, "NeuralNetworkNode::set_model - sharing " + std::to_string(layers.size()) + " layers");
+}
+
+godot::Ref<NeuralModel> NeuralNetworkNode::export_model() const {
+    godot::Ref<NeuralModel> out = NeuralModel::from_layers(snapshot_layers());
+    // Saved with the same precision the node runs inference at
+    out->set_storage_format(static_cast<NeuralModel::WeightFormat>(weight_storage));
+    return out;
+}
+
+bool NeuralNetworkNode::is_sharing_weights() const {
+    // The worker may be replacing the parameter pointers in `layers`
+    if (async_training) {
+        const std::shared_ptr<const Snapshot> snap = load_snapshot();
+        return snap && snap->sharing_weights;
+    }
+    for (const auto &layer : layers)
+        if (layer.is_shared())
+            return true;
+    return false;
+}
+
+std::vector<Layer> NeuralNetworkNode::snapshot_layers() const {
+    std::shared_ptr<const Snapshot> snap;
+    if (async_training)
+        snap = load_snapshot();
+    const std::vector<Layer> &src = snap ? snap->layers : layers;
+
+    std::vector<Layer> out;
+    out.reserve(src.size());
+    for (const auto &layer : src)
+        out.push_back(layer.shallow_copy());
+    return out;
+}
+
+NeuralNetworkNode::InferenceStack NeuralNetworkNode::snapshot_inference_stack() const {
+    InferenceStack stack;
+    if (!quantized_layers.empty())
+        stack.quantized = quantized_layers;
+    else if (!half_layers.empty())
+        stack.half = half_layers;
+    else
+        stack.layers = snapshot_layers();
+    return stack;
+}
+
+const Eigen::MatrixXf &NeuralNetworkNode::InferenceStack::infer(const Eigen::MatrixXf &X, InferenceScratch &scratch) const {
+    if (!quantized.empty())
+        return QuantizedLayer::infer_stack(quantized, X, scratch);
+    if (!half.empty())
+        return HalfLayer::infer_stack(half, X, scratch);
+    return Layer::infer_stack(layers, X, scratch);
+}
+
+int NeuralNetworkNode::get_input_size() const {
+    // Sizes never change during training, but the worker may be swapping the
+    // parameter pointers in `layers`, so read the published copy
+    std::shared_ptr<const Snapshot> snap;
+    if (async_training)
+        snap = load_snapshot();
+    const std::vector<Layer> &src = snap ? snap->layers : layers;
+    return src.empty() ? 0 : src.front().get_input_size();
+}
+
+int NeuralNetworkNode::get_output_size() const {
+    std::shared_ptr<const Snapshot> snap;
+    if (async_training)
+        snap = load_snapshot();
+    const std::vector<Layer> &src = snap ? snap->layers : layers;
+    return src.empty() ? 0 : src.back().get_output_size();
+}
+
 void NeuralNetworkNode::set_layers(const godot::Array &p_layers) {
     layers_config = p_layers;
     if (layers_config.size() > 0)
@@ -178,7 +1247,11 @@ godot::Array NeuralNetworkNode::get_layers() const {
 }
 
 void NeuralNetworkNode::build_model() {
+    wait_for_training();
+    // A rebuilt stack no longer reflects the assigned model
+    model.unref();
     layers.clear();
+    refresh_inference_copies();
     for (int i = 0; i < layers_config.size(); ++i) {
         godot::Dictionary d = layers_config[i];
         int in_size = (int)d.get("input_size", 1);
@@ -186,13 +1259,20 @@ void NeuralNetworkNode::build_model() {
         godot::String act = d.get("activation", "relu");
         add_layer(in_size, out_size, act);
     }
+    if (async_training)
+        publish_snapshot();
     Logger::debug(1, "NeuralNetworkNode::build_model - model rebuilt");
 }
 
 void NeuralNetworkNode::model_summary() {
+    std::shared_ptr<const Snapshot> snap;
+    if (async_training)
+        snap = load_snapshot();
+    const std::vector<Layer> &src = snap ? snap->layers : layers;
+
     Logger::info("----------- Model Summary -----------");
-    for (int i = 0; i < layers.size(); ++i) {
-        const auto &layer = layers[i];
+    for (int i = 0; i < src.size(); ++i) {
+        const auto &layer = src[i];
         std::ostringstream ss;
         ss << "Layer " << i << " | in=" << layer.get_input_size()
            << " out=" << layer.get_output_size()
@@ -4,6 +4,18 @@
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/core/class_db.hpp>
 #include "models/neural_network/layer/layer.h"
+#include "models/neural_network/layer/quantized_layer.h"
+#include "models/neural_network/layer/half_layer.h"
+#include "models/neural_network/neural_model.h"
+#include "losses/loss_node/loss_node.h"
+#include "matrix/matrix.h"
+#include "utility/profiler.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 class NeuralNetworkNode : public godot::Node {
     GDCLASS(NeuralNetworkNode, godot::Node);
@@ -12,9 +24,127 @@ private:
     double learning_rate = 0.001;   // safer default
     std::vector<Layer> layers;
     godot::Array layers_config;
+    godot::Ref<NeuralModel> model;
     int verbosity = 0;
     int batch_size = 1;
 
+    using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    // --- Asynchronous training ---
+    // The worker trains `layers` in place; predict() reads `published`, a
+    // parameter-sharing copy swapped in atomically every publish_interval steps.
+    // Copy-on-write in Layer keeps the published weights immutable.
+    struct TrainJob {
+        Eigen::MatrixXf X;
+        RowMat Y;
+        std::vector<float> weights;
+        godot::Ref<LossNode> loss;
+    };
+    struct Snapshot {
+        std::vector<Layer> layers;
+        uint64_t step = 0;
+        // is_sharing_weights() for these layers, worked out when publishing
+        bool sharing_weights = false;
+    };
+
+    bool async_training = false;
+    int publish_interval = 4;
+    int max_queued_steps = 8;
+
+    std::mutex job_mutex;
+    std::deque<TrainJob> jobs;
+    bool worker_active = false;
+    int64_t task_id = -1;
+
+    std::shared_ptr<const Snapshot> published;
+    std::atomic<uint64_t> training_steps{0};
+    std::atomic<float> last_loss{0.0f};
+
+    // --- Asynchronous checkpoints ---
+    // checkpoint_async() captures the layers between training steps (params
+    // are shared copy-on-write, momentum is copied); a writer thread
+    // serializes and writes them, then emits checkpoint_saved.
+    struct CheckpointRequest {
+        godot::String path;   // may contain "{step}"
+        bool include_optimizer = true;
+    };
+    struct CheckpointJob {
+        CheckpointRequest request;
+        std::vector<Layer> layers;
+        uint64_t step = 0;
+    };
+
+    std::vector<CheckpointRequest> checkpoint_requests;   // guarded by job_mutex
+
+    std::mutex checkpoint_mutex;
+    std::condition_variable checkpoint_cv;
+    std::deque<CheckpointJob> checkpoint_jobs;
+    int checkpoints_in_flight = 0;
+    bool checkpoint_stop = false;
+    std::thread checkpoint_thread;
+    std::atomic<int> checkpoint_keep_last{0};
+    std::deque<godot::String> checkpoint_history;   // writer thread only
+
+    CheckpointJob capture_checkpoint(const CheckpointRequest &request) const;
+    void enqueue_checkpoint(CheckpointJob job);
+    void checkpoint_writer();
+    static godot::Error write_checkpoint_file(const godot::String &path, const std::vector<uint8_t> &bytes);
+
+    // --- Data-parallel training ---
+    // train_step() splits batches of at least 2 * MIN_SHARD_ROWS rows across
+    // training_threads replicas; gradients are tree-reduced in shard order.
+    static constexpr int MIN_SHARD_ROWS = 16;
+    int training_threads = 1;
+
+    // --- Inference-only weights ---
+    // Int8 view of `layers` used by predict() between quantize() and
+    // dequantize(), and a 16-bit view while weight_storage is not Float32.
+    // Their weights are cached in the shared LayerParams, so nodes sharing
+    // a model share one encoded copy; the fp32 weights are kept alongside.
+    // Training calls are rejected while either is active.
+    std::vector<QuantizedLayer> quantized_layers;
+    std::vector<float> activation_ranges;   // calibrated max |input| per layer
+    int weight_storage = NeuralModel::WEIGHTS_FLOAT32;
+    std::vector<HalfLayer> half_layers;
+
+    bool is_inference_only() const { return !quantized_layers.empty() || !half_layers.empty(); }
+    void rebuild_half_layers();
+    // Called whenever `layers` get new weights
+    void refresh_inference_copies();
+
+    // --- Profiling ---
+    // Per-layer training timings, filled while Profiler is enabled. Only the
+    // training thread resizes the vector, under profile_mutex.
+    struct LayerProfile {
+        Profiler::Counter forward;
+        Profiler::Counter backward;
+    };
+    std::vector<LayerProfile> layer_profile;
+    mutable std::mutex profile_mutex;
+    // True, with layer_profile sized to `layers`, when this step is timed
+    bool prepare_layer_profile();
+
+    Eigen::MatrixXf forward_pass(const Eigen::MatrixXf &x);
+    void backward_pass(Eigen::MatrixXf grad);
+    // Global-norm clip followed by the per-layer update
+    void apply_gradients();
+    double train_batch(const Eigen::MatrixXf &X, const RowMat &Y, LossNode *loss, const float *weights);
+    double train_batch_sharded(const Eigen::MatrixXf &X, const RowMat &Y, LossNode *loss, const float *weights,
+                               int shards);
+    int shard_count(int rows) const;
+    // Runs one step and returns the new step count
+    uint64_t run_job(const TrainJob &job);
+    bool make_job(const godot::Array &inputs, const godot::Array &targets, const godot::Ref<LossNode> &loss,
+                  const godot::PackedFloat32Array &weights, TrainJob &job) const;
+    bool make_job(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets,
+                  const godot::Ref<LossNode> &loss, const godot::PackedFloat32Array &weights, TrainJob &job) const;
+    bool finish_job(const godot::Ref<LossNode> &loss, const godot::PackedFloat32Array &weights, TrainJob &job) const;
+    bool can_train_sync(const char *caller) const;
+
+    void train_worker();
+    void publish_snapshot();
+    std::shared_ptr<const Snapshot> load_snapshot() const;
+
 protected:
     static void _bind_methods();
 
@@ -26,12 +156,88 @@ public:
     void add_layer(int input_size, int output_size, godot::String activation);
     godot::Array forward(godot::Array input);
     void backward(godot::Array error);
-    godot::Array predict(godot::Array input);
+    godot::Array predict(godot::Array input) const;
+    godot::Ref<godot::Matrix> predict_matrix(const godot::Ref<godot::Matrix> &input) const;
+    godot::PackedFloat32Array predict_packed(const godot::PackedFloat32Array &input) const;
+    // Re-entrant inference into caller-owned buffers; never touches layer caches.
+    // The returned reference points into scratch and is valid until its next use.
+    const Eigen::MatrixXf &predict_into(const Eigen::MatrixXf &X, InferenceScratch &scratch) const;
+
+    // Native training with a LossNode
+    float train_step(godot::Array inputs, godot::Array targets, const godot::Ref<LossNode> &loss,
+                     const godot::PackedFloat32Array &weights = godot::PackedFloat32Array());
+    // Same as train_step() for contiguous batches, e.g. from a Dataset
+    float train_step_matrix(const godot::Ref<godot::Matrix> &inputs, const godot::Ref<godot::Matrix> &targets,
+                            const godot::Ref<LossNode> &loss,
+                            const godot::PackedFloat32Array &weights = godot::PackedFloat32Array());
+    bool train_async(godot::Array inputs, godot::Array targets, const godot::Ref<LossNode> &loss,
+                     const godot::PackedFloat32Array &weights = godot::PackedFloat32Array());
+    void wait_for_training();
+
+    void set_async_training(bool enabled);
+    bool get_async_training() const { return async_training; }
+    void set_publish_interval(int steps);
+    int get_publish_interval() const { return publish_interval; }
+    void set_max_queued_steps(int steps) { max_queued_steps = steps > 0 ? steps : 1; }
+    int get_max_queued_steps() const { return max_queued_steps; }
+    int64_t get_training_steps() const { return static_cast<int64_t>(training_steps.load()); }
+    int64_t get_published_step() const;
+    float get_last_loss() const { return last_loss.load(); }
+    void set_training_threads(int threads);
+    int get_training_threads() const { return training_threads; }
+
+    // Quantized inference
+    void calibrate(godot::Array inputs);
+    void clear_calibration() { activation_ranges.clear(); }
+    bool quantize();
+    void dequantize() { quantized_layers.clear(); }
+    bool is_quantized() const { return !quantized_layers.empty(); }
+    godot::Dictionary get_quantization_report(godot::Array inputs) const;
+
+    // 16-bit weight storage
+    void set_weight_storage(int format);
+    int get_weight_storage() const { return weight_storage; }
+
+    // Checkpoints (see checkpoint.h for the format)
+    godot::Error save_model(const godot::String &path, bool include_optimizer = true);
+    godot::Error load_model(const godot::String &path);
+    // Weights trained elsewhere, from an uncompressed .npz archive
+    godot::Error load_weights_npz(const godot::String &path, const godot::Dictionary &mapping);
+    godot::Error checkpoint_async(const godot::String &path, bool include_optimizer = true);
+    void wait_for_checkpoints();
+    void set_checkpoint_keep_last(int count) { checkpoint_keep_last.store(count > 0 ? count : 0); }
+    int get_checkpoint_keep_last() const { return checkpoint_keep_last.load(); }
+
+    // Per-layer forward/backward timings (see Profiler)
+    godot::Dictionary get_profile() const;
+    void reset_profile();
 
     // Utilities
     void model_summary();
     void copy_weights(const NeuralNetworkNode* source);
 
+    // Shared weights
+    void set_model(const godot::Ref<NeuralModel> &p_model);
+    godot::Ref<NeuralModel> get_model() const { return model; }
+    godot::Ref<NeuralModel> export_model() const;
+    bool is_sharing_weights() const;
+    // Parameter-sharing copy of the layer stack for inference off the node
+    std::vector<Layer> snapshot_layers() const;
+
+    // The stack predict() runs: int8 or 16-bit when active, otherwise fp32.
+    // Only one of the vectors is filled; all share the node's weights.
+    struct InferenceStack {
+        std::vector<Layer> layers;
+        std::vector<QuantizedLayer> quantized;
+        std::vector<HalfLayer> half;
+
+        const Eigen::MatrixXf &infer(const Eigen::MatrixXf &X, InferenceScratch &scratch) const;
+    };
+    InferenceStack snapshot_inference_stack() const;
+
+    int get_input_size() const;
+    int get_output_size() const;
+
     // Getters / Setters
     void set_verbosity(int level);
     int get_verbosity() const { return verbosity; }
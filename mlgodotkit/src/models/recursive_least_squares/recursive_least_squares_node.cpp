@@ -0,0 +1,135 @@
+#include "recursive_least_squares_node.h"
+#include "utility/logger.h"
+#include <cmath>
+
+void RecursiveLeastSquaresNode::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_method(D_METHOD("initialize", "input_size", "output_size"), &RecursiveLeastSquaresNode::initialize, DEFVAL(1));
+    ClassDB::bind_method(D_METHOD("reset"), &RecursiveLeastSquaresNode::reset);
+    ClassDB::bind_method(D_METHOD("partial_fit", "inputs", "targets"), &RecursiveLeastSquaresNode::partial_fit);
+    ClassDB::bind_method(D_METHOD("predict", "inputs"), &RecursiveLeastSquaresNode::predict);
+    ClassDB::bind_method(D_METHOD("get_weights"), &RecursiveLeastSquaresNode::get_weights);
+    ClassDB::bind_method(D_METHOD("get_samples_seen"), &RecursiveLeastSquaresNode::get_samples_seen);
+
+    ClassDB::bind_method(D_METHOD("set_forgetting_factor", "lambda"), &RecursiveLeastSquaresNode::set_forgetting_factor);
+    ClassDB::bind_method(D_METHOD("get_forgetting_factor"), &RecursiveLeastSquaresNode::get_forgetting_factor);
+    ClassDB::bind_method(D_METHOD("set_initial_covariance", "delta"), &RecursiveLeastSquaresNode::set_initial_covariance);
+    ClassDB::bind_method(D_METHOD("get_initial_covariance"), &RecursiveLeastSquaresNode::get_initial_covariance);
+    ClassDB::bind_method(D_METHOD("set_fit_intercept", "enabled"), &RecursiveLeastSquaresNode::set_fit_intercept);
+    ClassDB::bind_method(D_METHOD("get_fit_intercept"), &RecursiveLeastSquaresNode::get_fit_intercept);
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "forgetting_factor",
+        PROPERTY_HINT_RANGE, "0.9,1.0,0.0001"),
+        "set_forgetting_factor", "get_forgetting_factor");
+
+    ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "initial_covariance",
+        PROPERTY_HINT_RANGE, "0.001,1000000.0,0.001,or_greater"),
+        "set_initial_covariance", "get_initial_covariance");
+
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "fit_intercept"),
+        "set_fit_intercept", "get_fit_intercept");
+}
+
+void RecursiveLeastSquaresNode::initialize(int input_size, int output_size) {
+    ERR_FAIL_COND_MSG(input_size < 1 || output_size < 1, "input_size and output_size must be positive");
+
+    num_features = input_size;
+    num_outputs = output_size;
+
+    const int d = num_features + (fit_intercept ? 1 : 0);
+    weights = Eigen::MatrixXf::Zero(d, num_outputs);
+    P = Eigen::MatrixXf::Identity(d, d) * static_cast<float>(initial_covariance);
+
+    x_aug.resize(d);
+    Px.resize(d);
+    gain.resize(d);
+    err.resize(num_outputs);
+    samples_seen = 0;
+}
+
+void RecursiveLeastSquaresNode::reset() {
+    if (num_features > 0)
+        initialize(num_features, num_outputs);
+}
+
+void RecursiveLeastSquaresNode::update_sample(const float *x, const float *y) {
+    const float lambda = static_cast<float>(forgetting_factor);
+
+    x_aug.head(num_features) = Eigen::Map<const Eigen::VectorXf>(x, num_features);
+    if (fit_intercept)
+        x_aug(num_features) = 1.0f;
+
+    // k = P x / (lambda + x^T P x)
+    Px.noalias() = P * x_aug;
+    const float denom = lambda + x_aug.dot(Px);
+    if (!(denom > 0.0f) || !std::isfinite(denom)) {
+        Logger::warn("RecursiveLeastSquaresNode - skipped ill-conditioned sample");
+        return;
+    }
+    gain = Px / denom;
+
+    // w += k (y - w^T x)^T
+    err = Eigen::Map<const Eigen::VectorXf>(y, num_outputs);
+    err.noalias() -= weights.transpose() * x_aug;
+    weights.noalias() += gain * err.transpose();
+
+    // P = (P - k (P x)^T) / lambda; P is symmetric so only the outer product is needed
+    P.noalias() -= gain * Px.transpose();
+    P /= lambda;
+
+    // Re-symmetrize now and then to stop round-off from drifting P
+    if ((++samples_seen & 63) == 0)
+        P = 0.5f * (P + P.transpose()).eval();
+}
+
+void RecursiveLeastSquaresNode::partial_fit(godot::Array inputs, godot::Array targets) {
+    Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    Eigen::MatrixXf Y = Utils::godot_to_eigen(targets);
+
+    if (num_features == 0)
+        initialize(X.cols(), Y.cols());
+
+    ERR_FAIL_COND_MSG(X.rows() != Y.rows(), "Inputs and targets row mismatch");
+    ERR_FAIL_COND_MSG(X.cols() != num_features, "Input feature count does not match the model");
+    ERR_FAIL_COND_MSG(Y.cols() != num_outputs, "Target column count does not match the model");
+
+    // Row-major copies keep each sample contiguous for the per-row update
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Xr = X;
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Yr = Y;
+    for (int i = 0; i < Xr.rows(); ++i)
+        update_sample(Xr.row(i).data(), Yr.row(i).data());
+}
+
+godot::Array RecursiveLeastSquaresNode::predict(godot::Array inputs) {
+    ERR_FAIL_COND_V(weights.size() == 0, godot::Array());
+
+    Eigen::MatrixXf X = Utils::godot_to_eigen(inputs);
+    ERR_FAIL_COND_V_MSG(X.cols() != num_features, godot::Array(), "Input feature count does not match the model");
+
+    Eigen::MatrixXf preds = X * weights.topRows(num_features);
+    if (fit_intercept)
+        preds.rowwise() += weights.row(num_features);
+    return Utils::eigen_to_godot(preds);
+}
+
+godot::Array RecursiveLeastSquaresNode::get_weights() const {
+    return Utils::eigen_to_godot(weights);
+}
+
+void RecursiveLeastSquaresNode::set_forgetting_factor(double lambda) {
+    if (lambda <= 0.0 || lambda > 1.0) {
+        ERR_PRINT("Warning: forgetting_factor must be in (0, 1]. Clamping.");
+        lambda = lambda <= 0.0 ? 0.9 : 1.0;
+    }
+    forgetting_factor = lambda;
+}
+
+void RecursiveLeastSquaresNode::set_initial_covariance(double delta) {
+    initial_covariance = delta > 0.0 ? delta : 1.0;
+}
+
+void RecursiveLeastSquaresNode::set_fit_intercept(bool enabled) {
+    fit_intercept = enabled;
+    if (num_features > 0)
+        initialize(num_features, num_outputs);
+}
@@ -0,0 +1,61 @@
+#ifndef RECURSIVE_LEAST_SQUARES_NODE_H
+#define RECURSIVE_LEAST_SQUARES_NODE_H
+
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+#include <Eigen/Dense>
+#include "utility/utils.h"
+
+// Online linear regression via recursive least squares.
+// Each sample is a rank-1 update of the inverse covariance, O(d^2) per sample,
+// with an exponential forgetting factor so the model can track drift.
+class RecursiveLeastSquaresNode : public godot::Node {
+    GDCLASS(RecursiveLeastSquaresNode, godot::Node);
+
+private:
+    // (d + 1) x k, bias is the last row when fit_intercept is set
+    Eigen::MatrixXf weights;
+    // Inverse covariance, (d + 1) x (d + 1)
+    Eigen::MatrixXf P;
+
+    // Per-sample scratch, sized once in initialize()
+    Eigen::VectorXf x_aug;
+    Eigen::VectorXf Px;
+    Eigen::VectorXf gain;
+    Eigen::VectorXf err;
+
+    int num_features = 0;
+    int num_outputs = 1;
+    int samples_seen = 0;
+
+    double forgetting_factor = 0.99;
+    double initial_covariance = 1000.0;
+    bool fit_intercept = true;
+
+    void update_sample(const float *x, const float *y);
+
+protected:
+    static void _bind_methods();
+
+public:
+    RecursiveLeastSquaresNode() = default;
+
+    void initialize(int input_size, int output_size = 1);
+    void reset();
+
+    void partial_fit(godot::Array inputs, godot::Array targets);
+    godot::Array predict(godot::Array inputs);
+
+    godot::Array get_weights() const;
+    int get_samples_seen() const { return samples_seen; }
+
+    void set_forgetting_factor(double lambda);
+    double get_forgetting_factor() const { return forgetting_factor; }
+    void set_initial_covariance(double delta);
+    double get_initial_covariance() const { return initial_covariance; }
+    void set_fit_intercept(bool enabled);
+    bool get_fit_intercept() const { return fit_intercept; }
+};
+
+#endif // RECURSIVE_LEAST_SQUARES_NODE_H
@@ -0,0 +1,104 @@
+#include "lbfgs.h"
+#include "utility/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+LBFGS::LBFGS() {}
+LBFGS::LBFGS(const Options &options) : opts(options) {}
+
+LBFGS::Result LBFGS::minimize(const Objective &f, Eigen::VectorXd &x) {
+    const int n = x.size();
+    const int m = std::max(1, opts.history_size);
+
+    // Ring buffers of the last m curvature pairs
+    std::vector<Eigen::VectorXd> S(m, Eigen::VectorXd(n));
+    std::vector<Eigen::VectorXd> Y(m, Eigen::VectorXd(n));
+    std::vector<double> rho(m), alpha(m);
+    int stored = 0, head = 0;
+
+    Eigen::VectorXd g(n), g_new(n), d(n), x_new(n), s(n), y(n);
+    Result result;
+    result.value = f(x, g);
+
+    if (!std::isfinite(result.value)) {
+        Logger::warn("LBFGS - objective is not finite at the starting point");
+        return result;
+    }
+
+    for (int iter = 0; iter < opts.max_iterations; ++iter) {
+        if (g.lpNorm<Eigen::Infinity>() <= opts.gradient_tolerance) {
+            result.converged = true;
+            break;
+        }
+
+        // Two-loop recursion: d = -H g
+        d = -g;
+        for (int k = 0; k < stored; ++k) {
+            const int i = (head - 1 - k + m) % m;
+            alpha[i] = rho[i] * S[i].dot(d);
+            d.noalias() -= alpha[i] * Y[i];
+        }
+        if (stored > 0) {
+            const int last = (head - 1 + m) % m;
+            d *= S[last].dot(Y[last]) / Y[last].squaredNorm();
+        }
+        for (int k = stored - 1; k >= 0; --k) {
+            const int i = (head - 1 - k + m) % m;
+            const double beta = rho[i] * Y[i].dot(d);
+            d.noalias() += (alpha[i] - beta) * S[i];
+        }
+
+        double gd = g.dot(d);
+        if (!(gd < 0.0)) {
+            // Not a descent direction; restart from steepest descent
+            stored = 0;
+            d = -g;
+            gd = -g.squaredNorm();
+        }
+
+        // Backtracking line search with the Armijo condition
+        double step = (stored == 0) ? std::min(1.0, 1.0 / std::max(1e-12, g.norm())) : 1.0;
+        const double c1 = 1e-4;
+        double f_new = 0.0;
+        bool accepted = false;
+        for (int ls = 0; ls < opts.max_line_search; ++ls) {
+            x_new = x + step * d;
+            f_new = f(x_new, g_new);
+            if (std::isfinite(f_new) && f_new <= result.value + c1 * step * gd) {
+                accepted = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        if (!accepted)
+            break;
+
+        // Curvature pair; skipped when it would break positive definiteness.
+        // Built outside the ring: once it is full, S[head] is the oldest pair
+        // still in use and must survive a rejected one.
+        s = x_new - x;
+        y = g_new - g;
+        const double sy = s.dot(y);
+        if (sy > 1e-10 * y.squaredNorm()) {
+            S[head].swap(s);
+            Y[head].swap(y);
+            rho[head] = 1.0 / sy;
+            head = (head + 1) % m;
+            stored = std::min(stored + 1, m);
+        }
+
+        const double decrease = result.value - f_new;
+        x.swap(x_new);
+        g.swap(g_new);
+        result.value = f_new;
+        result.iterations = iter + 1;
+
+        if (decrease <= opts.function_tolerance * std::max(1.0, std::abs(f_new))) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    return result;
+}
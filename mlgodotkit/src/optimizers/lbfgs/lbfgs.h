@@ -0,0 +1,37 @@
+#ifndef LBFGS_H
+#define LBFGS_H
+
+#include <Eigen/Dense>
+#include <functional>
+
+// Limited-memory BFGS for smooth unconstrained problems.
+// The objective returns f(x) and writes the gradient into its second argument.
+class LBFGS {
+public:
+    using Objective = std::function<double(const Eigen::VectorXd &x, Eigen::VectorXd &grad)>;
+
+    struct Options {
+        int history_size = 10;
+        int max_iterations = 100;
+        double gradient_tolerance = 1e-5;   // on ||g||_inf
+        double function_tolerance = 1e-9;   // relative decrease per iteration
+        int max_line_search = 30;
+    };
+
+    struct Result {
+        double value = 0.0;
+        int iterations = 0;
+        bool converged = false;
+    };
+
+    LBFGS();
+    explicit LBFGS(const Options &options);
+
+    // Minimizes in place starting from x.
+    Result minimize(const Objective &f, Eigen::VectorXd &x);
+
+private:
+    Options opts;
+};
+
+#endif // LBFGS_H
@@ -2,14 +2,21 @@
 
 using namespace godot;
 
+static GodotLogSink godot_log_sink;
+
 void initialize_mlgodotkit_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE)
         return;
 
+    Logger::set_sink(&godot_log_sink);
 
     // Models
     GDREGISTER_CLASS(LinearRegressionNode);
+    GDREGISTER_CLASS(RecursiveLeastSquaresNode);
+    GDREGISTER_CLASS(LogisticRegressionNode);
     GDREGISTER_CLASS(NeuralNetworkNode);
+    GDREGISTER_CLASS(NeuralModel);
+    GDREGISTER_CLASS(InferenceServer);
     GDREGISTER_CLASS(LinearModelNode);
     GDREGISTER_CLASS(DecisionTreeNode);
 
@@ -19,15 +26,34 @@ void initialize_mlgodotkit_module(ModuleInitializationLevel p_level) {
     //Loss Functions
     GDREGISTER_CLASS(LossNode);
     GDREGISTER_CLASS(MSELossNode);
+    GDREGISTER_CLASS(HuberLossNode);
+    GDREGISTER_CLASS(BCEWithLogitsLossNode);
+    GDREGISTER_CLASS(SoftmaxCrossEntropyLossNode);
 
     // Utility
     GDREGISTER_CLASS(Linalg);
+    GDREGISTER_CLASS(Factorization);
+    GDREGISTER_CLASS(LUFactorization);
+    GDREGISTER_CLASS(CholeskyFactorization);
+    GDREGISTER_CLASS(QRFactorization);
     GDREGISTER_CLASS(Matrix);
+    GDREGISTER_CLASS(MatrixView);
+    GDREGISTER_CLASS(SparseMatrix);
+    GDREGISTER_CLASS(Profiler);
+
+    // Data
+    GDREGISTER_CLASS(Dataset);
+    GDREGISTER_CLASS(ExperienceRecorder);
+
+    Profiler::register_monitors();
 }
 
 void uninitialize_mlgodotkit_module(ModuleInitializationLevel p_level) {
     if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE)
         return;
+
+    Profiler::unregister_monitors();
+    Logger::set_sink(nullptr);
 }
 
 extern "C" {
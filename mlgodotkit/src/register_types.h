@@ -3,20 +3,39 @@
 
 //Primative Classes
 #include "matrix/matrix.h"
+#include "matrix/matrix_view.h"
+#include "matrix/sparse_matrix.h"
+
+// Data
+#include "data/dataset.h"
+#include "data/experience_recorder.h"
 
 // Utility Classes
 #include "utility/utils.h"
+#include "utility/profiler.h"
+#include "utility/godot_log_sink.h"
 #include "linalg/linalg.h"
+#include "linalg/factorizations/factorization.h"
+#include "linalg/factorizations/lu_factorization.h"
+#include "linalg/factorizations/cholesky_factorization.h"
+#include "linalg/factorizations/qr_factorization.h"
 
 // Model Classes
 #include "models/linear_regression/linear_regression_node.h"
+#include "models/recursive_least_squares/recursive_least_squares_node.h"
+#include "models/logistic_regression/logistic_regression_node.h"
 #include "models/neural_network/neural_network_node.h"
+#include "models/neural_network/neural_model.h"
+#include "models/neural_network/inference_server.h"
 #include "models/linear_model/linear_model_node.h"
 #include "models/decision_tree/decision_tree_node.h"
 
 // Loss Fucntions
 #include "losses/loss_node/loss_node.h"
 #include "losses/mse_loss_node/mse_loss_node.h"
+#include "losses/huber_loss_node/huber_loss_node.h"
+#include "losses/bce_with_logits_loss_node/bce_with_logits_loss_node.h"
+#include "losses/softmax_cross_entropy_loss_node/softmax_cross_entropy_loss_node.h"
 
 // Control Theory
 #include "control/pid_controller/pid_controller_node.h"
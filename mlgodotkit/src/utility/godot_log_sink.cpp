@@ -0,0 +1,24 @@
+#include "godot_log_sink.h"
+#include <godot_cpp/core/error_macros.hpp>
+#include <godot_cpp/variant/utility_functions.hpp>
+
+void GodotLogSink::write(Logger::Level level, const std::string &msg) {
+    const godot::String text = godot::String::utf8(msg.c_str());
+    switch (level) {
+        case Logger::LEVEL_DEBUG:
+            godot::UtilityFunctions::print_rich("[color=#888888]" + text + "[/color]");
+            break;
+        case Logger::LEVEL_INFO:
+            godot::UtilityFunctions::print(text);
+            break;
+        case Logger::LEVEL_WARN:
+            godot::UtilityFunctions::push_warning(text);
+            break;
+        case Logger::LEVEL_ERROR:
+            godot::UtilityFunctions::push_error(text);
+            break;
+        case Logger::LEVEL_FATAL:
+            ERR_PRINT(text);
+            break;
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef GODOT_LOG_SINK_H
+#define GODOT_LOG_SINK_H
+
+#include "utility/logger.h"
+
+// Routes Logger output to the editor/console: debug and info to the output
+// panel, warnings and errors to the debugger's error list.
+class GodotLogSink : public Logger::Sink {
+public:
+    void write(Logger::Level level, const std::string &msg) override;
+};
+
+#endif // GODOT_LOG_SINK_H
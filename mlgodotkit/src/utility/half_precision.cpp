@@ -0,0 +1,49 @@
+#include "half_precision.h"
+#include <Eigen/Core>
+#include <cstring>
+
+namespace HalfPrecision {
+
+	int value_size(Format format) {
+		return format == FLOAT32 ? 4 : 2;
+	}
+
+	void encode(const float *src, int64_t n, Format format, uint8_t *dst) {
+		const Eigen::Map<const Eigen::ArrayXf> in(src, n);
+		switch (format) {
+			case FLOAT16: {
+				Eigen::Map<Eigen::Array<Eigen::half, Eigen::Dynamic, 1>> out(reinterpret_cast<Eigen::half *>(dst), n);
+				out = in.cast<Eigen::half>();
+				break;
+			}
+			case BFLOAT16: {
+				Eigen::Map<Eigen::Array<Eigen::bfloat16, Eigen::Dynamic, 1>> out(reinterpret_cast<Eigen::bfloat16 *>(dst), n);
+				out = in.cast<Eigen::bfloat16>();
+				break;
+			}
+			case FLOAT32:
+			default:
+				std::memcpy(dst, src, static_cast<size_t>(n) * sizeof(float));
+				break;
+		}
+	}
+
+	void decode(const uint8_t *src, int64_t n, Format format, float *dst) {
+		Eigen::Map<Eigen::ArrayXf> out(dst, n);
+		switch (format) {
+			case FLOAT16:
+				out = Eigen::Map<const Eigen::Array<Eigen::half, Eigen::Dynamic, 1>>(
+					reinterpret_cast<const Eigen::half *>(src), n).cast<float>();
+				break;
+			case BFLOAT16:
+				out = Eigen::Map<const Eigen::Array<Eigen::bfloat16, Eigen::Dynamic, 1>>(
+					reinterpret_cast<const Eigen::bfloat16 *>(src), n).cast<float>();
+				break;
+			case FLOAT32:
+			default:
+				std::memcpy(dst, src, static_cast<size_t>(n) * sizeof(float));
+				break;
+		}
+	}
+
+} // namespace HalfPrecision
@@ -0,0 +1,26 @@
+#ifndef HALF_PRECISION_H
+#define HALF_PRECISION_H
+
+#include <cstdint>
+
+// 16-bit float encodings for weight storage. Values go through Eigen::half /
+// Eigen::bfloat16 (round to nearest even) and are packed in native byte
+// order, two bytes per value.
+namespace HalfPrecision {
+
+	enum Format {
+		FLOAT32 = 0,
+		FLOAT16 = 1,
+		BFLOAT16 = 2,
+	};
+
+	// Bytes per value for a format
+	int value_size(Format format);
+
+	// dst holds n * value_size(format) bytes
+	void encode(const float *src, int64_t n, Format format, uint8_t *dst);
+	void decode(const uint8_t *src, int64_t n, Format format, float *dst);
+
+} // namespace HalfPrecision
+
+#endif // HALF_PRECISION_H
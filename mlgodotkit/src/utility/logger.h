@@ -1,15 +1,52 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <atomic>
+#include <cstdio>
 #include <string>
-#include <godot_cpp/variant/utility_functions.hpp>
-#include <godot_cpp/core/error_macros.hpp>
 
+// Engine-independent logging. Messages go to the installed Sink: the
+// extension forwards them to Godot's output (see godot_log_sink.h), the
+// headless core library and benchmark write to stderr.
 namespace Logger {
 
+	enum Level {
+		LEVEL_DEBUG,
+		LEVEL_INFO,
+		LEVEL_WARN,
+		LEVEL_ERROR,
+		LEVEL_FATAL,
+	};
+
+	// Receives fully formatted messages; may be called from any thread
+	class Sink {
+	public:
+		virtual ~Sink() = default;
+		virtual void write(Level level, const std::string &msg) = 0;
+	};
+
+	class StderrSink : public Sink {
+	public:
+		void write(Level, const std::string &msg) override {
+			std::fprintf(stderr, "%s\n", msg.c_str());
+		}
+	};
+
+	inline StderrSink default_sink;
+	inline std::atomic<Sink *> current_sink{&default_sink};
+
 	inline int global_verbosity = 1; // 0 is error, 1 is warning, 2 is info
 
-	// --- Verbosity control ---
+	// --- Output control ---
+	// nullptr restores the stderr sink. The sink must outlive its installation.
+	inline void set_sink(Sink *sink) {
+		current_sink.store(sink ? sink : &default_sink, std::memory_order_release);
+	}
+
+	inline void write(Level level, const std::string &msg) {
+		current_sink.load(std::memory_order_acquire)->write(level, msg);
+	}
+
 	inline void set_verbosity(int level) {
 		global_verbosity = level;
 	}
@@ -17,38 +54,38 @@ namespace Logger {
 	// --- Logging functions ---
 	inline void debug(int level, const std::string &msg) {
 		if (level <= global_verbosity) {
-			godot::UtilityFunctions::print_rich(
-				"[color=#888888][DEBUG] " + godot::String(msg.c_str()) + "[/color]");
+			write(LEVEL_DEBUG, "[DEBUG] " + msg);
 		}
 	}
 
 	inline void info(const std::string &msg) {
-		godot::UtilityFunctions::print(msg.c_str());
+		write(LEVEL_INFO, msg);
 	}
 
 	inline void warn(const std::string &msg) {
-		godot::UtilityFunctions::push_warning(godot::String("[WARN] ") + msg.c_str());
+		write(LEVEL_WARN, "[WARN] " + msg);
 	}
 
 	inline void error(const std::string &msg) {
-		godot::UtilityFunctions::push_error(godot::String("[ERROR] ") + msg.c_str());
+		write(LEVEL_ERROR, "[ERROR] " + msg);
 	}
 
-	// --- Fatal error (halts current function safely) ---
-	inline godot::Error error_raise(const std::string &msg) {
-		ERR_PRINT("[FATAL] " + godot::String(msg.c_str()));
-		return godot::Error::FAILED;
+	// --- Fatal error (caller returns right after) ---
+	inline void error_raise(const std::string &msg) {
+		write(LEVEL_FATAL, "[FATAL] " + msg);
 	}
 
 	// --- Assertion helper ---
-	inline godot::Error assert_raise(bool condition, const std::string &msg) {
+	// Same contract as the godot::Error it used to return, without the engine
+	// dependency: 0 (OK) when the condition holds, 1 (FAILED) otherwise.
+	inline int assert_raise(bool condition, const std::string &msg) {
 		if (!condition) {
-			ERR_PRINT("[ASSERT FAILED] " + godot::String(msg.c_str()));
-			return godot::Error::FAILED;
+			write(LEVEL_FATAL, "[ASSERT FAILED] " + msg);
+			return 1;
 		}
-		return godot::Error::OK;
+		return 0;
 	}
 
 } // namespace Logger
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,87 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	if (!mapped)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(bytes);
+	CloseHandle(mapping_handle);
+	CloseHandle(file_handle);
+#else
+	munmap(const_cast<uint8_t *>(bytes), length);
+#endif
+}
+
+std::shared_ptr<const MappedFile> MappedFile::map(const std::string &path) {
+	std::shared_ptr<MappedFile> out(new MappedFile());
+
+#ifdef _WIN32
+	const int wide_len = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+	std::wstring wide(wide_len, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], wide_len);
+
+	HANDLE file = CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return nullptr;
+	}
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return nullptr;
+	}
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return nullptr;
+	}
+	out->file_handle = file;
+	out->mapping_handle = mapping;
+	out->bytes = static_cast<const uint8_t *>(view);
+	out->length = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return nullptr;
+	}
+	void *view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file alive on its own
+	close(fd);
+	if (view == MAP_FAILED)
+		return nullptr;
+	out->bytes = static_cast<const uint8_t *>(view);
+	out->length = static_cast<size_t>(st.st_size);
+#endif
+
+	out->mapped = true;
+	return out;
+}
+
+std::shared_ptr<const MappedFile> MappedFile::from_bytes(std::vector<uint8_t> bytes) {
+	std::shared_ptr<MappedFile> out(new MappedFile());
+	out->owned = std::move(bytes);
+	out->bytes = out->owned.data();
+	out->length = out->owned.size();
+	return out;
+}
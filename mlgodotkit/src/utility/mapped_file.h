@@ -0,0 +1,42 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. Uses the OS page cache (mmap /
+// MapViewOfFile) when it can, otherwise holds an owned copy of the bytes, so
+// callers never need to know which one they got. Keep the shared_ptr alive
+// for as long as anything points into data().
+class MappedFile {
+public:
+	~MappedFile();
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// nullptr when the file cannot be opened or mapped
+	static std::shared_ptr<const MappedFile> map(const std::string &path);
+	// Wraps bytes that were read some other way (e.g. from a Godot pack)
+	static std::shared_ptr<const MappedFile> from_bytes(std::vector<uint8_t> bytes);
+
+	const uint8_t *data() const { return bytes; }
+	size_t size() const { return length; }
+	bool is_mapped() const { return mapped; }
+
+private:
+	MappedFile() = default;
+
+	const uint8_t *bytes = nullptr;
+	size_t length = 0;
+	bool mapped = false;
+	std::vector<uint8_t> owned;
+#ifdef _WIN32
+	void *file_handle = nullptr;
+	void *mapping_handle = nullptr;
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,279 @@
+#include "npy.h"
+#include <Eigen/Dense>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+using RowMat = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+constexpr char NPY_MAGIC[6] = { '\x93', 'N', 'U', 'M', 'P', 'Y' };
+
+constexpr uint32_t ZIP_LOCAL_HEADER = 0x04034b50u;
+constexpr uint32_t ZIP_CENTRAL_HEADER = 0x02014b50u;
+constexpr uint32_t ZIP_END_OF_DIRECTORY = 0x06054b50u;
+constexpr uint32_t ZIP64_END_OF_DIRECTORY = 0x06064b50u;
+constexpr uint32_t ZIP64_LOCATOR = 0x07064b50u;
+constexpr uint16_t ZIP64_EXTRA_ID = 0x0001u;
+
+// Little-endian field readers; the caller checks bounds
+uint16_t read_u16(const uint8_t *p) { return uint16_t(p[0] | (p[1] << 8)); }
+uint32_t read_u32(const uint8_t *p) { return uint32_t(read_u16(p)) | (uint32_t(read_u16(p + 2)) << 16); }
+uint64_t read_u64(const uint8_t *p) { return uint64_t(read_u32(p)) | (uint64_t(read_u32(p + 4)) << 32); }
+
+void skip_spaces(const std::string &s, size_t &i) {
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n'))
+        ++i;
+}
+
+// Position just past "'key':" in the header dictionary, or npos
+size_t find_value(const std::string &header, const char *key) {
+    size_t i = header.find(std::string("'") + key + "'");
+    if (i == std::string::npos)
+        return i;
+    i = header.find(':', i);
+    if (i == std::string::npos)
+        return i;
+    ++i;
+    skip_spaces(header, i);
+    return i;
+}
+
+// Parses the Python dict literal of an .npy header, e.g.
+// {'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }
+std::string parse_header(const std::string &header, Npy::ArrayView &out) {
+    size_t i = find_value(header, "descr");
+    if (i == std::string::npos || i >= header.size() || (header[i] != '\'' && header[i] != '"'))
+        return "header has no plain 'descr' (structured arrays are not supported)";
+    const char quote = header[i];
+    const size_t end = header.find(quote, i + 1);
+    if (end == std::string::npos)
+        return "malformed header";
+    const std::string descr = header.substr(i + 1, end - i - 1);
+    if (descr != "<f4")
+        return "unsupported dtype '" + descr + "', expected float32 '<f4' (use astype(np.float32))";
+
+    i = find_value(header, "fortran_order");
+    if (i == std::string::npos)
+        return "header has no 'fortran_order'";
+    if (header.compare(i, 4, "True") == 0)
+        out.fortran_order = true;
+    else if (header.compare(i, 5, "False") == 0)
+        out.fortran_order = false;
+    else
+        return "malformed 'fortran_order'";
+
+    i = find_value(header, "shape");
+    if (i == std::string::npos || i >= header.size() || header[i] != '(')
+        return "header has no 'shape'";
+    ++i;
+    out.shape.clear();
+    uint64_t count = 1;
+    while (true) {
+        skip_spaces(header, i);
+        if (i >= header.size())
+            return "malformed 'shape'";
+        if (header[i] == ')')
+            break;
+        if (header[i] < '0' || header[i] > '9')
+            return "malformed 'shape'";
+        uint64_t dim = 0;
+        while (i < header.size() && header[i] >= '0' && header[i] <= '9') {
+            dim = dim * 10 + uint64_t(header[i] - '0');
+            if (dim > uint64_t(std::numeric_limits<int32_t>::max()))
+                return "dimension too large";
+            ++i;
+        }
+        if (dim != 0 && count > std::numeric_limits<uint64_t>::max() / sizeof(float) / dim)
+            return "array too large";
+        count *= dim;
+        out.shape.push_back(int64_t(dim));
+        skip_spaces(header, i);
+        if (i < header.size() && header[i] == ',')
+            ++i;
+    }
+    out.count = size_t(count);
+    return "";
+}
+
+// Locates the central directory, reading the ZIP64 records when present
+std::string find_directory(const uint8_t *bytes, size_t size, uint64_t &offset, uint64_t &entries) {
+    if (size < 22)
+        return "not a zip archive";
+    // The end record sits at the very end, followed by at most a 64 KB comment
+    const size_t lowest = size > 22 + 0xFFFF ? size - 22 - 0xFFFF : 0;
+    size_t eocd = size - 22;
+    while (read_u32(bytes + eocd) != ZIP_END_OF_DIRECTORY) {
+        if (eocd == lowest)
+            return "not a zip archive";
+        --eocd;
+    }
+    entries = read_u16(bytes + eocd + 10);
+    offset = read_u32(bytes + eocd + 16);
+
+    if (entries == 0xFFFF || offset == 0xFFFFFFFFu) {
+        if (eocd < 20 || read_u32(bytes + eocd - 20) != ZIP64_LOCATOR)
+            return "missing zip64 directory locator";
+        const uint64_t record = read_u64(bytes + eocd - 20 + 8);
+        if (size < 56 || record > size - 56 || read_u32(bytes + record) != ZIP64_END_OF_DIRECTORY)
+            return "malformed zip64 directory";
+        entries = read_u64(bytes + record + 32);
+        offset = read_u64(bytes + record + 48);
+    }
+    if (offset > size)
+        return "central directory out of bounds";
+    return "";
+}
+
+} // namespace
+
+bool Npy::ArrayView::matrix_shape(int &rows, int &cols) const {
+    switch (shape.size()) {
+        case 0: rows = 1; cols = 1; return true;
+        case 1: rows = int(shape[0]); cols = 1; return true;
+        case 2: rows = int(shape[0]); cols = int(shape[1]); return true;
+        default: return false;
+    }
+}
+
+std::string Npy::ArrayView::shape_string() const {
+    std::string s = "(";
+    for (size_t i = 0; i < shape.size(); ++i)
+        s += (i ? ", " : "") + std::to_string(shape[i]);
+    return s + (shape.size() == 1 ? ",)" : ")");
+}
+
+std::string Npy::parse_npy(const uint8_t *bytes, size_t size, ArrayView &out) {
+    if (size < 10 || std::memcmp(bytes, NPY_MAGIC, sizeof(NPY_MAGIC)) != 0)
+        return "not an .npy file";
+    const uint8_t major = bytes[6];
+    if (major < 1 || major > 3)
+        return "unsupported .npy version " + std::to_string(major);
+
+    // Version 1 has a 16-bit header length, later versions a 32-bit one
+    const size_t prefix = major == 1 ? 10 : 12;
+    if (size < prefix)
+        return "truncated header";
+    const size_t header_len = major == 1 ? read_u16(bytes + 8) : read_u32(bytes + 8);
+    if (header_len > size - prefix)
+        return "truncated header";
+
+    const std::string header(reinterpret_cast<const char *>(bytes + prefix), header_len);
+    const std::string problem = parse_header(header, out);
+    if (!problem.empty())
+        return problem;
+
+    const size_t data_offset = prefix + header_len;
+    if (out.count > (size - data_offset) / sizeof(float))
+        return "data shorter than shape " + out.shape_string();
+    out.data = bytes + data_offset;
+    return "";
+}
+
+std::string Npy::parse_npz(const uint8_t *bytes, size_t size, Archive &out) {
+    uint64_t offset = 0, entries = 0;
+    std::string problem = find_directory(bytes, size, offset, entries);
+    if (!problem.empty())
+        return problem;
+
+    out.clear();
+    for (uint64_t e = 0; e < entries; ++e) {
+        if (size - offset < 46 || read_u32(bytes + offset) != ZIP_CENTRAL_HEADER)
+            return "malformed central directory";
+        const uint8_t *entry = bytes + offset;
+        const uint16_t flags = read_u16(entry + 8);
+        const uint16_t method = read_u16(entry + 10);
+        uint64_t stored_size = read_u32(entry + 20);
+        uint64_t original_size = read_u32(entry + 24);
+        const uint16_t name_len = read_u16(entry + 28);
+        const uint16_t extra_len = read_u16(entry + 30);
+        const uint16_t comment_len = read_u16(entry + 32);
+        uint64_t local = read_u32(entry + 42);
+        if (size - offset - 46 < uint64_t(name_len) + extra_len + comment_len)
+            return "malformed central directory";
+        std::string name(reinterpret_cast<const char *>(entry + 46), name_len);
+
+        // ZIP64 sizes/offset follow in this order, for the fields that overflowed
+        const uint8_t *extra = entry + 46 + name_len;
+        for (size_t x = 0; x + 4 <= extra_len;) {
+            const uint16_t id = read_u16(extra + x);
+            const uint16_t len = read_u16(extra + x + 2);
+            if (x + 4 + len > extra_len)
+                break;
+            if (id == ZIP64_EXTRA_ID) {
+                const uint8_t *field = extra + x + 4;
+                const uint8_t *field_end = field + len;
+                if (original_size == 0xFFFFFFFFu && field + 8 <= field_end) { original_size = read_u64(field); field += 8; }
+                if (stored_size == 0xFFFFFFFFu && field + 8 <= field_end) { stored_size = read_u64(field); field += 8; }
+                if (local == 0xFFFFFFFFu && field + 8 <= field_end) local = read_u64(field);
+            }
+            x += 4 + len;
+        }
+        offset += 46 + name_len + extra_len + comment_len;
+
+        if (name.empty() || name.back() == '/')
+            continue;
+        if (flags & 1u)
+            return "member '" + name + "' is encrypted";
+        if (method != 0)
+            return "member '" + name + "' is compressed; save with np.savez instead of np.savez_compressed";
+        // Offsets and sizes come from the file (ZIP64 ones are 64-bit), so
+        // every bound is checked by subtracting from size, never by adding
+        if (local > size || size - local < 30 || read_u32(bytes + local) != ZIP_LOCAL_HEADER)
+            return "member '" + name + "' has a malformed local header";
+
+        const uint64_t local_extra = uint64_t(read_u16(bytes + local + 26)) + read_u16(bytes + local + 28);
+        if (size - local - 30 < local_extra)
+            return "member '" + name + "' out of bounds";
+        const uint64_t data = local + 30 + local_extra;
+        if (stored_size > size - data)
+            return "member '" + name + "' out of bounds";
+
+        ArrayView view;
+        problem = parse_npy(bytes + data, size_t(stored_size), view);
+        if (!problem.empty())
+            return "member '" + name + "': " + problem;
+
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0)
+            name.resize(name.size() - 4);
+        out.emplace_back(std::move(name), std::move(view));
+    }
+    return "";
+}
+
+namespace {
+
+// Runs fn on a float pointer to the view's data, copying it to an aligned
+// buffer first when the view is not aligned
+template <typename Fn>
+void with_floats(const Npy::ArrayView &a, Fn fn) {
+    if (a.is_aligned()) {
+        fn(reinterpret_cast<const float *>(a.data));
+        return;
+    }
+    std::vector<float> tmp(a.count);
+    std::memcpy(tmp.data(), a.data, a.count * sizeof(float));
+    fn(tmp.data());
+}
+
+} // namespace
+
+void Npy::copy_col_major(const ArrayView &a, int rows, int cols, float *dst) {
+    if (a.fortran_order || rows == 1 || cols == 1) {
+        std::memcpy(dst, a.data, a.count * sizeof(float));
+        return;
+    }
+    with_floats(a, [&](const float *src) {
+        Eigen::Map<Eigen::MatrixXf>(dst, rows, cols) = Eigen::Map<const RowMat>(src, rows, cols);
+    });
+}
+
+void Npy::copy_row_major(const ArrayView &a, int rows, int cols, float *dst) {
+    if (!a.fortran_order || rows == 1 || cols == 1) {
+        std::memcpy(dst, a.data, a.count * sizeof(float));
+        return;
+    }
+    with_floats(a, [&](const float *src) {
+        Eigen::Map<RowMat>(dst, rows, cols) = Eigen::Map<const Eigen::MatrixXf>(src, rows, cols);
+    });
+}
@@ -0,0 +1,44 @@
+#ifndef NPY_H
+#define NPY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Readers for NumPy's .npy and uncompressed .npz (np.savez) files. Nothing is
+// copied: an ArrayView points at the array data inside the file, so a mapped
+// file can be handed straight to Eigen. Only little-endian float32 ('<f4')
+// arrays are accepted.
+namespace Npy {
+
+    struct ArrayView {
+        std::vector<int64_t> shape;
+        bool fortran_order = false;
+        const uint8_t *data = nullptr;
+        size_t count = 0;
+
+        int dims() const { return static_cast<int>(shape.size()); }
+        // Members of an .npz have no alignment guarantee
+        bool is_aligned() const { return reinterpret_cast<uintptr_t>(data) % alignof(float) == 0; }
+        // Matrix shape of a 0-D, 1-D (column) or 2-D array; false otherwise
+        bool matrix_shape(int &rows, int &cols) const;
+        std::string shape_string() const;
+    };
+
+    using Archive = std::vector<std::pair<std::string, ArrayView>>;
+
+    // Both return an empty string on success, otherwise why the data was
+    // rejected. The views stay valid while the underlying bytes do.
+    std::string parse_npy(const uint8_t *bytes, size_t size, ArrayView &out);
+    // Member names are returned without the ".npy" suffix, in archive order
+    std::string parse_npz(const uint8_t *bytes, size_t size, Archive &out);
+
+    // Copies a view into column-major or row-major storage (dst holds count floats)
+    void copy_col_major(const ArrayView &a, int rows, int cols, float *dst);
+    void copy_row_major(const ArrayView &a, int rows, int cols, float *dst);
+
+} // namespace Npy
+
+#endif // NPY_H
@@ -0,0 +1,113 @@
+#include "profiler.h"
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/variant/callable_method_pointer.hpp>
+
+namespace {
+
+// Indexed by Profiler::Section; also the get_profile() keys
+const char *const SECTION_NAMES[Profiler::SECTION_COUNT] = {
+    "nn_forward", "nn_backward", "nn_update", "nn_predict",
+    "tree_fit", "tree_predict", "marshal_to_eigen", "marshal_to_godot",
+};
+
+godot::String monitor_id(int index) {
+    if (index == Profiler::SECTION_COUNT)
+        return "MLGodotKit/allocations";
+    return godot::String("MLGodotKit/") + SECTION_NAMES[index] + "_ms";
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled{false};
+Profiler::Counter Profiler::sections[Profiler::SECTION_COUNT];
+Profiler::Counter Profiler::allocations;
+uint64_t Profiler::last_sample[Profiler::SECTION_COUNT + 1] = {};
+
+void Profiler::_bind_methods() {
+    using namespace godot;
+    ClassDB::bind_static_method("Profiler", D_METHOD("set_enabled", "enabled"), &Profiler::set_enabled);
+    ClassDB::bind_static_method("Profiler", D_METHOD("is_enabled"), &Profiler::is_enabled);
+    ClassDB::bind_static_method("Profiler", D_METHOD("get_profile"), &Profiler::get_profile);
+    ClassDB::bind_static_method("Profiler", D_METHOD("reset"), &Profiler::reset);
+}
+
+Profiler::Counter &Profiler::Counter::operator=(const Counter &other) {
+    calls.store(other.calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    nanoseconds.store(other.nanoseconds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    flops.store(other.flops.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+void Profiler::Counter::reset() {
+    calls.store(0, std::memory_order_relaxed);
+    nanoseconds.store(0, std::memory_order_relaxed);
+    flops.store(0, std::memory_order_relaxed);
+    bytes.store(0, std::memory_order_relaxed);
+}
+
+godot::Dictionary Profiler::Counter::to_dictionary() const {
+    godot::Dictionary d;
+    d["calls"] = static_cast<int64_t>(calls.load(std::memory_order_relaxed));
+    d["time_ms"] = static_cast<double>(nanoseconds.load(std::memory_order_relaxed)) * 1e-6;
+    d["flops"] = static_cast<int64_t>(flops.load(std::memory_order_relaxed));
+    d["bytes"] = static_cast<int64_t>(bytes.load(std::memory_order_relaxed));
+    return d;
+}
+
+godot::Dictionary Profiler::get_profile() {
+    godot::Dictionary out;
+    for (int i = 0; i < SECTION_COUNT; ++i)
+        out[SECTION_NAMES[i]] = sections[i].to_dictionary();
+
+    godot::Dictionary alloc;
+    alloc["count"] = static_cast<int64_t>(allocations.calls.load(std::memory_order_relaxed));
+    alloc["bytes"] = static_cast<int64_t>(allocations.bytes.load(std::memory_order_relaxed));
+    out["allocations"] = alloc;
+    return out;
+}
+
+void Profiler::reset() {
+    for (Counter &c : sections)
+        c.reset();
+    allocations.reset();
+    for (uint64_t &v : last_sample)
+        v = 0;
+}
+
+godot::Variant Profiler::sample_monitor(int index) {
+    // Time (ms) or allocations since the previous sample, so the debugger
+    // graph shows the load per sampling interval rather than a running total
+    const uint64_t now = index == SECTION_COUNT ? allocations.calls.load(std::memory_order_relaxed)
+                                                : sections[index].nanoseconds.load(std::memory_order_relaxed);
+    const uint64_t delta = now >= last_sample[index] ? now - last_sample[index] : now;
+    last_sample[index] = now;
+    if (index == SECTION_COUNT)
+        return static_cast<int64_t>(delta);
+    return static_cast<double>(delta) * 1e-6;
+}
+
+void Profiler::register_monitors() {
+    godot::Performance *performance = godot::Performance::get_singleton();
+    if (!performance)
+        return;
+    for (int i = 0; i <= SECTION_COUNT; ++i) {
+        const godot::String id = monitor_id(i);
+        if (performance->has_custom_monitor(id))
+            continue;
+        godot::Array args;
+        args.push_back(i);
+        performance->add_custom_monitor(id, callable_mp_static(&Profiler::sample_monitor), args);
+    }
+}
+
+void Profiler::unregister_monitors() {
+    godot::Performance *performance = godot::Performance::get_singleton();
+    if (!performance)
+        return;
+    for (int i = 0; i <= SECTION_COUNT; ++i) {
+        const godot::String id = monitor_id(i);
+        if (performance->has_custom_monitor(id))
+            performance->remove_custom_monitor(id);
+    }
+}
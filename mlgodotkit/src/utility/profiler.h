@@ -0,0 +1,117 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Built-in instrumentation. Off by default: every probe is a relaxed atomic
+// load and a branch until Profiler.enabled is set, and only then reads the
+// clock. Totals are process-wide and exposed both through get_profile() and
+// as custom monitors ("MLGodotKit/...") in Godot's Performance singleton.
+class Profiler : public godot::Object {
+    GDCLASS(Profiler, godot::Object);
+
+public:
+    enum Section {
+        NN_FORWARD,         // NeuralNetworkNode training forward pass
+        NN_BACKWARD,        // backpropagation, without the update
+        NN_UPDATE,          // gradient clipping and weight update
+        NN_PREDICT,         // inference through predict()/predict_matrix()
+        TREE_FIT,
+        TREE_PREDICT,
+        MARSHAL_TO_EIGEN,   // Utils::godot_to_eigen*
+        MARSHAL_TO_GODOT,   // Utils::eigen_to_godot
+        SECTION_COUNT,
+    };
+
+    // Lock-free totals; copies take a snapshot so counters can live in vectors
+    struct Counter {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> nanoseconds{0};
+        std::atomic<uint64_t> flops{0};
+        std::atomic<uint64_t> bytes{0};
+
+        Counter() = default;
+        Counter(const Counter &other) { *this = other; }
+        Counter &operator=(const Counter &other);
+
+        void add(uint64_t ns, uint64_t p_flops, uint64_t p_bytes) {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            nanoseconds.fetch_add(ns, std::memory_order_relaxed);
+            flops.fetch_add(p_flops, std::memory_order_relaxed);
+            bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+        }
+        void reset();
+        // { calls, time_ms, flops, bytes }
+        godot::Dictionary to_dictionary() const;
+    };
+
+    // Times its lifetime into a counter; flops and bytes are the caller's
+    // estimate of the work done
+    class Scope {
+    public:
+        explicit Scope(Counter &counter, uint64_t p_flops = 0, uint64_t p_bytes = 0)
+            : Scope(is_enabled() ? &counter : nullptr, p_flops, p_bytes) {}
+        // A null counter records nothing
+        Scope(Counter *counter, uint64_t p_flops, uint64_t p_bytes)
+            : target(counter), flops(p_flops), bytes(p_bytes), start(target ? now_ns() : 0) {}
+        ~Scope() {
+            if (target)
+                target->add(now_ns() - start, flops, bytes);
+        }
+        // For work only known once the scope has run
+        void add_work(uint64_t p_flops, uint64_t p_bytes) {
+            flops += p_flops;
+            bytes += p_bytes;
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        Counter *target;
+        uint64_t flops;
+        uint64_t bytes;
+        uint64_t start;
+    };
+
+private:
+    static std::atomic<bool> enabled;
+    static Counter sections[SECTION_COUNT];
+    static Counter allocations;
+    // Monitor values are deltas since the previous sample (main thread only)
+    static uint64_t last_sample[SECTION_COUNT + 1];
+
+    static godot::Variant sample_monitor(int index);
+
+protected:
+    static void _bind_methods();
+
+public:
+    static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool p_enabled) { enabled.store(p_enabled, std::memory_order_relaxed); }
+
+    static Counter &section(Section s) { return sections[s]; }
+    // Counts a heap buffer created on an instrumented path
+    static void count_allocation(uint64_t p_bytes) {
+        if (is_enabled())
+            allocations.add(0, 0, p_bytes);
+    }
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // { section_name: Counter dictionary, ..., "allocations": { count, bytes } }
+    static godot::Dictionary get_profile();
+    static void reset();
+
+    // Called from module (un)initialization
+    static void register_monitors();
+    static void unregister_monitors();
+};
+
+#endif // PROFILER_H
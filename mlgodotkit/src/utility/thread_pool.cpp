@@ -0,0 +1,194 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Web exports without pthread support run everything on the calling thread
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define MLGODOTKIT_NO_THREADS
+#endif
+
+namespace {
+
+	thread_local bool inside_parallel = false;
+
+	// One parallel_for invocation. Lives on the caller's stack; the caller does
+	// not return until every worker that picked it up has let go of it.
+	struct Job {
+		const std::function<void(int, int, int)> *fn = nullptr;
+		int count = 0;
+		int chunks = 0;
+		std::atomic<int> next_chunk{0};
+		int pending = 0;   // chunks not finished yet
+		int attached = 0;  // workers currently holding this job
+	};
+
+	// Persistent workers that sleep on a condition variable between jobs.
+	// Only one parallel_for uses them at a time; the caller works on chunks
+	// too, and concurrent callers run their chunks on their own thread.
+	struct Pool {
+		std::mutex job_mutex;     // held by the caller that owns the workers
+		std::mutex state_mutex;   // guards everything below
+		std::condition_variable wake;
+		std::condition_variable done;
+
+		std::vector<std::thread> workers;
+		Job *current = nullptr;
+		unsigned generation = 0;
+		bool stopping = false;
+
+		// Read by chunk_count() on any thread, outside job_mutex
+		std::atomic<int> requested_threads{0};
+
+		~Pool() { stop(); }
+
+		void stop() {
+			{
+				std::lock_guard<std::mutex> lock(state_mutex);
+				stopping = true;
+			}
+			wake.notify_all();
+			for (auto &t : workers)
+				if (t.joinable())
+					t.join();
+			workers.clear();
+			stopping = false;
+		}
+
+		void run_chunks(Job &job) {
+			int c;
+			while ((c = job.next_chunk.fetch_add(1)) < job.chunks) {
+				int begin, end;
+				ThreadPool::chunk_range(job.count, job.chunks, c, begin, end);
+				(*job.fn)(c, begin, end);
+				std::lock_guard<std::mutex> lock(state_mutex);
+				if (--job.pending == 0)
+					done.notify_all();
+			}
+		}
+
+		void worker_loop() {
+			inside_parallel = true;
+			unsigned seen = 0;
+			for (;;) {
+				Job *job;
+				{
+					std::unique_lock<std::mutex> lock(state_mutex);
+					wake.wait(lock, [&] { return stopping || generation != seen; });
+					if (stopping)
+						return;
+					seen = generation;
+					job = current;
+					if (!job)
+						continue;
+					++job->attached;
+				}
+				run_chunks(*job);
+				{
+					std::lock_guard<std::mutex> lock(state_mutex);
+					if (--job->attached == 0)
+						done.notify_all();
+				}
+			}
+		}
+
+		void ensure_workers(int threads) {
+			const int wanted = std::max(0, threads - 1);
+			if ((int)workers.size() == wanted)
+				return;
+			stop();
+			for (int i = 0; i < wanted; ++i)
+				workers.emplace_back([this] { worker_loop(); });
+		}
+	};
+
+	Pool &pool() {
+		static Pool p;
+		return p;
+	}
+
+} // namespace
+
+namespace ThreadPool {
+
+	void set_thread_count(int count) {
+		pool().requested_threads.store(std::max(0, count), std::memory_order_relaxed);
+	}
+
+	int get_thread_count() {
+#ifdef MLGODOTKIT_NO_THREADS
+		return 1;
+#else
+		const int requested = pool().requested_threads.load(std::memory_order_relaxed);
+		if (requested > 0)
+			return requested;
+		return std::max(1u, std::thread::hardware_concurrency());
+#endif
+	}
+
+	int chunk_count(int count, int min_chunk) {
+		if (count <= 0)
+			return 0;
+		const int by_size = std::max(1, count / std::max(1, min_chunk));
+		return std::max(1, std::min(get_thread_count(), by_size));
+	}
+
+	void chunk_range(int count, int chunks, int index, int &begin, int &end) {
+		const int base = count / chunks;
+		const int extra = count % chunks;
+		begin = index * base + std::min(index, extra);
+		end = begin + base + (index < extra ? 1 : 0);
+	}
+
+	void parallel_for(int count, int min_chunk, const std::function<void(int, int)> &fn) {
+		parallel_for_chunks(count, chunk_count(count, min_chunk), [&fn](int, int begin, int end) { fn(begin, end); });
+	}
+
+	void parallel_for_chunks(int count, int chunks, const std::function<void(int, int, int)> &fn) {
+		chunks = std::min(chunks, count);
+		if (chunks <= 0)
+			return;
+
+		Pool &p = pool();
+		std::unique_lock<std::mutex> job_lock(p.job_mutex, std::defer_lock);
+
+		// Run serially when there is nothing to split, when nested, or when
+		// another caller already owns the workers. Waiting for them would
+		// serialize concurrent callers (e.g. predicts from several threads).
+		if (chunks == 1 || inside_parallel || !job_lock.try_lock()) {
+			// Keep the same chunk boundaries so per-chunk reductions match
+			for (int c = 0; c < chunks; ++c) {
+				int begin, end;
+				chunk_range(count, chunks, c, begin, end);
+				fn(c, begin, end);
+			}
+			return;
+		}
+
+		p.ensure_workers(get_thread_count());
+
+		Job job;
+		job.fn = &fn;
+		job.count = count;
+		job.chunks = chunks;
+		job.pending = chunks;
+		{
+			std::lock_guard<std::mutex> lock(p.state_mutex);
+			p.current = &job;
+			++p.generation;
+		}
+		p.wake.notify_all();
+
+		inside_parallel = true;
+		p.run_chunks(job);
+		inside_parallel = false;
+
+		std::unique_lock<std::mutex> lock(p.state_mutex);
+		p.done.wait(lock, [&] { return job.pending == 0 && job.attached == 0; });
+		p.current = nullptr;
+	}
+
+} // namespace ThreadPool
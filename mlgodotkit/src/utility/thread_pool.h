@@ -0,0 +1,37 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+
+namespace ThreadPool {
+
+	// Number of threads used by parallel_for, including the calling thread.
+	// 0 means "use all hardware threads".
+	void set_thread_count(int count);
+	int get_thread_count();
+
+	// Split [0, count) into contiguous chunks and run fn(begin, end) on each,
+	// blocking until every chunk is done. Chunk boundaries depend only on
+	// count, min_chunk and the thread count, so results that are reduced per
+	// chunk are reproducible for a fixed thread count.
+	// Nested calls (from inside fn), and calls made while another thread is
+	// already using the workers, run serially on the calling thread instead
+	// of waiting for them.
+	void parallel_for(int count, int min_chunk, const std::function<void(int, int)> &fn);
+
+	// Same as parallel_for, but runs exactly `chunks` chunks (at most count)
+	// and passes the chunk index, so callers can keep one accumulator per
+	// chunk and reduce them in a fixed order afterwards. Take `chunks` from
+	// chunk_count() and size the accumulators from the same value; asking
+	// again could give a different answer after set_thread_count().
+	void parallel_for_chunks(int count, int chunks, const std::function<void(int, int, int)> &fn);
+
+	// Number of chunks parallel_for would use for the same arguments.
+	int chunk_count(int count, int min_chunk);
+
+	// Bounds of chunk `index` out of `chunks` over [0, count).
+	void chunk_range(int count, int chunks, int index, int &begin, int &end);
+
+} // namespace ThreadPool
+
+#endif // THREAD_POOL_H
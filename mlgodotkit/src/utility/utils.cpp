@@ -1,7 +1,19 @@
 #include "utils.h"
 #include "utility/logger.h"
+#include "utility/profiler.h"
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 
-Eigen::MatrixXf Utils::godot_to_eigen(godot::Array array) {
+namespace {
+
+// Counts the buffer a conversion produced; the scope times it
+void note_marshalled(Profiler::Scope &scope, int64_t values) {
+    const uint64_t bytes = static_cast<uint64_t>(values) * sizeof(float);
+    scope.add_work(0, bytes);
+    Profiler::count_allocation(bytes);
+}
+
+Eigen::MatrixXf array_to_eigen(const godot::Array &array) {
     int rows = array.size();
     int cols = 0;
 
@@ -34,7 +46,7 @@ Eigen::MatrixXf Utils::godot_to_eigen(godot::Array array) {
     return out;
 }
 
-Eigen::MatrixXf Utils::godot_to_eigen(const godot::Array &arr, int batch_size) {
+Eigen::MatrixXf batch_to_eigen(const godot::Array &arr, int batch_size) {
     if (arr.is_empty())
         return Eigen::MatrixXf();
 
@@ -78,7 +90,24 @@ Eigen::MatrixXf Utils::godot_to_eigen(const godot::Array &arr, int batch_size) {
     return m;
 }
 
+} // namespace
+
+Eigen::MatrixXf Utils::godot_to_eigen(godot::Array array) {
+    Profiler::Scope scope(Profiler::section(Profiler::MARSHAL_TO_EIGEN));
+    Eigen::MatrixXf out = array_to_eigen(array);
+    note_marshalled(scope, out.size());
+    return out;
+}
+
+Eigen::MatrixXf Utils::godot_to_eigen(const godot::Array &arr, int batch_size) {
+    Profiler::Scope scope(Profiler::section(Profiler::MARSHAL_TO_EIGEN));
+    Eigen::MatrixXf out = batch_to_eigen(arr, batch_size);
+    note_marshalled(scope, out.size());
+    return out;
+}
+
 Eigen::VectorXf Utils::godot_to_eigen_vector(godot::Array array) {
+    Profiler::Scope scope(Profiler::section(Profiler::MARSHAL_TO_EIGEN));
     int size = array.size();
     Eigen::VectorXf vec(size);
 
@@ -86,10 +115,12 @@ Eigen::VectorXf Utils::godot_to_eigen_vector(godot::Array array) {
         vec(i) = static_cast<float>(array[i]);
     }
 
+    note_marshalled(scope, size);
     return vec;
 }
 
 godot::Array Utils::eigen_to_godot(Eigen::MatrixXf matrix) {
+    Profiler::Scope scope(Profiler::section(Profiler::MARSHAL_TO_GODOT));
     godot::Array out;
     for (int i = 0; i < matrix.rows(); i++) {
         godot::Array row;
@@ -97,6 +128,7 @@ godot::Array Utils::eigen_to_godot(Eigen::MatrixXf matrix) {
             row.push_back(matrix(i, j));
         out.push_back(row);
     }
+    note_marshalled(scope, matrix.size());
     return out;
 }
 
@@ -131,4 +163,14 @@ Eigen::MatrixXf Utils::round_matrix(const Eigen::MatrixXf& mat, int precision) {
     return rounded;
 }
 
-
+std::shared_ptr<const MappedFile> Utils::map_file(const godot::String &path) {
+    const godot::String global = godot::ProjectSettings::get_singleton()->globalize_path(path);
+    std::shared_ptr<const MappedFile> file = MappedFile::map(global.utf8().get_data());
+    if (file)
+        return file;
+    // Exported packs have no file to map; read the bytes instead
+    if (!godot::FileAccess::file_exists(path))
+        return nullptr;
+    const godot::PackedByteArray bytes = godot::FileAccess::get_file_as_bytes(path);
+    return MappedFile::from_bytes(std::vector<uint8_t>(bytes.ptr(), bytes.ptr() + bytes.size()));
+}
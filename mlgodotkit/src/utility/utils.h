@@ -4,6 +4,8 @@
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <Eigen/Dense>
 #include <sstream>
+#include <memory>
+#include "utility/mapped_file.h"
 
 namespace Utils {
 
@@ -19,6 +21,10 @@ namespace Utils {
     void debug_print(int verbosity, int debug_level, godot::Variant msg);
     std::string eigen_to_string(const Eigen::MatrixXf& matrix);
     Eigen::MatrixXf round_matrix(const Eigen::MatrixXf& mat, int precision);
+
+    // Maps a res:// / user:// / absolute path; files that cannot be mapped
+    // (e.g. inside an exported pack) are read into memory. nullptr if missing.
+    std::shared_ptr<const MappedFile> map_file(const godot::String &path);
 };
 
 #endif //UTILS_H
@@ -0,0 +1,104 @@
+extends GutTest
+
+const BIN_PATH = "user://test_dataset.bin"
+const CSV_PATH = "user://test_dataset.csv"
+const ROWS = 100
+
+func before_each():
+	# Rows [i, -i, 2i]: two features and one target
+	var data := PackedFloat32Array()
+	var csv := FileAccess.open(CSV_PATH, FileAccess.WRITE)
+	csv.store_line("a,b,y")
+	for i in ROWS:
+		data.append_array([i, -i, 2 * i])
+		csv.store_line("%d,%d,%d" % [i, -i, 2 * i])
+	csv.close()
+	var f := FileAccess.open(BIN_PATH, FileAccess.WRITE)
+	f.store_buffer(data.to_byte_array())
+	f.close()
+
+func after_each():
+	for path in [BIN_PATH, CSV_PATH]:
+		if FileAccess.file_exists(path):
+			DirAccess.remove_absolute(path)
+
+func _read_epoch(data: Dataset) -> Array:
+	var batches := []
+	var batch := data.next_batch()
+	while not batch.is_empty():
+		batches.append(batch)
+		batch = data.next_batch()
+	return batches
+
+func _first_column(batches: Array) -> Array:
+	var values := []
+	for batch in batches:
+		var x: Matrix = batch.inputs
+		var y: Matrix = batch.targets
+		for r in x.rows():
+			assert_eq(y.get(r, 0), 2.0 * x.get(r, 0))
+			values.append(x.get(r, 0))
+	return values
+
+func test_binary_batches_in_file_order():
+	var data := Dataset.new()
+	assert_eq(data.open_binary(BIN_PATH, 2, 1), OK)
+	data.batch_size = 32
+	data.shuffle_buffer = 0
+
+	var batches := _read_epoch(data)
+	assert_eq(batches.size(), 4)
+	assert_eq(batches[0].inputs.rows(), 32)
+	assert_eq(batches[0].inputs.cols(), 2)
+	assert_eq(batches[3].inputs.rows(), 4)
+	assert_eq(_first_column(batches), range(ROWS).map(func(i): return float(i)))
+	assert_eq(data.get_rows_read(), ROWS)
+
+func test_csv_shuffled_epochs_cover_every_row():
+	var data := Dataset.new()
+	assert_eq(data.open_csv(CSV_PATH, 1), OK)
+	assert_eq(data.get_feature_count(), 2)
+	data.batch_size = 16
+	data.shuffle_buffer = 50
+
+	var first := _first_column(_read_epoch(data))
+	var second := _first_column(_read_epoch(data))
+	assert_eq(data.get_epoch(), 2)
+	assert_ne(first, second)
+	first.sort()
+	assert_eq(first, range(ROWS).map(func(i): return float(i)))
+
+func test_drop_last():
+	var data := Dataset.new()
+	data.open_binary(BIN_PATH, 2, 1)
+	data.batch_size = 32
+	data.drop_last = true
+	assert_eq(_read_epoch(data).size(), 3)
+
+func test_rejects_truncated_binary_file():
+	var data := Dataset.new()
+	assert_eq(data.open_binary(BIN_PATH, 4, 3), ERR_FILE_CORRUPT)
+
+func test_batches_train_models():
+	var data := Dataset.new()
+	data.open_binary(BIN_PATH, 2, 1)
+	data.batch_size = 25
+
+	var nn := NeuralNetworkNode.new()
+	nn.add_layer(2, 1, "linear")
+	nn.set_learning_rate(0.0001)
+	var lm := LinearModelNode.new()
+	var batch := data.next_batch()
+	while not batch.is_empty():
+		assert_true(is_finite(nn.train_step_matrix(batch.inputs, batch.targets, MSELossNode.new())))
+		lm.partial_fit_matrix(batch.inputs, batch.targets)
+		batch = data.next_batch()
+	assert_eq(nn.get_training_steps(), 4)
+
+	var tree := DecisionTreeNode.new()
+	var labels := Matrix.from_array([[0], [1], [1], [0]])
+	tree.fit_matrix(Matrix.from_array([[0, 0], [0, 1], [1, 0], [1, 1]]), labels)
+	assert_eq(tree.predict([[0, 1]]).size(), 1)
+	nn.free()
+	lm.free()
+	tree.free()
@@ -0,0 +1,124 @@
+extends GutTest
+
+const LOG_PATH = "user://test_experience.mlgklog"
+
+func after_each():
+	if FileAccess.file_exists(LOG_PATH):
+		DirAccess.remove_absolute(LOG_PATH)
+
+func _record_rows(recorder: ExperienceRecorder, count: int) -> void:
+	for i in count:
+		assert_true(recorder.record(PackedFloat32Array([i, -i, 0.5 * i])))
+
+func test_round_trip_into_matrix():
+	for mode in [ExperienceRecorder.COMPRESSION_NONE, ExperienceRecorder.COMPRESSION_FASTLZ,
+			ExperienceRecorder.COMPRESSION_ZSTD]:
+		var recorder := ExperienceRecorder.new()
+		recorder.compression = mode
+		recorder.chunk_records = 16
+		assert_eq(recorder.open(LOG_PATH, 3, "obs,neg_obs,reward"), OK)
+		_record_rows(recorder, 100)
+		recorder.close()
+		assert_eq(recorder.get_written_count(), 100)
+
+		var info := ExperienceRecorder.read_log_info(LOG_PATH)
+		assert_eq(info.record_size, 3)
+		assert_eq(info.record_count, 100)
+		assert_eq(info.layout, "obs,neg_obs,reward")
+		assert_eq(info.compression, mode)
+
+		var m := ExperienceRecorder.load_log(LOG_PATH)
+		assert_eq(m.rows(), 100)
+		assert_eq(m.cols(), 3)
+		assert_eq(m.get(42, 0), 42.0)
+		assert_eq(m.get(42, 1), -42.0)
+		assert_eq(m.get(99, 2), 49.5)
+
+func test_flush_makes_records_readable():
+	var recorder := ExperienceRecorder.new()
+	recorder.flush_interval = 60.0
+	recorder.open(LOG_PATH, 3)
+	_record_rows(recorder, 10)
+	recorder.flush()
+	assert_eq(recorder.get_written_count(), 10)
+	# Not closed yet: the header has no count, but the chunks are readable
+	assert_eq(ExperienceRecorder.load_log(LOG_PATH).rows(), 10)
+	recorder.close()
+
+func test_full_ring_drops_records():
+	var recorder := ExperienceRecorder.new()
+	recorder.capacity = 4
+	recorder.flush_interval = 60.0
+	recorder.chunk_records = 1000
+	recorder.open(LOG_PATH, 3)
+	var accepted := 0
+	for i in 10:
+		if recorder.record(PackedFloat32Array([i, i, i])):
+			accepted += 1
+	assert_eq(accepted, 4)
+	assert_eq(recorder.get_dropped_count(), 6)
+	recorder.close()
+	assert_eq(ExperienceRecorder.load_log(LOG_PATH).rows(), 4)
+
+func test_rejects_wrong_record_size():
+	var recorder := ExperienceRecorder.new()
+	assert_eq(recorder.open(LOG_PATH, 0), ERR_INVALID_PARAMETER)
+	recorder.open(LOG_PATH, 3)
+	assert_false(recorder.record(PackedFloat32Array([1.0, 2.0])))
+	recorder.close()
+	assert_false(recorder.is_open())
+
+func _patch_header(offset: int, bytes: PackedByteArray) -> void:
+	var f := FileAccess.open(LOG_PATH, FileAccess.READ_WRITE)
+	f.seek(offset)
+	f.store_buffer(bytes)
+	f.close()
+
+func test_load_ignores_hostile_record_count():
+	var recorder := ExperienceRecorder.new()
+	recorder.open(LOG_PATH, 3)
+	_record_rows(recorder, 10)
+	recorder.close()
+
+	# record_count (offset 32) claims far more records than the file holds
+	var count := PackedByteArray()
+	count.resize(8)
+	count.encode_s64(0, 1 << 60)
+	_patch_header(32, count)
+	assert_eq(ExperienceRecorder.load_log(LOG_PATH).rows(), 10)
+
+func test_load_rejects_oversized_record_size():
+	var recorder := ExperienceRecorder.new()
+	recorder.open(LOG_PATH, 3)
+	_record_rows(recorder, 10)
+	recorder.close()
+
+	# record_size (offset 16) larger than a chunk can hold
+	var size := PackedByteArray()
+	size.resize(4)
+	size.encode_u32(0, 0xFFFFFFFF)
+	_patch_header(16, size)
+	assert_null(ExperienceRecorder.load_log(LOG_PATH))
+	assert_ne(Dataset.new().open_log(LOG_PATH), OK)
+
+func test_dataset_streams_log():
+	var recorder := ExperienceRecorder.new()
+	recorder.chunk_records = 8
+	recorder.open(LOG_PATH, 3)
+	_record_rows(recorder, 50)
+	recorder.close()
+
+	var data := Dataset.new()
+	assert_eq(data.open_log(LOG_PATH, 1), OK)
+	assert_eq(data.get_feature_count(), 2)
+	data.batch_size = 20
+	var rows := 0
+	var batch := data.next_batch()
+	while not batch.is_empty():
+		var x: Matrix = batch.inputs
+		var y: Matrix = batch.targets
+		for r in x.rows():
+			assert_eq(y.get(r, 0), 0.5 * x.get(r, 0))
+		rows += x.rows()
+		batch = data.next_batch()
+	assert_eq(rows, 50)
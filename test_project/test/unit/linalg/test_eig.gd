@@ -11,3 +11,8 @@ func test_eig_symmetric_matrix():
 	var values = eig["values"]
 	assert_eq(values.get(0, 0), 2.0)
 	assert_eq(values.get(1, 0), 3.0)
+
+func test_eig_values_only():
+	var eig = Linalg.eig(U.mat([[2, 0], [0, 3]]), false)
+	assert_true(eig.has("values"))
+	assert_false(eig.has("vectors"))
@@ -0,0 +1,38 @@
+extends GutTest
+const U = preload("res://test/unit/linalg/linalg_test_utils.gd")
+
+func test_lu_factorization_reuse():
+	var A = U.mat([[4, 3], [6, 3]])
+	var lu = LUFactorization.create(A)
+	assert_true(lu.is_valid())
+
+	for rhs in [[[1], [0]], [[0], [1]], [[2], [5]]]:
+		var b = U.mat(rhs)
+		assert_true(U.approx_eq(lu.solve(b), Linalg.solve(A, b)))
+
+func test_cholesky_spd_fast_path():
+	var A = U.mat([[4, 1], [1, 3]])
+	var chol = CholeskyFactorization.create(A)
+	assert_false(chol.is_ldlt())
+	var b = U.mat([[1], [2]])
+	assert_true(U.approx_eq(A.matmul(chol.solve(b)), b))
+
+func test_cholesky_falls_back_to_ldlt():
+	var A = U.mat([[1, 0], [0, -2]])
+	var chol = CholeskyFactorization.create(A)
+	assert_true(chol.is_ldlt())
+	var b = U.mat([[1], [4]])
+	assert_true(U.approx_eq(chol.solve(b), U.mat([[1], [-2]])))
+
+func test_qr_solve_into_least_squares():
+	var A = U.mat([[1, 0], [0, 1], [1, 1]])
+	var b = U.mat([[1], [2], [3]])
+	var qr = QRFactorization.create(A)
+	var out = Matrix.zeros(2, 1)
+	assert_true(qr.solve_into(b, out))
+	assert_true(U.approx_eq(out, Linalg.least_squares(A, b)))
+
+func test_invalidate():
+	var lu = LUFactorization.create(U.mat([[1, 0], [0, 1]]))
+	lu.invalidate()
+	assert_false(lu.is_valid())
@@ -11,3 +11,10 @@ func test_lu_reconstruction():
 
 	var reconstructed = P.matmul(L.matmul(Umat))
 	assert_true(U.approx_eq(reconstructed, A))
+
+func test_lu_reconstruction_3x3():
+	var A = U.mat([[1, 2, 3], [4, 5, 6], [7, 8, 10]])
+
+	var lu = Linalg.lu(A)
+	var reconstructed = lu["P"].matmul(lu["L"].matmul(lu["U"]))
+	assert_true(U.approx_eq(reconstructed, A))
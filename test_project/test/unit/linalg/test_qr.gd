@@ -13,3 +13,19 @@ func test_qr_reconstruction():
 
 	var reconstructed = Q.matmul(R)
 	assert_true(U.approx_eq(reconstructed, A))
+
+func test_qr_thin_rectangular():
+	var A = U.mat([[1, 2], [3, 4], [5, 6]])
+
+	var qr = Linalg.qr(A)
+	var Q = qr["Q"]
+	var R = qr["R"]
+	assert_eq(Q.rows(), 3)
+	assert_eq(Q.cols(), 2)
+	assert_eq(R.rows(), 2)
+	assert_true(U.approx_eq(Q.matmul(R), A))
+
+func test_qr_r_only():
+	var qr = Linalg.qr(U.mat([[1, 2], [3, 4]]), false)
+	assert_false(qr.has("Q"))
+	assert_true(qr.has("R"))
@@ -0,0 +1,34 @@
+extends GutTest
+
+func test_solve_batched_3x3():
+	# Two diagonal systems packed back to back
+	var A := PackedFloat32Array([
+		2, 0, 0,  0, 3, 0,  0, 0, 4,
+		1, 0, 0,  0, 1, 0,  0, 0, 2,
+	])
+	var b := PackedFloat32Array([2, 3, 4,  1, 1, 1])
+	var x = Linalg.solve_batched(A, b, 3)
+
+	var expected := [1.0, 1.0, 1.0, 1.0, 1.0, 0.5]
+	assert_eq(x.size(), expected.size())
+	for i in expected.size():
+		assert_almost_eq(x[i], expected[i], 1e-5)
+
+func test_solve_batched_matches_solve_for_large_n():
+	var n := 10
+	var A := PackedFloat32Array()
+	var b := PackedFloat32Array()
+	var rows := []
+	for i in n:
+		var row := []
+		for j in n:
+			var v := 10.0 if i == j else 1.0 / (1 + i + j)
+			row.append(v)
+			A.append(v)
+		rows.append(row)
+		b.append(i)
+
+	var x = Linalg.solve_batched(A, b, n)
+	var ref = Linalg.solve(Matrix.from_array(rows), Matrix.from_array(Array(b).map(func(v): return [v])))
+	for i in n:
+		assert_almost_eq(x[i], ref.get(i, 0), 1e-4)
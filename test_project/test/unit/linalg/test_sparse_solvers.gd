@@ -0,0 +1,31 @@
+extends GutTest
+const U = preload("res://test/unit/linalg/linalg_test_utils.gd")
+
+func _laplacian(n: int) -> SparseMatrix:
+	var r := PackedInt32Array()
+	var c := PackedInt32Array()
+	var v := PackedFloat32Array()
+	for i in n:
+		r.append(i); c.append(i); v.append(4.0)
+		if i > 0:
+			r.append(i); c.append(i - 1); v.append(-1.0)
+			r.append(i - 1); c.append(i); v.append(-1.0)
+	return SparseMatrix.from_triplets(n, n, r, c, v)
+
+func test_sparse_ldlt():
+	var A = _laplacian(50)
+	var b = Matrix.ones(50, 1)
+	var x = Linalg.solve_sparse_ldlt(A, b)
+	assert_true(U.approx_eq(A.matmul(x), b))
+
+func test_cg():
+	var A = _laplacian(50)
+	var b = Matrix.ones(50, 1)
+	var x = Linalg.solve_cg(A, b, 1e-6)
+	assert_true(U.approx_eq(A.matmul(x), b, 1e-3))
+
+func test_bicgstab():
+	var A = _laplacian(50)
+	var b = Matrix.ones(50, 1)
+	var x = Linalg.solve_bicgstab(A, b, 1e-6)
+	assert_true(U.approx_eq(A.matmul(x), b, 1e-3))
@@ -11,3 +11,16 @@ func test_svd_reconstruction():
 
 	var reconstructed = Umat.matmul(S).matmul(V.transpose())
 	assert_true(U.approx_eq(reconstructed, A))
+
+func test_svd_singular_values_only():
+	var A = U.mat([[3, 0], [0, 1], [0, 0]])
+
+	var svd = Linalg.svd(A, false)
+	assert_false(svd.has("U"))
+	assert_false(svd.has("V"))
+
+	var s = svd["singular_values"]
+	assert_eq(s.rows(), 2)
+	assert_eq(s.cols(), 1)
+	assert_almost_eq(s.get(0, 0), 3.0, 1e-5)
+	assert_almost_eq(s.get(1, 0), 1.0, 1e-5)
@@ -0,0 +1,68 @@
+extends GutTest
+
+func test_huber_quadratic_and_linear_regions():
+	var loss := HuberLossNode.new()
+	loss.delta = 1.0
+
+	var pred = Matrix.from_array([[0.5, 3.0]])
+	var tgt = Matrix.zeros(1, 2)
+	var grad = Matrix.new()
+
+	# 0.5 * 0.5^2 = 0.125 and 1 * (3 - 0.5) = 2.5, averaged over 2 elements
+	var value = loss.compute(pred, tgt, grad)
+	assert_almost_eq(value, 1.3125, 1e-5)
+	assert_almost_eq(grad.get(0, 0), 0.25, 1e-6)
+	assert_almost_eq(grad.get(0, 1), 0.5, 1e-6)
+
+	loss.smooth_l1 = true
+	loss.delta = 2.0
+	# r = 0.5 -> 0.125 / 2, r = 3 -> 2 * (3 - 1) / 2, averaged over 2 elements
+	assert_almost_eq(loss.compute(pred, tgt), 1.03125, 1e-5)
+
+func test_bce_with_logits_is_stable_for_large_logits():
+	var loss := BCEWithLogitsLossNode.new()
+	var pred = Matrix.from_array([[100.0], [-100.0], [0.0]])
+	var tgt = Matrix.from_array([[1.0], [0.0], [1.0]])
+	var grad = Matrix.new()
+
+	var value = loss.compute(pred, tgt, grad)
+	assert_almost_eq(value, log(2.0) / 3.0, 1e-5)
+	assert_false(is_nan(value))
+	assert_almost_eq(grad.get(2, 0), -0.5 / 3.0, 1e-6)
+
+func test_softmax_cross_entropy_labels_match_one_hot():
+	var loss := SoftmaxCrossEntropyLossNode.new()
+	var logits = Matrix.from_array([[1000.0, 0.0, -1000.0], [0.1, 0.2, 0.3]])
+	var one_hot = Matrix.from_array([[1.0, 0.0, 0.0], [0.0, 0.0, 1.0]])
+
+	var g1 = Matrix.new()
+	var g2 = Matrix.new()
+	var a = loss.compute(logits, one_hot, g1)
+	var b = loss.compute_labels(logits, PackedInt32Array([0, 2]), g2)
+
+	assert_false(is_nan(a))
+	assert_almost_eq(a, b, 1e-5)
+	for j in 3:
+		assert_almost_eq(g1.get(1, j), g2.get(1, j), 1e-6)
+	# Each gradient row of softmax - one_hot sums to zero
+	assert_almost_eq(g2.get(1, 0) + g2.get(1, 1) + g2.get(1, 2), 0.0, 1e-6)
+
+func test_sample_weights_scale_rows():
+	var loss := MSELossNode.new()
+	var pred = Matrix.from_array([[1.0], [2.0]])
+	var tgt = Matrix.zeros(2, 1)
+	var grad = Matrix.new()
+
+	var value = loss.compute(pred, tgt, grad, PackedFloat32Array([1.0, 0.0]))
+	assert_almost_eq(value, 0.5, 1e-6)
+	assert_almost_eq(grad.get(1, 0), 0.0, 1e-6)
+
+func test_packed_inputs_match_matrix_inputs():
+	var loss := HuberLossNode.new()
+	var p = PackedFloat32Array([0.2, -1.5, 4.0, 0.0])
+	var t = PackedFloat32Array([0.0, 0.0, 1.0, 1.0])
+
+	var a = loss.compute_packed(p, t, 2)
+	var b = loss.compute(Matrix.from_array([[0.2, -1.5], [4.0, 0.0]]),
+						 Matrix.from_array([[0.0, 0.0], [1.0, 1.0]]))
+	assert_almost_eq(a, b, 1e-6)
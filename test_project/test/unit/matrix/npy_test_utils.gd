@@ -0,0 +1,68 @@
+class_name NpyTestUtils
+
+# Builds NumPy files byte by byte so the tests do not need Python
+
+static func npy_bytes(data: PackedFloat32Array, shape: Array, fortran := false, descr := "<f4") -> PackedByteArray:
+	var dims := ", ".join(shape.map(func(d): return str(d)))
+	if shape.size() == 1:
+		dims += ","
+	var header := "{'descr': '%s', 'fortran_order': %s, 'shape': (%s), }" % [descr, "True" if fortran else "False", dims]
+	# Data starts on a 64-byte boundary, as numpy writes it
+	while (10 + header.length() + 1) % 64 != 0:
+		header += " "
+	header += "\n"
+
+	var out := PackedByteArray([0x93])
+	out.append_array("NUMPY".to_ascii_buffer())
+	out.append_array(PackedByteArray([1, 0]))
+	out.append_array(_u16(header.length()))
+	out.append_array(header.to_ascii_buffer())
+	out.append_array(data.to_byte_array())
+	return out
+
+# members: name -> .npy bytes, written uncompressed like np.savez
+static func npz_bytes(members: Dictionary) -> PackedByteArray:
+	var out := PackedByteArray()
+	var directory := PackedByteArray()
+	for member in members:
+		var name: PackedByteArray = (member + ".npy").to_ascii_buffer()
+		var data: PackedByteArray = members[member]
+		var offset := out.size()
+
+		out.append_array(_u32(0x04034b50))
+		out.append_array(_u16(20) + _u16(0) + _u16(0) + _u16(0) + _u16(0))
+		out.append_array(_u32(0) + _u32(data.size()) + _u32(data.size()))
+		out.append_array(_u16(name.size()) + _u16(0))
+		out.append_array(name)
+		out.append_array(data)
+
+		directory.append_array(_u32(0x02014b50))
+		directory.append_array(_u16(20) + _u16(20) + _u16(0) + _u16(0) + _u16(0) + _u16(0))
+		directory.append_array(_u32(0) + _u32(data.size()) + _u32(data.size()))
+		directory.append_array(_u16(name.size()) + _u16(0) + _u16(0) + _u16(0) + _u16(0))
+		directory.append_array(_u32(0) + _u32(offset))
+		directory.append_array(name)
+
+	var directory_offset := out.size()
+	out.append_array(directory)
+	out.append_array(_u32(0x06054b50) + _u16(0) + _u16(0))
+	out.append_array(_u16(members.size()) + _u16(members.size()))
+	out.append_array(_u32(directory.size()) + _u32(directory_offset) + _u16(0))
+	return out
+
+static func write(path: String, bytes: PackedByteArray) -> void:
+	var f := FileAccess.open(path, FileAccess.WRITE)
+	f.store_buffer(bytes)
+	f.close()
+
+static func _u16(v: int) -> PackedByteArray:
+	var b := PackedByteArray()
+	b.resize(2)
+	b.encode_u16(0, v)
+	return b
+
+static func _u32(v: int) -> PackedByteArray:
+	var b := PackedByteArray()
+	b.resize(4)
+	b.encode_u32(0, v)
+	return b
@@ -0,0 +1,69 @@
+extends GutTest
+const U = preload("res://test/unit/matrix/npy_test_utils.gd")
+
+const DATA = [0.0, 1.0, 2.0, 3.0, 4.0, 5.0]
+
+func test_load_npy_c_order():
+	U.write("user://c_order.npy", U.npy_bytes(PackedFloat32Array(DATA), [2, 3]))
+	var m := Matrix.load_npy("user://c_order.npy")
+	assert_eq(m.rows(), 2)
+	assert_eq(m.cols(), 3)
+	assert_eq(m.to_array(), [[0.0, 1.0, 2.0], [3.0, 4.0, 5.0]])
+
+func test_load_npy_fortran_order():
+	# Column-major data for the same 2x3 matrix
+	U.write("user://f_order.npy", U.npy_bytes(PackedFloat32Array([0.0, 3.0, 1.0, 4.0, 2.0, 5.0]), [2, 3], true))
+	assert_eq(Matrix.load_npy("user://f_order.npy").to_array(), [[0.0, 1.0, 2.0], [3.0, 4.0, 5.0]])
+
+func test_load_npy_vector_is_column():
+	U.write("user://vector.npy", U.npy_bytes(PackedFloat32Array(DATA), [6]))
+	var m := Matrix.load_npy("user://vector.npy")
+	assert_eq(m.rows(), 6)
+	assert_eq(m.cols(), 1)
+
+func test_load_npy_rejects_other_dtypes():
+	U.write("user://f8.npy", U.npy_bytes(PackedFloat32Array(DATA), [3], false, "<f8"))
+	assert_null(Matrix.load_npy("user://f8.npy"))
+
+func test_load_npy_rejects_short_data():
+	U.write("user://short.npy", U.npy_bytes(PackedFloat32Array(DATA), [4, 4]))
+	assert_null(Matrix.load_npy("user://short.npy"))
+
+func test_load_npz():
+	U.write("user://arrays.npz", U.npz_bytes({
+		"x": U.npy_bytes(PackedFloat32Array(DATA), [3, 2]),
+		"y": U.npy_bytes(PackedFloat32Array([1.0, 0.0, 1.0]), [3]),
+	}))
+	var arrays := Matrix.load_npz("user://arrays.npz")
+	assert_eq(arrays.keys(), ["x", "y"])
+	assert_eq(arrays["x"].to_array(), [[0.0, 1.0], [2.0, 3.0], [4.0, 5.0]])
+	assert_eq(arrays["y"].rows(), 3)
+
+func test_load_npz_rejects_wrapping_zip64_offset():
+	# One member whose ZIP64 local-header offset is 2^64 - 16; adding the
+	# header size to it must not wrap around to a small in-bounds value
+	var name := "x.npy".to_ascii_buffer()
+	var extra := U._u16(0x0001) + U._u16(8)
+	var offset := PackedByteArray()
+	offset.resize(8)
+	offset.encode_s64(0, -16)
+	extra.append_array(offset)
+
+	var directory := U._u32(0x02014b50)
+	directory.append_array(U._u16(45) + U._u16(45) + U._u16(0) + U._u16(0) + U._u16(0) + U._u16(0))
+	directory.append_array(U._u32(0) + U._u32(1) + U._u32(1))
+	directory.append_array(U._u16(name.size()) + U._u16(extra.size()) + U._u16(0) + U._u16(0) + U._u16(0))
+	directory.append_array(U._u32(0) + U._u32(0xFFFFFFFF))
+	directory.append_array(name)
+	directory.append_array(extra)
+
+	var bytes := directory.duplicate()
+	bytes.append_array(U._u32(0x06054b50) + U._u16(0) + U._u16(0) + U._u16(1) + U._u16(1))
+	bytes.append_array(U._u32(directory.size()) + U._u32(0) + U._u16(0))
+	U.write("user://wrapping.npz", bytes)
+	assert_eq(Matrix.load_npz("user://wrapping.npz"), {})
+
+func test_load_npz_rejects_truncated_archive():
+	var bytes := U.npz_bytes({ "x": U.npy_bytes(PackedFloat32Array(DATA), [3, 2]) })
+	U.write("user://truncated.npz", bytes.slice(0, bytes.size() - 30))
+	assert_eq(Matrix.load_npz("user://truncated.npz"), {})
@@ -0,0 +1,26 @@
+extends GutTest
+
+func test_from_triplets_sums_duplicates():
+	var S = SparseMatrix.from_triplets(2, 2,
+		PackedInt32Array([0, 1, 1]),
+		PackedInt32Array([0, 1, 1]),
+		PackedFloat32Array([1.0, 2.0, 3.0]))
+	assert_eq(S.nnz(), 2)
+	assert_eq(S.get(1, 1), 5.0)
+	assert_eq(S.get(0, 1), 0.0)
+
+func test_csr_roundtrip():
+	var S = SparseMatrix.from_csr(2, 3,
+		PackedInt32Array([0, 1, 3]),
+		PackedInt32Array([2, 0, 1]),
+		PackedFloat32Array([7.0, 1.0, 2.0]))
+	var d = S.to_dense()
+	assert_true(d.equals(Matrix.from_array([[0, 0, 7], [1, 2, 0]])))
+	var csr = S.to_csr()
+	assert_eq(csr["indptr"], PackedInt32Array([0, 1, 3]))
+
+func test_sparse_matmul_matches_dense():
+	var A = Matrix.from_array([[2, 0], [0, 3]])
+	var S = SparseMatrix.from_dense(A)
+	var x = Matrix.from_array([[1], [2]])
+	assert_true(S.matmul(x).equals(A.matmul(x)))
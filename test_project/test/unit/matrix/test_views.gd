@@ -0,0 +1,39 @@
+extends GutTest
+
+func test_row_view_reads_parent():
+	var A = Matrix.from_array([[1,2,3],[4,5,6]])
+	var r = A.row_view(1)
+	assert_eq(r.rows(), 1)
+	assert_eq(r.cols(), 3)
+	assert_eq(r.get(0, 2), 6.0)
+
+func test_col_view_writes_through():
+	var A = Matrix.from_array([[1,2],[3,4],[5,6]])
+	var c = A.col_view(0)
+	c.set(2, 0, 9)
+	assert_eq(A.get(2, 0), 9.0)
+
+func test_block_assign_and_copy():
+	var A = Matrix.zeros(4, 4)
+	var b = A.block(1, 1, 2, 2)
+	b.assign(Matrix.ones(2, 2))
+	assert_eq(A.get(1, 1), 1.0)
+	assert_eq(A.get(2, 2), 1.0)
+	assert_eq(A.get(0, 0), 0.0)
+	assert_true(b.to_matrix().equals(Matrix.ones(2, 2)))
+
+func test_view_keeps_parent_alive():
+	var v = Matrix.from_array([[1,2],[3,4]]).block(0, 1, 2, 1)
+	assert_eq(v.get(1, 0), 4.0)
+
+func test_stale_view_rejects_writes():
+	var A = Matrix.zeros(4, 4)
+	var b = A.block(2, 2, 2, 2)
+	# compute_packed resizes grad_out in place, shrinking the parent to 1x1
+	MSELossNode.new().compute_packed(PackedFloat32Array([1.0]), PackedFloat32Array([0.0]), 1, A)
+	assert_false(b.is_valid())
+	var grad = A.get(0, 0)
+	b.fill(5.0)
+	b.assign(Matrix.ones(2, 2))
+	assert_eq(A.rows(), 1)
+	assert_eq(A.get(0, 0), grad)
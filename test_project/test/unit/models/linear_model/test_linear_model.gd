@@ -15,3 +15,37 @@ func test_lr_learns_simple_linear_function():
 		assert_true(abs(pred[0] - y[i][0]) < 1.0)
 		
 	lr.free()
+
+func test_minibatch_adam_learns_linear_function():
+	var lr := LinearModelNode.new()
+	lr.set_learning_rate(0.1)
+	lr.set_batch_size(2)
+	lr.set_optimizer(LinearModelNode.OPTIMIZER_ADAM)
+	lr.set_seed(7)
+	lr.initialize(1)
+
+	var X = [[1],[2],[3],[4],[5]]
+	var y = [[8],[11],[14],[17],[20]]  # y = 3x + 5
+
+	lr.train(X, y, 500)
+
+	for i in X.size():
+		var pred = lr.predict(X[i])[0]
+		assert_true(abs(pred[0] - y[i][0]) < 1.0)
+
+	lr.free()
+
+func test_partial_fit_streams_samples():
+	var lr := LinearModelNode.new()
+	lr.set_learning_rate(0.01)
+	lr.set_optimizer(LinearModelNode.OPTIMIZER_MOMENTUM)
+
+	# Model is created on first partial_fit; one sample per "frame"
+	for frame in 3000:
+		var x = (frame % 5) + 1
+		lr.partial_fit([[x]], [[3 * x + 5]])
+
+	var pred = lr.predict([3])[0]
+	assert_true(abs(pred[0] - 14.0) < 1.0)
+
+	lr.free()
@@ -19,3 +19,70 @@ func test_closed_form_lr_learns_simple_linear_function():
 		)
 
 	lr.free()
+
+func test_streaming_fit_matches_closed_form():
+	var lr := LinearRegressionNode.new()
+
+	# y = 2a - b + 1, fed in two packed chunks
+	lr.reset_accumulator()
+	lr.accumulate(PackedFloat32Array([0, 0,  1, 0,  0, 1]), PackedFloat32Array([1, 3, 0]), 2)
+	lr.accumulate(PackedFloat32Array([2, 1,  3, 3]), PackedFloat32Array([4, 4]), 2)
+	assert_eq(lr.get_accumulated_rows(), 5)
+	assert_true(lr.solve_accumulated())
+
+	var pred = lr.predict([[4, 2]])[0][0]
+	assert_true(abs(pred - 7.0) < 0.001, "Prediction %f deviates from 7" % pred)
+
+	lr.free()
+
+func test_fit_file_streams_rows():
+	var path := "user://lr_stream_test.bin"
+	var f := FileAccess.open(path, FileAccess.WRITE)
+	for x in 100:
+		f.store_float(x)
+		f.store_float(3 * x + 5)
+	f.close()
+
+	var lr := LinearRegressionNode.new()
+	assert_eq(lr.fit_file(path, 1, 16), OK)
+	assert_eq(lr.get_accumulated_rows(), 100)
+	var pred = lr.predict([[10]])[0][0]
+	assert_true(abs(pred - 35.0) < 0.01, "Prediction %f deviates from 35" % pred)
+
+	DirAccess.remove_absolute(ProjectSettings.globalize_path(path))
+	lr.free()
+
+func test_multi_output_fit():
+	var lr := LinearRegressionNode.new()
+
+	# Two outputs: y0 = 3x + 5, y1 = -x + 2
+	var X = [[1], [2], [3], [4], [5]]
+	var y = []
+	for row in X:
+		y.append([3 * row[0] + 5, -row[0] + 2])
+	lr.fit(X, y)
+
+	var pred = lr.predict([[10]])[0]
+	assert_eq(pred.size(), 2)
+	assert_true(abs(pred[0] - 35.0) < 0.001)
+	assert_true(abs(pred[1] + 8.0) < 0.001)
+
+	lr.free()
+
+func test_ridge_shrinks_weights():
+	var X = [[1], [2], [3], [4], [5]]
+	var y = [[3], [6], [9], [12], [15]]
+
+	var plain := LinearRegressionNode.new()
+	plain.fit(X, y)
+	var ridge := LinearRegressionNode.new()
+	ridge.set_ridge(10.0)
+	ridge.fit(X, y)
+
+	var w_plain = plain.get_weights()[0][0]
+	var w_ridge = ridge.get_weights()[0][0]
+	assert_true(abs(w_plain - 3.0) < 0.001)
+	assert_true(w_ridge < w_plain)
+
+	plain.free()
+	ridge.free()
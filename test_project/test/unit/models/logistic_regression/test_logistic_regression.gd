@@ -0,0 +1,69 @@
+extends GutTest
+
+func test_binary_separable_data():
+	var lr := LogisticRegressionNode.new()
+
+	var X = []
+	var y = []
+	for i in 40:
+		var x = -2.0 + i * 0.1
+		X.append([x])
+		y.append(1 if x > 0.0 else 0)
+
+	lr.fit(X, y)
+
+	assert_eq(lr.get_num_classes(), 2)
+	assert_true(lr.get_iterations() < 100, "L-BFGS took %d iterations" % lr.get_iterations())
+
+	var pred = lr.predict([[-1.5], [1.5]])
+	assert_eq(pred[0], 0)
+	assert_eq(pred[1], 1)
+
+	var proba = lr.predict_proba([[1.5]])[0]
+	assert_eq(proba.size(), 2)
+	assert_almost_eq(proba[0] + proba[1], 1.0, 1e-5)
+	assert_true(proba[1] > 0.9, "Probability %f too low" % proba[1])
+
+	lr.free()
+
+func test_multinomial_three_clusters():
+	var lr := LogisticRegressionNode.new()
+
+	var centers = [[0.0, 3.0], [3.0, -2.0], [-3.0, -2.0]]
+	var X = []
+	var y = []
+	for c in 3:
+		for k in 10:
+			var jitter = 0.1 * (k - 5)
+			X.append([centers[c][0] + jitter, centers[c][1] - jitter])
+			y.append(c)
+
+	lr.fit(X, y)
+
+	assert_eq(lr.get_num_classes(), 3)
+	var pred = lr.predict(centers)
+	assert_eq(Array(pred), [0, 1, 2])
+
+	var proba = lr.predict_proba([[0.0, 3.0]])[0]
+	assert_eq(proba.size(), 3)
+	assert_almost_eq(proba[0] + proba[1] + proba[2], 1.0, 1e-5)
+
+	lr.free()
+
+func test_fit_matrix_matches_fit():
+	var X = [[0.0, 1.0], [1.0, 0.0], [0.2, 0.9], [0.9, 0.1], [0.1, 0.8], [0.8, 0.3]]
+	var y = [0, 1, 0, 1, 0, 1]
+
+	var a := LogisticRegressionNode.new()
+	a.fit(X, y)
+
+	var b := LogisticRegressionNode.new()
+	b.fit_matrix(Matrix.from_array(X), PackedInt32Array(y))
+
+	var wa = a.get_weights()
+	var wb = b.get_weights()
+	for i in wa.size():
+		assert_almost_eq(wa[i][0], wb[i][0], 1e-4)
+
+	a.free()
+	b.free()
@@ -0,0 +1,14 @@
+class_name NeuralNetworkTestUtils
+
+# Small networks shared by the NeuralNetworkNode tests
+
+# sizes = [input, hidden..., output], one activation per layer.
+# A learning_rate of 0 keeps the node's default.
+static func make_net(sizes: Array, activations: Array, learning_rate := 0.0, training_threads := 1) -> NeuralNetworkNode:
+	var nn := NeuralNetworkNode.new()
+	for i in activations.size():
+		nn.add_layer(sizes[i], sizes[i + 1], activations[i])
+	if learning_rate > 0.0:
+		nn.set_learning_rate(learning_rate)
+	nn.training_threads = training_threads
+	return nn
@@ -0,0 +1,53 @@
+extends GutTest
+
+const X = [[0.0, 0.0], [0.0, 1.0], [1.0, 0.0], [1.0, 1.0]]
+const Y = [[0.0], [1.0], [1.0], [2.0]]
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([2, 8, 1], ["relu", "linear"], 0.05)
+
+func test_train_step_reduces_loss():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+
+	var first = nn.train_step(X, Y, loss)
+	var last = first
+	for i in 300:
+		last = nn.train_step(X, Y, loss)
+
+	assert_eq(nn.get_training_steps(), 301)
+	assert_true(last < first, "Loss did not decrease: %f -> %f" % [first, last])
+	nn.free()
+
+func test_async_training_publishes_snapshots():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+	nn.publish_interval = 5
+	nn.max_queued_steps = 64
+	nn.async_training = true
+
+	var before = nn.predict([[1.0, 1.0]])[0][0]
+	assert_eq(nn.get_published_step(), 0)
+
+	var queued := 0
+	for i in 50:
+		if nn.train_async(X, Y, loss):
+			queued += 1
+		# Inference keeps working while the worker trains
+		assert_eq(nn.predict([[1.0, 1.0]]).size(), 1)
+
+	nn.wait_for_training()
+	assert_eq(nn.get_training_steps(), queued)
+	assert_eq(nn.get_published_step(), queued)
+	assert_ne(nn.predict([[1.0, 1.0]])[0][0], before)
+
+	nn.async_training = false
+	nn.free()
+
+func test_sync_calls_are_rejected_during_async_training():
+	var nn := _make_net()
+	nn.async_training = true
+	assert_eq(nn.forward(X), [])
+	nn.async_training = false
+	assert_eq(nn.forward(X).size(), 4)
+	nn.free()
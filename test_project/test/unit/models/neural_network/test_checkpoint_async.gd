@@ -0,0 +1,65 @@
+extends GutTest
+
+const DIR = "user://test_checkpoints"
+const X = [[0.2, -0.1], [-0.7, 0.3]]
+const Y = [[1.0], [0.0]]
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([2, 8, 1], ["relu", "linear"], 0.05)
+
+func before_each():
+	DirAccess.make_dir_recursive_absolute(DIR)
+
+func after_each():
+	for f in DirAccess.get_files_at(DIR):
+		DirAccess.remove_absolute(DIR + "/" + f)
+
+func test_checkpoint_async_signals_and_matches_capture_time():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+	nn.train_step(X, Y, loss)
+	var expected = nn.predict(X)
+	watch_signals(nn)
+
+	assert_eq(nn.checkpoint_async(DIR + "/ckpt_{step}.mlgk"), OK)
+	# Training right after the capture must not leak into the file
+	nn.train_step(X, Y, loss)
+	await wait_for_signal(nn.checkpoint_saved, 5)
+
+	assert_signal_emitted(nn, "checkpoint_saved")
+	var params = get_signal_parameters(nn, "checkpoint_saved")
+	assert_eq(params[0], DIR + "/ckpt_1.mlgk")
+	assert_eq(params[1], 1)
+	assert_eq(params[2], OK)
+
+	var other := NeuralNetworkNode.new()
+	assert_eq(other.load_model(params[0]), OK)
+	assert_eq(other.predict(X), expected)
+	nn.free()
+	other.free()
+
+func test_keep_last_removes_older_checkpoints():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+	nn.checkpoint_keep_last = 2
+	for i in 4:
+		nn.train_step(X, Y, loss)
+		nn.checkpoint_async(DIR + "/ckpt_{step}.mlgk")
+	nn.wait_for_checkpoints()
+
+	var files = Array(DirAccess.get_files_at(DIR))
+	files.sort()
+	assert_eq(files, ["ckpt_3.mlgk", "ckpt_4.mlgk"])
+	nn.free()
+
+func test_checkpoint_during_async_training():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+	nn.async_training = true
+	for i in 6:
+		nn.train_async(X, Y, loss)
+	assert_eq(nn.checkpoint_async(DIR + "/live.mlgk"), OK)
+	nn.wait_for_checkpoints()
+	assert_true(FileAccess.file_exists(DIR + "/live.mlgk"))
+	nn.async_training = false
+	nn.free()
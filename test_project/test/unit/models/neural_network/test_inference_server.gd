@@ -0,0 +1,88 @@
+extends GutTest
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([3, 8, 2], ["relu", "linear"])
+
+func test_batched_results_match_predict():
+	var nn := _make_net()
+	var server := InferenceServer.new()
+	server.flush_mode = InferenceServer.FLUSH_MANUAL
+
+	var observations = [[0.1, 0.2, 0.3], [-1.0, 0.5, 2.0], [0.0, 0.0, 1.0]]
+	var handles = []
+	for obs in observations:
+		handles.append(server.submit(nn, PackedFloat32Array(obs)))
+
+	assert_eq(server.get_pending_count(), 3)
+	assert_false(server.is_ready(handles[0]))
+
+	server.flush()
+	assert_eq(server.get_pending_count(), 0)
+
+	for i in observations.size():
+		assert_true(server.is_ready(handles[i]))
+		var batched = server.get_result(handles[i])
+		var single = nn.predict([observations[i]])[0]
+		assert_eq(batched.size(), 2)
+		for j in 2:
+			assert_almost_eq(batched[j], single[j], 1e-5)
+
+	server.free()
+	nn.free()
+
+func test_quantized_network_matches_predict():
+	var nn := _make_net()
+	assert_true(nn.quantize())
+	var server := InferenceServer.new()
+	server.flush_mode = InferenceServer.FLUSH_MANUAL
+
+	var observations = [[0.1, 0.2, 0.3], [-1.0, 0.5, 2.0]]
+	var handles = []
+	for obs in observations:
+		handles.append(server.submit(nn, PackedFloat32Array(obs)))
+	server.flush()
+
+	# Same int8 stack as predict(), not the fp32 weights kept alongside
+	for i in observations.size():
+		var batched = server.get_result(handles[i])
+		var single = nn.predict([observations[i]])[0]
+		for j in 2:
+			assert_almost_eq(batched[j], single[j], 1e-6)
+
+	server.free()
+	nn.free()
+
+func test_worker_thread_and_max_batch_size():
+	var nn := _make_net()
+	var server := InferenceServer.new()
+	server.flush_mode = InferenceServer.FLUSH_MANUAL
+	server.use_worker_thread = true
+	server.max_batch_size = 2
+
+	var a = server.submit(nn, PackedFloat32Array([1.0, 2.0, 3.0]))
+	var b = server.submit(nn, PackedFloat32Array([3.0, 2.0, 1.0]))  # fills the batch, flushes
+	assert_eq(server.get_pending_count(), 0)
+
+	server.wait()
+	assert_true(server.is_ready(a))
+	assert_true(server.is_ready(b))
+
+	var expected = nn.predict([[3.0, 2.0, 1.0]])[0]
+	var got = server.get_result(b)
+	assert_almost_eq(got[0], expected[0], 1e-5)
+
+	server.free()
+	nn.free()
+
+func test_get_result_forces_pending_request():
+	var nn := _make_net()
+	var server := InferenceServer.new()
+	server.flush_mode = InferenceServer.FLUSH_MANUAL
+
+	var h = server.submit(nn, PackedFloat32Array([0.5, 0.5, 0.5]))
+	var out = server.get_result(h)
+	assert_eq(out.size(), 2)
+	assert_false(server.is_ready(h))
+
+	server.free()
+	nn.free()
@@ -0,0 +1,69 @@
+extends GutTest
+
+func _make_trained_net() -> NeuralNetworkNode:
+	var nn := NeuralNetworkTestUtils.make_net([2, 4, 1], ["relu", "linear"])
+	nn.set_batch_size(1)
+	return nn
+
+func test_nodes_share_model_weights():
+	var src := _make_trained_net()
+	var model: NeuralModel = src.export_model()
+
+	assert_eq(model.get_layer_count(), 2)
+	assert_eq(model.get_input_size(), 2)
+	assert_eq(model.get_output_size(), 1)
+	assert_eq(model.get_parameter_count(), 2 * 4 + 4 + 4 * 1 + 1)
+
+	var a := NeuralNetworkNode.new()
+	var b := NeuralNetworkNode.new()
+	a.model = model
+	b.model = model
+
+	assert_true(a.is_sharing_weights())
+	var x = [[0.3, -0.7]]
+	assert_almost_eq(a.predict(x)[0][0], src.predict(x)[0][0], 1e-6)
+	assert_almost_eq(b.predict(x)[0][0], src.predict(x)[0][0], 1e-6)
+
+	src.free()
+	a.free()
+	b.free()
+
+func test_training_copies_on_write():
+	var src := _make_trained_net()
+	var model: NeuralModel = src.export_model()
+
+	var learner := NeuralNetworkNode.new()
+	var reader := NeuralNetworkNode.new()
+	learner.model = model
+	reader.model = model
+
+	var x = [[1.0, 1.0]]
+	var before = reader.predict(x)[0][0]
+
+	learner.set_learning_rate(0.1)
+	for i in 5:
+		learner.forward(x)
+		learner.backward([[1.0]])
+
+	assert_ne(learner.predict(x)[0][0], before)
+	assert_almost_eq(reader.predict(x)[0][0], before, 1e-6)
+	assert_almost_eq(src.predict(x)[0][0], before, 1e-6)
+
+	src.free()
+	learner.free()
+	reader.free()
+
+func test_layer_data_round_trip():
+	var src := _make_trained_net()
+	var data = src.export_model().get_layer_data()
+
+	var restored := NeuralModel.new()
+	restored.set_layer_data(data)
+
+	var nn := NeuralNetworkNode.new()
+	nn.model = restored
+	var x = [[0.5, 0.25]]
+	assert_almost_eq(nn.predict(x)[0][0], src.predict(x)[0][0], 1e-6)
+
+	src.free()
+	nn.free()
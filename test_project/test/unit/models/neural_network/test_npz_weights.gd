@@ -0,0 +1,55 @@
+extends GutTest
+const U = preload("res://test/unit/matrix/npy_test_utils.gd")
+
+const PATH = "user://test_weights.npz"
+const X = [[1.0, 2.0], [-1.0, 0.5]]
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([2, 3, 1], ["linear", "linear"])
+
+func after_each():
+	if FileAccess.file_exists(PATH):
+		DirAccess.remove_absolute(PATH)
+
+func test_loads_in_out_and_out_in_weights():
+	# Layer 0 in (in, out) layout, layer 1 as a PyTorch (out, in) weight
+	U.write(PATH, U.npz_bytes({
+		"dense.kernel": U.npy_bytes(PackedFloat32Array([1, 0, 1, 0, 1, 1]), [2, 3]),
+		"dense.bias": U.npy_bytes(PackedFloat32Array([0, 0, 1]), [3]),
+		"fc.weight": U.npy_bytes(PackedFloat32Array([1, 2, 3]), [1, 3]),
+		"fc.bias": U.npy_bytes(PackedFloat32Array([-1]), [1]),
+	}))
+	var nn := _make_net()
+	var err := nn.load_weights_npz(PATH, {
+		0: {"weights": "dense.kernel", "biases": "dense.bias"},
+		1: {"weights": "fc.weight", "biases": "fc.bias", "layout": "out_in"},
+	})
+	assert_eq(err, OK)
+	# h = [x0, x1, x0 + x1 + 1], y = h0 + 2 h1 + 3 h2 - 1
+	assert_almost_eq(nn.predict(X)[0][0], 1.0 + 4.0 + 12.0 - 1.0, 1e-5)
+	assert_almost_eq(nn.predict(X)[1][0], -1.0 + 1.0 + 1.5 - 1.0, 1e-5)
+	nn.free()
+
+func test_mismatched_shape_leaves_weights_untouched():
+	U.write(PATH, U.npz_bytes({
+		"w": U.npy_bytes(PackedFloat32Array([1, 2, 3, 4]), [2, 2]),
+		"b": U.npy_bytes(PackedFloat32Array([0, 0]), [2]),
+	}))
+	var nn := _make_net()
+	var before = nn.predict(X)
+	assert_eq(nn.load_weights_npz(PATH, {0: {"weights": "w", "biases": "b"}}), ERR_INVALID_DATA)
+	assert_eq(nn.load_weights_npz(PATH, {1: {"weights": "missing", "biases": "b"}}), ERR_DOES_NOT_EXIST)
+	assert_eq(nn.predict(X), before)
+	nn.free()
+
+func test_loaded_weights_can_be_trained():
+	U.write(PATH, U.npz_bytes({
+		"w0": U.npy_bytes(PackedFloat32Array([0.1, 0.2, 0.3, 0.4, 0.5, 0.6]), [3, 2]),
+		"b0": U.npy_bytes(PackedFloat32Array([0, 0, 0]), [3]),
+	}))
+	var nn := _make_net()
+	assert_eq(nn.load_weights_npz(PATH, {0: {"weights": "w0", "biases": "b0"}}), OK)
+	var before = nn.predict(X)
+	nn.train_step(X, [[1.0], [0.0]], MSELossNode.new())
+	assert_ne(nn.predict(X), before)
+	nn.free()
@@ -0,0 +1,61 @@
+extends GutTest
+
+func _make_net(threads: int) -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([3, 16, 2], ["relu", "linear"], 0.05, threads)
+
+func _batch(rows: int) -> Array:
+	var rng := RandomNumberGenerator.new()
+	rng.seed = 7
+	var xs := []
+	var ys := []
+	for i in rows:
+		var a = rng.randf_range(-1.0, 1.0)
+		var b = rng.randf_range(-1.0, 1.0)
+		var c = rng.randf_range(-1.0, 1.0)
+		xs.append([a, b, c])
+		ys.append([a + b, b - c])
+	return [xs, ys]
+
+func _train(nn: NeuralNetworkNode, steps: int) -> float:
+	var data = _batch(128)
+	var loss := MSELossNode.new()
+	var last := 0.0
+	for i in steps:
+		last = nn.train_step(data[0], data[1], loss)
+	return last
+
+func test_fixed_thread_count_is_bitwise_reproducible():
+	var a := _make_net(4)
+	var b := _make_net(4)
+	b.copy_weights(a)
+
+	_train(a, 20)
+	_train(b, 20)
+
+	var probe = [[0.3, -0.2, 0.9]]
+	assert_eq(b.predict(probe), a.predict(probe))
+	a.free()
+	b.free()
+
+func test_sharded_training_tracks_serial_training():
+	var serial := _make_net(1)
+	var sharded := _make_net(3)
+	sharded.copy_weights(serial)
+
+	var first = _train(serial, 1)
+	_train(sharded, 1)
+	var serial_loss = _train(serial, 150)
+	var sharded_loss = _train(sharded, 150)
+
+	assert_true(serial_loss < first)
+	assert_almost_eq(sharded_loss, serial_loss, 1e-3)
+	serial.free()
+	sharded.free()
+
+func test_small_batches_fall_back_to_serial():
+	var nn := _make_net(8)
+	var loss := MSELossNode.new()
+	var value = nn.train_step([[0.0, 1.0, 0.0]], [[1.0, -1.0]], loss)
+	assert_true(is_finite(value))
+	assert_eq(nn.get_training_steps(), 1)
+	nn.free()
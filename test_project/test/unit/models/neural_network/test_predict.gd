@@ -0,0 +1,59 @@
+extends GutTest
+
+const X = [[0.0, 0.0], [0.0, 1.0], [1.0, 0.0], [1.0, 1.0]]
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([2, 6, 4, 2], ["sigmoid", "leaky_relu", "linear"], 0.05)
+
+func test_predict_matches_forward():
+	var nn := _make_net()
+	var expected = nn.forward(X)
+	var got = nn.predict(X)
+	for i in X.size():
+		for j in 2:
+			assert_almost_eq(got[i][j], expected[i][j], 1e-6)
+	nn.free()
+
+func test_predict_does_not_disturb_backward():
+	var a := _make_net()
+	var b := _make_net()
+	b.copy_weights(a)
+
+	var err = [[1.0, -1.0], [0.5, 0.5], [-0.5, 0.2], [0.1, 0.3]]
+	a.forward(X)
+	b.forward(X)
+	# A prediction on different data between forward and backward must not
+	# replace the cached activations
+	b.predict([[3.0, -2.0]])
+	a.backward(err)
+	b.backward(err)
+
+	var pa = a.predict(X)
+	var pb = b.predict(X)
+	for i in X.size():
+		for j in 2:
+			assert_eq(pb[i][j], pa[i][j])
+	a.free()
+	b.free()
+
+func test_matrix_and_packed_variants():
+	var nn := _make_net()
+	var expected = nn.predict(X)
+
+	var m = nn.predict_matrix(Matrix.from_array(X))
+	assert_eq(m.rows(), 4)
+	assert_eq(m.cols(), 2)
+
+	var packed = nn.predict_packed(PackedFloat32Array([0.0, 0.0, 0.0, 1.0, 1.0, 0.0, 1.0, 1.0]))
+	assert_eq(packed.size(), 8)
+	for i in X.size():
+		for j in 2:
+			assert_almost_eq(m.get(i, j), expected[i][j], 1e-6)
+			assert_almost_eq(packed[i * 2 + j], expected[i][j], 1e-6)
+	nn.free()
+
+func test_predict_rejects_wrong_input_size():
+	var nn := _make_net()
+	assert_eq(nn.predict([[1.0, 2.0, 3.0]]), [])
+	assert_eq(nn.predict_packed(PackedFloat32Array([1.0, 2.0, 3.0])).size(), 0)
+	nn.free()
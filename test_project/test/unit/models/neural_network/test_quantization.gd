@@ -0,0 +1,62 @@
+extends GutTest
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([4, 32, 3], ["relu", "linear"])
+
+func _inputs(rows: int) -> Array:
+	var rng := RandomNumberGenerator.new()
+	rng.seed = 11
+	var xs := []
+	for i in rows:
+		xs.append([rng.randf_range(-1.0, 1.0), rng.randf_range(-1.0, 1.0),
+				rng.randf_range(-1.0, 1.0), rng.randf_range(-1.0, 1.0)])
+	return xs
+
+func test_quantized_predict_is_close_to_float():
+	var nn := _make_net()
+	var xs = _inputs(64)
+	var expected = nn.predict(xs)
+
+	nn.calibrate(xs)
+	assert_true(nn.quantize())
+	assert_true(nn.is_quantized())
+
+	var got = nn.predict(xs)
+	for i in xs.size():
+		for j in 3:
+			assert_almost_eq(got[i][j], expected[i][j], 0.05)
+
+	var report = nn.get_quantization_report(xs)
+	assert_true(report["max_abs_error"] < 0.05)
+	assert_true(report["argmax_agreement"] > 0.9)
+	assert_true(report["quantized_bytes"] * 3 < report["float_bytes"])
+	nn.free()
+
+func test_dynamic_ranges_without_calibration():
+	var nn := _make_net()
+	var xs = _inputs(8)
+	var expected = nn.predict(xs)
+	nn.quantize()
+	var got = nn.predict_packed(PackedFloat32Array(xs[0]))
+	for j in 3:
+		assert_almost_eq(got[j], expected[0][j], 0.05)
+	nn.free()
+
+func test_training_is_rejected_until_dequantized():
+	var nn := _make_net()
+	var loss := MSELossNode.new()
+	nn.quantize()
+	assert_eq(nn.forward([[0.0, 0.0, 0.0, 0.0]]), [])
+
+	nn.dequantize()
+	assert_false(nn.is_quantized())
+	nn.train_step([[0.0, 0.0, 0.0, 0.0]], [[1.0, 0.0, 0.0]], loss)
+	assert_eq(nn.get_training_steps(), 1)
+	nn.free()
+
+func test_replacing_weights_drops_quantization():
+	var nn := _make_net()
+	nn.quantize()
+	nn.add_layer(3, 1, "linear")
+	assert_false(nn.is_quantized())
+	nn.free()
@@ -0,0 +1,53 @@
+extends GutTest
+
+const X = [[0.1, -0.4, 0.7], [0.9, 0.2, -0.3]]
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([3, 80, 2], ["relu", "sigmoid"])
+
+func _assert_close(got, expected, tol):
+	for i in expected.size():
+		for j in expected[i].size():
+			assert_almost_eq(got[i][j], expected[i][j], tol)
+
+func test_half_storage_predicts_close_to_float():
+	var nn := _make_net()
+	var expected = nn.predict(X)
+
+	nn.weight_storage = NeuralModel.WEIGHTS_FLOAT16
+	_assert_close(nn.predict(X), expected, 1e-3)
+
+	nn.weight_storage = NeuralModel.WEIGHTS_BFLOAT16
+	_assert_close(nn.predict(X), expected, 1e-2)
+
+	nn.weight_storage = NeuralModel.WEIGHTS_FLOAT32
+	assert_eq(nn.predict(X), expected)
+	nn.free()
+
+func test_training_needs_float_storage():
+	var nn := _make_net()
+	nn.weight_storage = NeuralModel.WEIGHTS_FLOAT16
+	assert_eq(nn.forward(X), [])
+	nn.weight_storage = NeuralModel.WEIGHTS_FLOAT32
+	assert_eq(nn.forward(X).size(), 2)
+	nn.free()
+
+func test_model_round_trip_in_half_precision():
+	var nn := _make_net()
+	var expected = nn.predict(X)
+
+	var model := nn.export_model()
+	model.storage_format = NeuralModel.WEIGHTS_FLOAT16
+	var data = model.get_layer_data()
+	assert_true(data[0]["weights"] is PackedByteArray)
+	assert_eq(data[0]["weights"].size(), 3 * 80 * 2)
+
+	var restored := NeuralModel.new()
+	restored.set_layer_data(data)
+	assert_eq(restored.storage_format, NeuralModel.WEIGHTS_FLOAT16)
+
+	var other := NeuralNetworkNode.new()
+	other.model = restored
+	_assert_close(other.predict(X), expected, 1e-3)
+	nn.free()
+	other.free()
@@ -0,0 +1,31 @@
+extends GutTest
+
+func test_rls_learns_linear_function_incrementally():
+	var rls := RecursiveLeastSquaresNode.new()
+	rls.set_forgetting_factor(1.0)
+	rls.initialize(1)
+
+	# y = 3x + 5, one sample at a time
+	for x in [1, 2, 3, 4, 5]:
+		rls.partial_fit([[x]], [[3 * x + 5]])
+
+	assert_eq(rls.get_samples_seen(), 5)
+	var pred = rls.predict([[10]])[0][0]
+	assert_true(abs(pred - 35.0) < 0.01, "Prediction %f deviates from 35" % pred)
+
+	rls.free()
+
+func test_rls_tracks_drift_with_forgetting():
+	var rls := RecursiveLeastSquaresNode.new()
+	rls.set_forgetting_factor(0.9)
+	rls.initialize(1)
+
+	var X = [[0], [1], [2], [3]]
+	rls.partial_fit(X, [[0], [1], [2], [3]])     # y = x
+	for i in 20:
+		rls.partial_fit(X, [[0], [2], [4], [6]]) # y = 2x
+
+	var pred = rls.predict([[1]])[0][0]
+	assert_true(abs(pred - 2.0) < 0.05, "Prediction %f did not track drift" % pred)
+
+	rls.free()
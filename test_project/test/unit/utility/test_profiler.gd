@@ -0,0 +1,70 @@
+extends GutTest
+
+func before_each():
+	Profiler.reset()
+
+func after_each():
+	Profiler.set_enabled(false)
+
+func _make_net() -> NeuralNetworkNode:
+	return NeuralNetworkTestUtils.make_net([3, 8, 2], ["relu", "linear"])
+
+func _train(nn: NeuralNetworkNode, steps: int) -> void:
+	var xs := [[0.1, 0.2, 0.3], [0.4, -0.5, 0.6], [-0.7, 0.8, 0.9], [1.0, 0.0, -1.0]]
+	var ys := [[1.0, 0.0], [0.0, 1.0], [1.0, 1.0], [0.0, 0.0]]
+	var loss := MSELossNode.new()
+	for i in steps:
+		nn.train_step(xs, ys, loss)
+
+func test_disabled_records_nothing():
+	var nn := _make_net()
+	_train(nn, 3)
+	var profile := Profiler.get_profile()
+	assert_eq(profile.nn_forward.calls, 0)
+	assert_eq(profile.marshal_to_eigen.calls, 0)
+	assert_eq(nn.get_profile().layers.size(), 0)
+	nn.free()
+
+func test_per_layer_training_profile():
+	Profiler.set_enabled(true)
+	var nn := _make_net()
+	_train(nn, 5)
+
+	var layers: Array = nn.get_profile().layers
+	assert_eq(layers.size(), 2)
+	assert_eq(layers[0].forward.calls, 5)
+	assert_eq(layers[1].backward.calls, 5)
+	# 2 * rows * in * out for the first layer's forward GEMM
+	assert_eq(layers[0].forward.flops, 5 * 2 * 4 * 3 * 8)
+	assert_eq(layers[0].backward.flops, 2 * layers[0].forward.flops)
+	assert_true(layers[0].forward.time_ms >= 0.0)
+
+	var profile := Profiler.get_profile()
+	assert_eq(profile.nn_forward.calls, 5)
+	assert_eq(profile.nn_update.calls, 5)
+	assert_gt(profile.allocations.count, 0)
+
+	nn.reset_profile()
+	assert_eq(nn.get_profile().layers[0].forward.calls, 0)
+	nn.free()
+
+func test_marshalling_and_tree_sections():
+	Profiler.set_enabled(true)
+	var nn := _make_net()
+	nn.predict([[0.1, 0.2, 0.3]])
+	var tree := DecisionTreeNode.new()
+	tree.fit([[0, 0], [0, 1], [1, 0], [1, 1]], [0, 1, 1, 0])
+	tree.predict([[0, 1]])
+
+	var profile := Profiler.get_profile()
+	assert_eq(profile.nn_predict.calls, 1)
+	assert_eq(profile.tree_fit.calls, 1)
+	assert_eq(profile.tree_predict.calls, 1)
+	assert_gt(profile.marshal_to_eigen.calls, 0)
+	assert_gt(profile.marshal_to_godot.bytes, 0)
+	nn.free()
+	tree.free()
+
+func test_performance_monitors_registered():
+	assert_true(Performance.has_custom_monitor("MLGodotKit/nn_forward_ms"))
+	assert_true(Performance.has_custom_monitor("MLGodotKit/allocations"))